@@ -0,0 +1,114 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/FullyConnected.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/// number of heap allocations so far
+static size_t allocations_count = 0;
+
+void* operator new(const size_t size) {
+    allocations_count++;
+    if (auto* const ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+/// number of finished chunks
+static size_t finished_chunks_count = 0;
+
+void chunk_arrived_callback(void* const) noexcept {
+    finished_chunks_count++;
+}
+
+/**
+ * Run rounds of all-to-all with 256 KiB chunks,
+ * creating either routed or routeless chunks, from the heap or from the chunk pool of the topology.
+ */
+void run_all_to_all(const std::string& name,
+                    Topology& topology,
+                    EventQueue& event_queue,
+                    const int rounds_count,
+                    const bool pooled,
+                    const bool routed) noexcept {
+    const auto npus_count = topology.get_npus_count();
+    constexpr auto chunk_size = ChunkSize{256 * 1'024};
+    finished_chunks_count = 0;
+
+    const auto start_allocations = allocations_count;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds_count; round++) {
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+                if (pooled && routed) {
+                    topology.send(topology.make_chunk(chunk_size, topology.route(i, j), chunk_arrived_callback,
+                                                      nullptr));
+                } else if (pooled) {
+                    topology.send(topology.make_chunk(chunk_size, i, j, chunk_arrived_callback, nullptr));
+                } else {
+                    auto chunk = std::make_unique<Chunk>(chunk_size, topology.route(i, j), chunk_arrived_callback,
+                                                         nullptr);
+                    topology.send(std::move(chunk));
+                }
+            }
+        }
+        while (!event_queue.finished()) {
+            Topology::proceed(event_queue);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto chunks = static_cast<double>(finished_chunks_count);
+    const auto elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    const auto allocations = static_cast<double>(allocations_count - start_allocations);
+    std::printf("%-24s %12zu %12.1f %14.4f\n", name.c_str(), finished_chunks_count, elapsed_ns / chunks,
+                allocations / chunks);
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkChunkPool [npus count] [rounds count]
+    const auto npus_count = (argc > 1) ? std::stoi(argv[1]) : 64;
+    const auto rounds_count = (argc > 2) ? std::stoi(argv[2]) : 256;
+
+    const auto event_queue = std::make_shared<EventQueue>();
+    auto topology = FullyConnected(npus_count, 50, 500);
+    topology.set_event_queue(event_queue);
+
+    std::printf("[all-to-all] FullyConnected %d NPUs, 256 KiB chunks, %d rounds\n", npus_count, rounds_count);
+    std::printf("%-24s %12s %12s %14s\n", "allocator", "chunks", "ns/chunk", "allocs/chunk");
+    run_all_to_all("heap, routed", topology, *event_queue, rounds_count, false, true);
+    run_all_to_all("pool, routed", topology, *event_queue, rounds_count, true, true);
+    run_all_to_all("pool, routeless", topology, *event_queue, rounds_count, true, false);
+
+    const auto stats = topology.get_chunk_pool_stats();
+    std::printf("\nchunk: %zu B, including %zu B of inline Route\n", sizeof(Chunk), sizeof(Route));
+    std::printf("pool: %zu chunks allocated, %zu peak alive, %zu heap allocations\n", stats.chunks_allocated,
+                stats.peak_chunks_alive, stats.heap_allocations);
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Type.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/Switch.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkDelayMatrix [file path]
+    const auto path = (argc > 1) ? std::string(argv[1]) : std::string("delay_matrix.bin");
+
+    // Ring(8) x FullyConnected(16) x Switch(32)
+    auto topology = MultiDimTopology();
+    topology.append_dimension(std::make_unique<Ring>(8, 200, 20, true));
+    topology.append_dimension(std::make_unique<FullyConnected>(16, 100, 100));
+    topology.append_dimension(std::make_unique<Switch>(32, 50, 500));
+    const auto npus_count = topology.get_npus_count();
+    const auto chunk_sizes = std::vector<ChunkSize>{65'536, 1'048'576};
+
+    std::printf("[delay matrix] Ring(8) x FullyConnected(16) x Switch(32), %d NPUs, %zu chunk sizes\n", npus_count,
+                chunk_sizes.size());
+    std::printf("%-40s %14s %20s\n", "method", "wall (ms)", "checksum");
+
+    // nested send calls into memory
+    auto matrix = std::vector<EventTime>(static_cast<size_t>(npus_count) * npus_count);
+    auto checksum = EventTime{0};
+    auto start = std::chrono::steady_clock::now();
+    for (const auto chunk_size : chunk_sizes) {
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                matrix[(static_cast<size_t>(src) * npus_count) + dest] =
+                    (src == dest) ? 0 : topology.send(src, dest, chunk_size);
+            }
+        }
+        for (const auto delay : matrix) {
+            checksum += delay;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::printf("%-40s %14.1f %20llu\n", "nested send", std::chrono::duration<double, std::milli>(end - start).count(),
+                static_cast<unsigned long long>(checksum));
+
+    // block-structured rows into memory
+    checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto chunk_size : chunk_sizes) {
+        for (auto src = 0; src < npus_count; src++) {
+            topology.compute_delay_row(src, chunk_size, matrix.data() + (static_cast<size_t>(src) * npus_count));
+        }
+        for (const auto delay : matrix) {
+            checksum += delay;
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    std::printf("%-40s %14.1f %20llu\n", "compute_delay_row",
+                std::chrono::duration<double, std::milli>(end - start).count(),
+                static_cast<unsigned long long>(checksum));
+    matrix = std::vector<EventTime>();
+
+    // compute_delay_matrix, into a file
+    auto threads_counts = std::vector<int>{1};
+    if (std::thread::hardware_concurrency() > 1) {
+        threads_counts.push_back(static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (const auto threads_count : threads_counts) {
+        start = std::chrono::steady_clock::now();
+        topology.compute_delay_matrix(chunk_sizes, path, threads_count);
+        end = std::chrono::steady_clock::now();
+
+        // checksum the file
+        checksum = 0;
+        auto* const file = std::fopen(path.c_str(), "rb");
+        auto buffer = std::vector<EventTime>(npus_count);
+        while (std::fread(buffer.data(), sizeof(EventTime), buffer.size(), file) == buffer.size()) {
+            for (const auto delay : buffer) {
+                checksum += delay;
+            }
+        }
+        std::fclose(file);
+
+        const auto name = "compute_delay_matrix (" + std::to_string(threads_count) + " threads)";
+        std::printf("%-40s %14.1f %20llu\n", name.c_str(),
+                    std::chrono::duration<double, std::milli>(end - start).count(),
+                    static_cast<unsigned long long>(checksum));
+    }
+    std::remove(path.c_str());
+
+    return 0;
+}
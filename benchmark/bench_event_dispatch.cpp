@@ -0,0 +1,159 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Helper.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/**
+ * Hold model: every invoked event schedules a new one,
+ * so the number of pending events stays constant.
+ */
+class HoldModel {
+  public:
+    /**
+     * Typed event handler.
+     */
+    void on_event() noexcept {
+        invoked_count++;
+        schedule_typed();
+    }
+
+    /**
+     * C-style callback.
+     *
+     * @param model_ptr pointer to the model
+     */
+    static void on_event_callback(void* const model_ptr) noexcept {
+        auto* const model = static_cast<HoldModel*>(model_ptr);
+        model->invoked_count++;
+        model->schedule_callback();
+    }
+
+    explicit HoldModel(EventQueue* const event_queue) noexcept : event_queue(event_queue), rng(42), invoked_count(0) {}
+
+    void schedule_typed() noexcept {
+        event_queue->schedule_event<&HoldModel::on_event>(next_event_time(), this);
+    }
+
+    void schedule_callback() noexcept {
+        event_queue->schedule_event(next_event_time(), on_event_callback, this);
+    }
+
+    [[nodiscard]] size_t get_invoked_count() const noexcept {
+        return invoked_count;
+    }
+
+  private:
+    EventQueue* event_queue;
+    std::mt19937 rng;
+    size_t invoked_count;
+
+    [[nodiscard]] EventTime next_event_time() noexcept {
+        // link-like delays between 500 ns and 20 us
+        return event_queue->get_current_time() + 500 + rng() % 20'000;
+    }
+};
+
+template <bool Typed> double run_hold_model(const size_t pending_count, const size_t events_count) noexcept {
+    auto event_queue = EventQueue();
+    auto model = HoldModel(&event_queue);
+
+    // fill the queue
+    for (auto i = size_t{0}; i < pending_count; i++) {
+        if constexpr (Typed) {
+            model.schedule_typed();
+        } else {
+            model.schedule_callback();
+        }
+    }
+
+    // measure
+    const auto start = std::chrono::steady_clock::now();
+    while (model.get_invoked_count() < events_count) {
+        if constexpr (Typed) {
+            event_queue.proceed<&HoldModel::on_event>();
+        } else {
+            event_queue.proceed();
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // events per second
+    const auto elapsed_s = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(model.get_invoked_count()) / elapsed_s;
+}
+
+void chunk_arrived_callback(void* const) noexcept {}
+
+template <bool Typed> double run_all_to_all(const std::string& input_path, const ChunkSize chunk_size) noexcept {
+    const auto event_queue = std::make_shared<EventQueue>();
+    const auto network_parser = NetworkParser(input_path);
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    const auto npus_count = topology->get_npus_count();
+
+    // every chunk takes an arrival and a link-free event per hop
+    auto events_count = size_t{0};
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+            auto route = topology->route(i, j);
+            events_count += 2 * (route.size() - 1);
+            auto chunk = std::make_unique<Chunk>(chunk_size, std::move(route), chunk_arrived_callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+
+    // measure
+    const auto start = std::chrono::steady_clock::now();
+    while (!event_queue->finished()) {
+        if constexpr (Typed) {
+            Topology::proceed(*event_queue);
+        } else {
+            event_queue->proceed();
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // events per second
+    const auto elapsed_s = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(events_count) / elapsed_s;
+}
+
+template <typename Run> void report(const std::string& name, Run run) noexcept {
+    // best of a few repetitions
+    auto best = 0.0;
+    for (auto i = 0; i < 5; i++) {
+        best = std::max(best, run());
+    }
+    std::printf("%-36s %14.2f\n", name.c_str(), best / 1e6);
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkEventDispatch [topology input] [measured hold model events]
+    const auto input_path = (argc > 1) ? std::string(argv[1]) : std::string("../../input/Ring.yml");
+    const auto events_count = (argc > 2) ? std::stoul(argv[2]) : size_t{5'000'000};
+
+    std::printf("%-36s %14s\n", "benchmark", "Mevents/s");
+    report("hold model (C callback)", [&] { return run_hold_model<false>(1'000, events_count); });
+    report("hold model (typed handler)", [&] { return run_hold_model<true>(1'000, events_count); });
+    report("all-to-all (C callback)", [&] { return run_all_to_all<false>(input_path, 1'048'576); });
+    report("all-to-all (typed handlers)", [&] { return run_all_to_all<true>(input_path, 1'048'576); });
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Event.h"
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <new>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+/// number of heap allocations so far
+static size_t allocations_count = 0;
+
+void* operator new(const size_t size) {
+    allocations_count++;
+    if (auto* const ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+/**
+ * Baseline: the previous EventQueue design,
+ * which allocated a shared EventList (holding a std::list<Event>) per scheduled event.
+ */
+class LegacyEventQueue {
+  public:
+    [[nodiscard]] EventTime get_current_time() const noexcept {
+        return current_time;
+    }
+
+    [[nodiscard]] bool finished() const noexcept {
+        return event_queue.empty();
+    }
+
+    void proceed() noexcept {
+        auto current_event_list = event_queue.top();
+        event_queue.pop();
+        current_time = current_event_list->event_time;
+        while (!current_event_list->events.empty()) {
+            current_event_list->events.front().invoke_event();
+            current_event_list->events.pop_front();
+        }
+    }
+
+    void schedule_event(const EventTime event_time, const Callback callback, const CallbackArg callback_arg) noexcept {
+        auto event_list = std::make_shared<LegacyEventList>();
+        event_list->event_time = event_time;
+        event_list->events.emplace_back(callback, callback_arg);
+        event_queue.push(std::move(event_list));
+    }
+
+  private:
+    struct LegacyEventList {
+        EventTime event_time;
+        std::list<Event> events;
+    };
+
+    struct EventComparator {
+        bool operator()(const std::shared_ptr<LegacyEventList>& a, const std::shared_ptr<LegacyEventList>& b) {
+            return a->event_time > b->event_time;
+        }
+    };
+
+    EventTime current_time = 0;
+
+    std::priority_queue<std::shared_ptr<LegacyEventList>, std::vector<std::shared_ptr<LegacyEventList>>, EventComparator>
+        event_queue;
+};
+
+/**
+ * Hold model: every invoked event schedules a new one,
+ * so the number of pending events stays constant.
+ */
+template <typename Queue> class HoldModel {
+  public:
+    HoldModel(Queue* const queue, const EventTime time_granularity) noexcept
+        : queue(queue),
+          time_granularity(time_granularity),
+          rng(42),
+          invoked_count(0) {}
+
+    static void invoke(void* const arg) noexcept {
+        auto* const model = static_cast<HoldModel*>(arg);
+        model->invoked_count++;
+        model->schedule();
+    }
+
+    void schedule() noexcept {
+        // link-like delays between 500 ns and 20 us
+        const auto delay = 500 + (rng() % 20'000) / time_granularity * time_granularity;
+        queue->schedule_event(queue->get_current_time() + delay, invoke, this);
+    }
+
+    [[nodiscard]] size_t get_invoked_count() const noexcept {
+        return invoked_count;
+    }
+
+  private:
+    Queue* queue;
+    EventTime time_granularity;
+    std::mt19937_64 rng;
+    size_t invoked_count;
+};
+
+/**
+ * Run the hold model, measuring the time and allocations per event.
+ *
+ * @tparam Budgeted whether to invoke the events by run_events() in one call, instead of proceed() per event time
+ */
+template <typename Queue, bool Budgeted = false>
+void run_hold_model(const std::string& name,
+                    Queue& queue,
+                    const size_t pending_count,
+                    const size_t events_count,
+                    const EventTime time_granularity) noexcept {
+    auto model = HoldModel<Queue>(&queue, time_granularity);
+
+    // warm up: fill the queue and let it reach its steady state
+    for (auto i = size_t{0}; i < pending_count; i++) {
+        model.schedule();
+    }
+    while (model.get_invoked_count() < events_count) {
+        queue.proceed();
+    }
+
+    // measure
+    const auto start_allocations = allocations_count;
+    const auto start_invoked = model.get_invoked_count();
+    const auto start = std::chrono::steady_clock::now();
+    if constexpr (Budgeted) {
+        queue.run_events(events_count);
+    } else {
+        while (model.get_invoked_count() - start_invoked < events_count) {
+            queue.proceed();
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // report
+    const auto invoked = static_cast<double>(model.get_invoked_count() - start_invoked);
+    const auto elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    const auto allocations = static_cast<double>(allocations_count - start_allocations);
+    std::printf("%-28s %12.1f %14.3f\n", name.c_str(), elapsed_ns / invoked, allocations / invoked);
+}
+
+void run_benchmark(const size_t pending_count, const size_t events_count, const EventTime time_granularity) noexcept {
+    std::printf("\n[hold model] pending events: %zu, measured events: %zu, time granularity: %llu ns\n",
+                pending_count, events_count, static_cast<unsigned long long>(time_granularity));
+    std::printf("%-28s %12s %14s\n", "queue", "ns/event", "allocs/event");
+
+    {
+        auto queue = LegacyEventQueue();
+        run_hold_model("legacy (EventList/event)", queue, pending_count, events_count, time_granularity);
+    }
+
+    const auto policies = std::vector<std::pair<std::string, SchedulingPolicy>>{
+        {"BinaryHeap", SchedulingPolicy::BinaryHeap},
+        {"CalendarQueue", SchedulingPolicy::CalendarQueue},
+        {"TimingWheel", SchedulingPolicy::TimingWheel},
+    };
+    for (const auto& [name, policy] : policies) {
+        auto queue = EventQueue(policy);
+        run_hold_model(name, queue, pending_count, events_count, time_granularity);
+    }
+    for (const auto& [name, policy] : policies) {
+        auto queue = EventQueue(policy);
+        run_hold_model<EventQueue, true>(name + " (run_events)", queue, pending_count, events_count,
+                                         time_granularity);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkEventQueue [pending events] [measured events]
+    const auto pending_count = (argc > 1) ? std::stoul(argv[1]) : size_t{100'000};
+    const auto events_count = (argc > 2) ? std::stoul(argv[2]) : size_t{2'000'000};
+
+    // distinct event times
+    run_benchmark(pending_count, events_count, 1);
+
+    // coarse event times: many events share the same time and get batched
+    run_benchmark(pending_count, events_count, 1'000);
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/LinkDisjointSimulation.h"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/// simulation the chunks are sent through, either sequential (nullptr) or decomposed
+static LinkDisjointSimulation* link_disjoint_simulation = nullptr;
+
+/// topology of the sequential simulation
+static Topology* sequential_topology = nullptr;
+
+/// a chunk bouncing between two NPUs
+struct Flow {
+    ChunkSize chunk_size;
+    DeviceId src;
+    DeviceId dest;
+    int rounds_left;
+};
+
+void send_flow(Flow* flow) noexcept;
+
+void chunk_arrived_callback(void* const arg) noexcept {
+    // send the chunk back from the dest for the next round
+    auto* const flow = static_cast<Flow*>(arg);
+    flow->rounds_left--;
+    if (flow->rounds_left > 0) {
+        std::swap(flow->src, flow->dest);
+        send_flow(flow);
+    }
+}
+
+void send_flow(Flow* const flow) noexcept {
+    auto chunk = std::make_unique<Chunk>(flow->chunk_size, flow->src, flow->dest, chunk_arrived_callback, flow);
+    if (link_disjoint_simulation != nullptr) {
+        link_disjoint_simulation->send(std::move(chunk));
+    } else {
+        sequential_topology->send(std::move(chunk));
+    }
+}
+
+/**
+ * Write the network input file of a Ring x FullyConnected x Switch topology.
+ *
+ * @return path of the input file
+ */
+std::string write_input(const std::vector<int>& npus_count_per_dim) {
+    const auto path = std::string("bench_link_disjoint.yml");
+    auto input = std::ofstream(path);
+    input << "topology: [ Ring, FullyConnected, Switch ]\n"
+          << "npus_count: [ " << npus_count_per_dim[0] << ", " << npus_count_per_dim[1] << ", "
+          << npus_count_per_dim[2] << " ]\n"
+          << "bandwidth: [ 200.0, 100.0, 50.0 ]\n"
+          << "latency: [ 100.0, 200.0, 500.0 ]\n";
+    return path;
+}
+
+/**
+ * Make an all-to-all within every instance of a dimension, bounced back for the given rounds.
+ *
+ * @return flows of the all-to-all
+ */
+std::deque<Flow> make_all_to_all_per_dim(const std::vector<int>& npus_count_per_dim,
+                                         const int dim,
+                                         const ChunkSize chunk_size,
+                                         const int rounds) {
+    auto stride = 1;
+    for (auto i = 0; i < dim; i++) {
+        stride *= npus_count_per_dim[i];
+    }
+    const auto dim_size = npus_count_per_dim[dim];
+    const auto npus_count = npus_count_per_dim[0] * npus_count_per_dim[1] * npus_count_per_dim[2];
+
+    auto flows = std::deque<Flow>();
+    for (auto src = 0; src < npus_count; src++) {
+        const auto coordinate = (src / stride) % dim_size;
+        for (auto peer = 0; peer < dim_size; peer++) {
+            if (peer != coordinate) {
+                flows.push_back({chunk_size, src, src + (peer - coordinate) * stride, rounds});
+            }
+        }
+    }
+    return flows;
+}
+
+void benchmark(const std::vector<int>& npus_count_per_dim, const int rounds) {
+    const auto input_path = write_input(npus_count_per_dim);
+    const auto network_parser = NetworkParser(input_path);
+    constexpr auto chunk_size = ChunkSize{65'536};
+    constexpr auto dims_count = 3;
+
+    std::printf("\n[Ring(%d) x FullyConnected(%d) x Switch(%d)] all-to-all per dimension of %llu B chunks, %d rounds\n",
+                npus_count_per_dim[0], npus_count_per_dim[1], npus_count_per_dim[2],
+                static_cast<unsigned long long>(chunk_size), rounds);
+    std::printf("%-12s %14s %12s %12s %14s %10s\n", "threads", "sim time (ns)", "events", "components", "wall (ms)",
+                "speedup");
+
+    // sequential simulation as the baseline, a phase per dimension
+    const auto topology = construct_topology(network_parser);
+    const auto event_queue = topology->get_event_queue();
+    sequential_topology = topology.get();
+    auto sequential_ms = 0.0;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        auto flows = make_all_to_all_per_dim(npus_count_per_dim, dim, chunk_size, rounds);
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& flow : flows) {
+            send_flow(&flow);
+        }
+        while (!event_queue->finished()) {
+            Topology::proceed(*event_queue);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        sequential_ms += std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    std::printf("%-12s %14llu %12llu %12s %14.1f %10s\n", "sequential",
+                static_cast<unsigned long long>(event_queue->get_current_time()),
+                static_cast<unsigned long long>(event_queue->get_processed_events_count()), "-", sequential_ms, "1.00");
+
+    // decomposed simulation, a run per dimension
+    for (const auto threads_count : {1, 2, 4, 8, 16}) {
+        auto simulation = LinkDisjointSimulation(network_parser, threads_count);
+        link_disjoint_simulation = &simulation;
+        auto decomposed_ms = 0.0;
+        auto components_count = 0;
+        for (auto dim = 0; dim < dims_count; dim++) {
+            auto flows = make_all_to_all_per_dim(npus_count_per_dim, dim, chunk_size, rounds);
+            const auto start = std::chrono::steady_clock::now();
+            for (auto& flow : flows) {
+                send_flow(&flow);
+            }
+            simulation.run();
+            const auto end = std::chrono::steady_clock::now();
+            decomposed_ms += std::chrono::duration<double, std::milli>(end - start).count();
+            components_count += simulation.get_components_count();
+        }
+        link_disjoint_simulation = nullptr;
+
+        std::printf("%-12d %14llu %12llu %12d %14.1f %10.2f\n", threads_count,
+                    static_cast<unsigned long long>(simulation.get_current_time()),
+                    static_cast<unsigned long long>(simulation.get_processed_events_count()), components_count,
+                    decomposed_ms, sequential_ms / decomposed_ms);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkLinkDisjoint [ring size] [fully-connected size] [switch size] [rounds]
+    const auto ring_size = (argc > 1) ? std::stoi(argv[1]) : 4;
+    const auto fully_connected_size = (argc > 2) ? std::stoi(argv[2]) : 16;
+    const auto switch_size = (argc > 3) ? std::stoi(argv[3]) : 16;
+    const auto rounds = (argc > 4) ? std::stoi(argv[4]) : 2;
+
+    benchmark({ring_size, fully_connected_size, switch_size}, rounds);
+
+    return 0;
+}
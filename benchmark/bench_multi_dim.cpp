@@ -0,0 +1,124 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/MultiDimTopology.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/Switch.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/// number of finished chunks
+static size_t finished_chunks_count = 0;
+
+void chunk_arrived_callback(void* const) noexcept {
+    finished_chunks_count++;
+}
+
+/**
+ * Get the resident set size of the process.
+ *
+ * @return resident set size in MiB
+ */
+double resident_mib() noexcept {
+    auto statm = std::ifstream("/proc/self/statm");
+    auto total_pages = size_t{0};
+    auto resident_pages = size_t{0};
+    statm >> total_pages >> resident_pages;
+    return static_cast<double>(resident_pages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+/**
+ * Run a phase of the hierarchical all-reduce:
+ * every NPU sends a chunk to every other NPU of its instance of the given dimension.
+ *
+ * @return simulated time of the phase
+ */
+EventTime run_phase(Topology& topology, const std::vector<int>& shape, const int dim, const ChunkSize chunk_size) {
+    const auto event_queue = topology.get_event_queue();
+    const auto start_time = event_queue->get_current_time();
+    const auto npus_count = topology.get_npus_count();
+
+    auto stride = 1;
+    for (auto i = 0; i < dim; i++) {
+        stride *= shape[i];
+    }
+
+    for (auto src = 0; src < npus_count; src++) {
+        const auto src_address = (src / stride) % shape[dim];
+        for (auto dest_address = 0; dest_address < shape[dim]; dest_address++) {
+            if (dest_address == src_address) {
+                continue;
+            }
+            const auto dest = src + (dest_address - src_address) * stride;
+            topology.send(topology.make_chunk(chunk_size, src, dest, chunk_arrived_callback, nullptr));
+        }
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+
+    return event_queue->get_current_time() - start_time;
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkMultiDim [ring size] [fully-connected size] [switch size] [all-reduce size in MiB]
+    const auto shape = std::vector<int>{(argc > 1) ? std::stoi(argv[1]) : 16, (argc > 2) ? std::stoi(argv[2]) : 32,
+                                        (argc > 3) ? std::stoi(argv[3]) : 32};
+    const auto all_reduce_size = ChunkSize{1'048'576} * ((argc > 4) ? std::stoull(argv[4]) : 16);
+
+    // build the topology
+    const auto resident_before = resident_mib();
+    const auto build_start = std::chrono::steady_clock::now();
+    auto topology = MultiDimTopology();
+    topology.append_dimension(std::make_unique<Ring>(shape[0], 200, 50));
+    topology.append_dimension(std::make_unique<FullyConnected>(shape[1], 100, 500));
+    topology.append_dimension(std::make_unique<Switch>(shape[2], 50, 2'000));
+    topology.build();
+    const auto build_end = std::chrono::steady_clock::now();
+
+    const auto build_ms = std::chrono::duration<double, std::milli>(build_end - build_start).count();
+    std::printf("[build] Ring(%d) x FullyConnected(%d) x Switch(%d): %d NPUs, %d devices\n", shape[0], shape[1],
+                shape[2], topology.get_npus_count(), topology.get_devices_count());
+    std::printf("build: %.1f ms, memory: %.1f MiB\n", build_ms, resident_mib() - resident_before);
+
+    // hierarchical all-reduce: reduce-scatter from the lowest dimension, then all-gather from the highest one
+    std::printf("\n[all-reduce] %llu MiB per NPU\n", static_cast<unsigned long long>(all_reduce_size / 1'048'576));
+    std::printf("%-24s %14s %14s\n", "phase", "chunk (B)", "sim time (ns)");
+    const auto run_start = std::chrono::steady_clock::now();
+    auto chunk_size = all_reduce_size;
+    auto chunk_sizes = std::vector<ChunkSize>();
+    for (auto dim = 0; dim < 3; dim++) {
+        chunk_size /= shape[dim];
+        chunk_sizes.push_back(chunk_size);
+        const auto phase_time = run_phase(topology, shape, dim, chunk_size);
+        std::printf("%-24s %14llu %14llu\n", ("reduce-scatter dim " + std::to_string(dim)).c_str(),
+                    static_cast<unsigned long long>(chunk_size), static_cast<unsigned long long>(phase_time));
+    }
+    for (auto dim = 2; dim >= 0; dim--) {
+        const auto phase_time = run_phase(topology, shape, dim, chunk_sizes[dim]);
+        std::printf("%-24s %14llu %14llu\n", ("all-gather dim " + std::to_string(dim)).c_str(),
+                    static_cast<unsigned long long>(chunk_sizes[dim]), static_cast<unsigned long long>(phase_time));
+    }
+    const auto run_end = std::chrono::steady_clock::now();
+
+    const auto event_queue = topology.get_event_queue();
+    const auto run_ms = std::chrono::duration<double, std::milli>(run_end - run_start).count();
+    std::printf("\ntotal: %llu ns simulated, %zu chunks, %llu events, %.1f ms wall\n",
+                static_cast<unsigned long long>(event_queue->get_current_time()), finished_chunks_count,
+                static_cast<unsigned long long>(event_queue->get_processed_events_count()), run_ms);
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/ParallelSimulation.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/// simulation the chunks are sent through, either sequential (nullptr) or parallel
+static ParallelSimulation* parallel_simulation = nullptr;
+
+/// topology of the sequential simulation
+static Topology* sequential_topology = nullptr;
+
+/// number of finished chunks, counted by the worker threads
+static std::atomic<size_t> finished_chunks_count = 0;
+
+/// a chunk bouncing between two NPUs
+struct Flow {
+    ChunkSize chunk_size;
+    DeviceId src;
+    DeviceId dest;
+    int rounds_left;
+};
+
+void send_flow(Flow* flow) noexcept;
+
+void chunk_arrived_callback(void* const arg) noexcept {
+    finished_chunks_count++;
+
+    // send the chunk back from the dest for the next round
+    auto* const flow = static_cast<Flow*>(arg);
+    flow->rounds_left--;
+    if (flow->rounds_left > 0) {
+        std::swap(flow->src, flow->dest);
+        send_flow(flow);
+    }
+}
+
+void send_flow(Flow* const flow) noexcept {
+    auto chunk = std::make_unique<Chunk>(flow->chunk_size, flow->src, flow->dest, chunk_arrived_callback, flow);
+    if (parallel_simulation != nullptr) {
+        parallel_simulation->send(std::move(chunk));
+    } else {
+        sequential_topology->send(std::move(chunk));
+    }
+}
+
+/**
+ * Write the network input file of a single-dimensional topology.
+ *
+ * @return path of the input file
+ */
+std::string write_input(const std::string& topology_name, const int npus_count) {
+    const auto path = "bench_parallel_" + topology_name + ".yml";
+    auto input = std::ofstream(path);
+    input << "topology: [ " << topology_name << " ]\n"
+          << "npus_count: [ " << npus_count << " ]\n"
+          << "bandwidth: [ 50.0 ]\n"
+          << "latency: [ 500.0 ]\n";
+    return path;
+}
+
+/**
+ * Make an all-to-all, where every NPU sends a chunk to every other NPU, bounced back for the given rounds.
+ *
+ * @return flows of the all-to-all
+ */
+std::deque<Flow> make_all_to_all(const int npus_count, const ChunkSize chunk_size, const int rounds) {
+    auto flows = std::deque<Flow>();
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src != dest) {
+                flows.push_back({chunk_size, src, dest, rounds});
+            }
+        }
+    }
+    return flows;
+}
+
+void benchmark(const std::string& topology_name, const int npus_count, const int rounds) {
+    const auto input_path = write_input(topology_name, npus_count);
+    const auto network_parser = NetworkParser(input_path);
+    constexpr auto chunk_size = ChunkSize{65'536};
+
+    std::printf("\n[%s(%d)] all-to-all of %llu B chunks, %d rounds\n", topology_name.c_str(), npus_count,
+                static_cast<unsigned long long>(chunk_size), rounds);
+    std::printf("%-12s %14s %12s %12s %14s %10s\n", "threads", "sim time (ns)", "events", "windows", "wall (ms)",
+                "speedup");
+
+    // sequential simulation as the baseline
+    auto flows = make_all_to_all(npus_count, chunk_size, rounds);
+    const auto topology = construct_topology(network_parser);
+    const auto event_queue = topology->get_event_queue();
+    sequential_topology = topology.get();
+    finished_chunks_count = 0;
+    const auto sequential_start = std::chrono::steady_clock::now();
+    for (auto& flow : flows) {
+        send_flow(&flow);
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+    const auto sequential_end = std::chrono::steady_clock::now();
+    const auto sequential_ms = std::chrono::duration<double, std::milli>(sequential_end - sequential_start).count();
+    std::printf("%-12s %14llu %12llu %12s %14.1f %10s\n", "sequential",
+                static_cast<unsigned long long>(event_queue->get_current_time()),
+                static_cast<unsigned long long>(event_queue->get_processed_events_count()), "-", sequential_ms, "1.00");
+
+    // parallel simulation
+    for (const auto threads_count : {1, 2, 4, 8, 16}) {
+        flows = make_all_to_all(npus_count, chunk_size, rounds);
+        auto simulation = ParallelSimulation(network_parser, threads_count);
+        parallel_simulation = &simulation;
+        finished_chunks_count = 0;
+        const auto parallel_start = std::chrono::steady_clock::now();
+        for (auto& flow : flows) {
+            send_flow(&flow);
+        }
+        simulation.run();
+        const auto parallel_end = std::chrono::steady_clock::now();
+        parallel_simulation = nullptr;
+
+        const auto parallel_ms = std::chrono::duration<double, std::milli>(parallel_end - parallel_start).count();
+        std::printf("%-12d %14llu %12llu %12llu %14.1f %10.2f\n", threads_count,
+                    static_cast<unsigned long long>(simulation.get_current_time()),
+                    static_cast<unsigned long long>(simulation.get_processed_events_count()),
+                    static_cast<unsigned long long>(simulation.get_windows_count()), parallel_ms,
+                    sequential_ms / parallel_ms);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkParallel [fully-connected size] [ring size] [rounds]
+    const auto fully_connected_size = (argc > 1) ? std::stoi(argv[1]) : 256;
+    const auto ring_size = (argc > 2) ? std::stoi(argv[2]) : 128;
+    const auto rounds = (argc > 3) ? std::stoi(argv[3]) : 2;
+
+    benchmark("FullyConnected", fully_connected_size, rounds);
+    benchmark("Ring", ring_size, rounds);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/Switch.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/// number of finished chunks
+static size_t finished_chunks_count = 0;
+
+void chunk_arrived_callback(void* const) noexcept {
+    finished_chunks_count++;
+}
+
+/**
+ * Construct a route between every pair of NPUs.
+ */
+void run_routes(const std::string& name, const Topology& topology) noexcept {
+    const auto npus_count = topology.get_npus_count();
+
+    auto hops_count = size_t{0};
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+            const auto route = topology.route(i, j);
+            hops_count += route.size() - 1;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto routes_count = static_cast<double>(npus_count) * (npus_count - 1);
+    const auto elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-40s %14.1f %14.2f\n", name.c_str(), elapsed_ns / routes_count,
+                elapsed_ns / static_cast<double>(hops_count));
+}
+
+/**
+ * All-gather: every NPU sends a chunk to every other NPU.
+ */
+void run_all_gather(const std::string& name, Topology& topology, const std::shared_ptr<EventQueue>& event_queue) {
+    const auto npus_count = topology.get_npus_count();
+    finished_chunks_count = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+            auto route = topology.route(i, j);
+            auto chunk = std::make_unique<Chunk>(1'048'576, std::move(route), chunk_arrived_callback, nullptr);
+            topology.send(std::move(chunk));
+        }
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    std::printf("%-40s %14.1f %14zu %14llu\n", name.c_str(), elapsed_ms, finished_chunks_count,
+                static_cast<unsigned long long>(event_queue->get_current_time()));
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkRoute [npus count]
+    const auto npus_count = (argc > 1) ? std::stoi(argv[1]) : 1'024;
+
+    const auto event_queue = std::make_shared<EventQueue>();
+    auto ring = Ring(npus_count, 50, 500);
+    auto fully_connected = FullyConnected(npus_count, 50, 500);
+    auto switch_topology = Switch(npus_count, 50, 500);
+    fully_connected.set_event_queue(event_queue);
+    switch_topology.set_event_queue(event_queue);
+
+    std::printf("[route construction] %d NPUs, every pair\n", npus_count);
+    std::printf("%-40s %14s %14s\n", "topology", "ns/route", "ns/hop");
+    run_routes("Ring", ring);
+    run_routes("FullyConnected", fully_connected);
+    run_routes("Switch", switch_topology);
+
+    std::printf("\n[all-gather] %d NPUs, 1 MB chunks\n", npus_count);
+    std::printf("%-40s %14s %14s %14s\n", "topology", "wall (ms)", "chunks", "sim time (ns)");
+    run_all_gather("FullyConnected", fully_connected, event_queue);
+    run_all_gather("Switch", switch_topology, event_queue);
+
+    return 0;
+}
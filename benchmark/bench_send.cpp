@@ -0,0 +1,163 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Type.h"
+#include "congestion_unaware/FullyConnected.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
+#include "congestion_unaware/Switch.h"
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+/// number of heap allocations so far
+static size_t allocations_count = 0;
+
+void* operator new(const size_t size) {
+    allocations_count++;
+    if (auto* const ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+/**
+ * Call send for every given (src, dest) pair, reporting ns and heap allocations per call.
+ */
+void run_sends(const std::string& name,
+               const Topology& topology,
+               const std::vector<std::pair<DeviceId, DeviceId>>& pairs,
+               const int rounds_count) noexcept {
+    auto total_delay = EventTime{0};
+
+    const auto start_allocations = allocations_count;
+    const auto start = std::chrono::steady_clock::now();
+    for (auto round = 0; round < rounds_count; round++) {
+        for (const auto& [src, dest] : pairs) {
+            total_delay += topology.send(src, dest, 1'048'576);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const auto allocations = allocations_count - start_allocations;
+
+    const auto calls_count = static_cast<double>(pairs.size()) * rounds_count;
+    const auto elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-40s %14.2f %14.2f %20llu\n", name.c_str(), elapsed_ns / calls_count,
+                static_cast<double>(allocations) / calls_count, static_cast<unsigned long long>(total_delay));
+}
+
+/**
+ * Call send_batch over every given (src, dest) pair at once, reporting ns and heap allocations per chunk.
+ */
+void run_send_batch(const std::string& name,
+                    const Topology& topology,
+                    const std::vector<std::pair<DeviceId, DeviceId>>& pairs,
+                    const int rounds_count) noexcept {
+    // lay out the chunks as arrays
+    auto srcs = std::vector<DeviceId>();
+    auto dests = std::vector<DeviceId>();
+    srcs.reserve(pairs.size());
+    dests.reserve(pairs.size());
+    for (const auto& [src, dest] : pairs) {
+        srcs.push_back(src);
+        dests.push_back(dest);
+    }
+    const auto chunk_sizes = std::vector<ChunkSize>(pairs.size(), 1'048'576);
+    auto delays = std::vector<EventTime>(pairs.size());
+    auto total_delay = EventTime{0};
+
+    const auto start_allocations = allocations_count;
+    const auto start = std::chrono::steady_clock::now();
+    for (auto round = 0; round < rounds_count; round++) {
+        topology.send_batch(srcs.data(), dests.data(), chunk_sizes.data(), delays.data(), pairs.size());
+        for (const auto delay : delays) {
+            total_delay += delay;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const auto allocations = allocations_count - start_allocations;
+
+    const auto calls_count = static_cast<double>(pairs.size()) * rounds_count;
+    const auto elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-40s %14.2f %14.2f %20llu\n", name.c_str(), elapsed_ns / calls_count,
+                static_cast<double>(allocations) / calls_count, static_cast<unsigned long long>(total_delay));
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkSend [rounds count]
+    const auto rounds_count = (argc > 1) ? std::stoi(argv[1]) : 10;
+
+    // Ring(16) x FullyConnected(32) x Switch(32), in the default and the precomputed mode
+    auto topology = MultiDimTopology();
+    auto precomputed_topology = MultiDimTopology();
+    for (auto* const multi_dim_topology : {&topology, &precomputed_topology}) {
+        multi_dim_topology->append_dimension(std::make_unique<Ring>(16, 200, 20, true));
+        multi_dim_topology->append_dimension(std::make_unique<FullyConnected>(32, 100, 100));
+        multi_dim_topology->append_dimension(std::make_unique<Switch>(32, 50, 500));
+    }
+    const auto tables_bytes = precomputed_topology.precompute_delays(1'048'576);
+
+    // the same shape, fixed at compile time
+    using StaticTopology = StaticMultiDimTopology<Ring, FullyConnected, Switch>;
+    auto static_topology = StaticTopology(Ring(16, 200, 20, true), FullyConnected(32, 100, 100), Switch(32, 50, 500));
+    auto precomputed_static_topology =
+        StaticTopology(Ring(16, 200, 20, true), FullyConnected(32, 100, 100), Switch(32, 50, 500));
+    [[maybe_unused]] const auto static_tables_bytes = precomputed_static_topology.precompute_delays(1'048'576);
+    assert(static_tables_bytes == tables_bytes);
+    const auto npus_count = topology.get_npus_count();
+
+    // random pairs, and pairs differing in the highest dimension only (i.e., the longest address scan)
+    constexpr auto pairs_count = 1'000'000;
+    auto rng = std::mt19937(2024);
+    auto random_pairs = std::vector<std::pair<DeviceId, DeviceId>>();
+    auto highest_dim_pairs = std::vector<std::pair<DeviceId, DeviceId>>();
+    random_pairs.reserve(pairs_count);
+    highest_dim_pairs.reserve(pairs_count);
+    for (auto i = 0; i < pairs_count; i++) {
+        const auto src = static_cast<DeviceId>(rng() % npus_count);
+        const auto dest = static_cast<DeviceId>((src + 1 + rng() % (npus_count - 1)) % npus_count);
+        random_pairs.emplace_back(src, dest);
+        highest_dim_pairs.emplace_back(src, (src + 512 * (1 + rng() % 31)) % npus_count);
+    }
+
+    std::printf("[send] Ring(16) x FullyConnected(32) x Switch(32), %d NPUs\n", npus_count);
+    std::printf("%-40s %14s %14s %20s\n", "pairs", "ns/call", "allocs/call", "checksum");
+    run_sends("random", topology, random_pairs, rounds_count);
+    run_sends("highest dimension", topology, highest_dim_pairs, rounds_count);
+    run_send_batch("random (send_batch)", topology, random_pairs, rounds_count);
+    run_send_batch("highest dimension (send_batch)", topology, highest_dim_pairs, rounds_count);
+    std::printf("\n[send, precomputed] hop tables: %zu B\n", tables_bytes);
+    run_sends("random", precomputed_topology, random_pairs, rounds_count);
+    run_sends("highest dimension", precomputed_topology, highest_dim_pairs, rounds_count);
+    run_send_batch("random (send_batch)", precomputed_topology, random_pairs, rounds_count);
+    run_send_batch("highest dimension (send_batch)", precomputed_topology, highest_dim_pairs, rounds_count);
+    std::printf("\n[send, static]\n");
+    run_sends("random", static_topology, random_pairs, rounds_count);
+    run_sends("highest dimension", static_topology, highest_dim_pairs, rounds_count);
+    std::printf("\n[send, static, precomputed]\n");
+    run_sends("random", precomputed_static_topology, random_pairs, rounds_count);
+    run_sends("highest dimension", precomputed_static_topology, highest_dim_pairs, rounds_count);
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/TimeWarpSimulation.h"
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/// simulation the chunks are sent through, either sequential (nullptr) or optimistic
+static TimeWarpSimulation* time_warp_simulation = nullptr;
+
+/// topology of the sequential simulation
+static Topology* sequential_topology = nullptr;
+
+/// a chunk bouncing between two NPUs
+struct Flow {
+    ChunkSize chunk_size;
+    DeviceId src;
+    DeviceId dest;
+    int rounds_left;
+};
+
+void send_flow(Flow* flow) noexcept;
+
+void chunk_arrived_callback(void* const arg) noexcept {
+    // send the chunk back from the dest for the next round
+    auto* const flow = static_cast<Flow*>(arg);
+    flow->rounds_left--;
+    if (flow->rounds_left > 0) {
+        std::swap(flow->src, flow->dest);
+        send_flow(flow);
+    }
+}
+
+void send_flow(Flow* const flow) noexcept {
+    auto chunk = std::make_unique<Chunk>(flow->chunk_size, flow->src, flow->dest, chunk_arrived_callback, flow);
+    if (time_warp_simulation != nullptr) {
+        time_warp_simulation->send(std::move(chunk));
+    } else {
+        sequential_topology->send(std::move(chunk));
+    }
+}
+
+/**
+ * Write the network input file of a single-dimensional topology.
+ *
+ * @return path of the input file
+ */
+std::string write_input(const std::string& topology_name, const int npus_count, const double latency) {
+    const auto path = "bench_time_warp_" + topology_name + ".yml";
+    auto input = std::ofstream(path);
+    input << "topology: [ " << topology_name << " ]\n"
+          << "npus_count: [ " << npus_count << " ]\n"
+          << "bandwidth: [ 50.0 ]\n"
+          << "latency: [ " << latency << " ]\n";
+    return path;
+}
+
+/**
+ * Make an all-to-all, where every NPU sends a chunk to every other NPU, bounced back for the given rounds.
+ *
+ * @return flows of the all-to-all
+ */
+std::deque<Flow> make_all_to_all(const int npus_count, const ChunkSize chunk_size, const int rounds) {
+    auto flows = std::deque<Flow>();
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src != dest) {
+                flows.push_back({chunk_size, src, dest, rounds});
+            }
+        }
+    }
+    return flows;
+}
+
+void benchmark(const std::string& topology_name,
+               const int npus_count,
+               const double latency,
+               const int rounds,
+               const EventTime optimism_window) {
+    const auto input_path = write_input(topology_name, npus_count, latency);
+    const auto network_parser = NetworkParser(input_path);
+    constexpr auto chunk_size = ChunkSize{65'536};
+
+    std::printf("\n[%s(%d), latency %.0f ns] all-to-all of %llu B chunks, %d rounds, optimism window %llu ns\n",
+                topology_name.c_str(), npus_count, latency, static_cast<unsigned long long>(chunk_size), rounds,
+                static_cast<unsigned long long>(optimism_window));
+    std::printf("%-12s %14s %12s %12s %10s %12s %12s %10s %14s\n", "threads", "sim time (ns)", "committed",
+                "processed", "rollbacks", "anti-msgs", "peak saved", "rounds", "events/s");
+
+    // sequential simulation as the baseline
+    auto flows = make_all_to_all(npus_count, chunk_size, rounds);
+    const auto topology = construct_topology(network_parser);
+    const auto event_queue = topology->get_event_queue();
+    sequential_topology = topology.get();
+    const auto sequential_start = std::chrono::steady_clock::now();
+    for (auto& flow : flows) {
+        send_flow(&flow);
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+    const auto sequential_end = std::chrono::steady_clock::now();
+    const auto sequential_s = std::chrono::duration<double>(sequential_end - sequential_start).count();
+    const auto sequential_events_count = event_queue->get_processed_events_count();
+    std::printf("%-12s %14llu %12llu %12s %10s %12s %12s %10s %14.3e\n", "sequential",
+                static_cast<unsigned long long>(event_queue->get_current_time()),
+                static_cast<unsigned long long>(sequential_events_count), "-", "-", "-", "-", "-",
+                static_cast<double>(sequential_events_count) / sequential_s);
+
+    // optimistic simulation
+    for (const auto threads_count : {1, 2, 4, 8, 16}) {
+        flows = make_all_to_all(npus_count, chunk_size, rounds);
+        auto simulation = TimeWarpSimulation(network_parser, threads_count, optimism_window);
+        time_warp_simulation = &simulation;
+        for (auto& flow : flows) {
+            send_flow(&flow);
+        }
+        simulation.run();
+        time_warp_simulation = nullptr;
+
+        const auto stats = simulation.get_stats();
+        std::printf("%-12d %14llu %12llu %12llu %10llu %12llu %12llu %10llu %14.3e  (rollback ratio %.3f)\n",
+                    threads_count, static_cast<unsigned long long>(simulation.get_current_time()),
+                    static_cast<unsigned long long>(stats.committed_events_count),
+                    static_cast<unsigned long long>(stats.processed_events_count),
+                    static_cast<unsigned long long>(stats.rollbacks_count),
+                    static_cast<unsigned long long>(stats.anti_messages_count),
+                    static_cast<unsigned long long>(stats.peak_uncommitted_events_count),
+                    static_cast<unsigned long long>(stats.rounds_count), stats.event_rate, stats.rollback_ratio);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkTimeWarp [switch size] [ring size] [rounds] [optimism window in ns]
+    const auto switch_size = (argc > 1) ? std::stoi(argv[1]) : 64;
+    const auto ring_size = (argc > 2) ? std::stoi(argv[2]) : 64;
+    const auto rounds = (argc > 3) ? std::stoi(argv[3]) : 2;
+    const auto optimism_window =
+        (argc > 4) ? EventTime{std::stoull(argv[4])} : TimeWarpSimulation::default_optimism_window;
+
+    // zero latency leaves no lookahead for conservative synchronization
+    benchmark("Switch", switch_size, 0.0, rounds, optimism_window);
+    benchmark("Ring", ring_size, 500.0, rounds, optimism_window);
+
+    return 0;
+}
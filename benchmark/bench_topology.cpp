@@ -0,0 +1,84 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/Switch.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+/**
+ * Get the resident set size of the process.
+ *
+ * @return resident set size in MiB
+ */
+double resident_mib() noexcept {
+    auto statm = std::ifstream("/proc/self/statm");
+    auto total_pages = size_t{0};
+    auto resident_pages = size_t{0};
+    statm >> total_pages >> resident_pages;
+    return static_cast<double>(resident_pages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+void chunk_arrived_callback(void* const) noexcept {}
+
+/**
+ * Construct a topology, reporting its construction time and memory footprint,
+ * then the memory footprint once every NPU has sent a chunk to its neighbor.
+ */
+template <typename TopologyType> void run_construction(const std::string& name, const int npus_count) noexcept {
+    const auto resident_before = resident_mib();
+    const auto start = std::chrono::steady_clock::now();
+    {
+        const auto topology = std::make_unique<TopologyType>(npus_count, 50, 500);
+        const auto end = std::chrono::steady_clock::now();
+        const auto resident_after = resident_mib();
+
+        // neighbor exchange, using a link per NPU
+        const auto event_queue = topology->get_event_queue();
+        for (auto src = 0; src < npus_count; src++) {
+            const auto dest = (src + 1) % npus_count;
+            topology->send(topology->make_chunk(1'048'576, src, dest, chunk_arrived_callback, nullptr));
+        }
+        while (!event_queue->finished()) {
+            Topology::proceed(*event_queue);
+        }
+        const auto resident_after_exchange = resident_mib();
+
+        const auto elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        std::printf("%-24s %8d %14.1f %14.1f %14.1f\n", name.c_str(), npus_count, elapsed_ms,
+                    resident_after - resident_before, resident_after_exchange - resident_before);
+    }
+}
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkTopology [FullyConnected|Switch|Ring] [npus count]
+    // (run a single topology per process, so that memory footprints don't mix)
+    const auto topology_name = (argc > 1) ? std::string(argv[1]) : std::string("FullyConnected");
+    const auto npus_count = (argc > 2) ? std::stoi(argv[2]) : 4'096;
+
+    std::printf("%-24s %8s %14s %14s %14s\n", "topology", "NPUs", "build (ms)", "memory (MiB)", "+exchange");
+    if (topology_name == "FullyConnected") {
+        run_construction<FullyConnected>(topology_name, npus_count);
+    } else if (topology_name == "Switch") {
+        run_construction<Switch>(topology_name, npus_count);
+    } else if (topology_name == "Ring") {
+        run_construction<Ring>(topology_name, npus_count);
+    } else {
+        std::fprintf(stderr, "unknown topology: %s\n", topology_name.c_str());
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/Type.h"
+#include "congestion_unaware/Helper.h"
+#include "congestion_unaware/MultiConfigTopology.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+int main(const int argc, char* argv[]) {
+    // usage: BenchmarkWhatIf [configs count]
+    const auto configs_count = (argc > 1) ? std::stoi(argv[1]) : 64;
+
+    // Ring(16) x FullyConnected(32) x Switch(32), with bandwidth and latency variants
+    const auto topologies_per_dim = std::vector<TopologyBuildingBlock>{
+        TopologyBuildingBlock::Ring, TopologyBuildingBlock::FullyConnected, TopologyBuildingBlock::Switch};
+    const auto npus_counts_per_dim = std::vector<int>{16, 32, 32};
+    auto bandwidths_per_config = std::vector<std::vector<Bandwidth>>();
+    auto latencies_per_config = std::vector<std::vector<Latency>>();
+    for (auto config = 0; config < configs_count; config++) {
+        bandwidths_per_config.push_back({200.0 + (config % 8) * 50, 100.0 + (config / 8) * 25, 50});
+        latencies_per_config.push_back({20, 100.0 + (config % 4) * 50, 500.0 + (config % 16) * 100});
+    }
+
+    // a topology per configuration, and a single multi-configuration topology
+    auto topologies = std::vector<MultiDimTopology>(configs_count);
+    for (auto config = 0; config < configs_count; config++) {
+        for (auto dim = 0; dim < 3; dim++) {
+            topologies[config].append_dimension(
+                construct_basic_topology(topologies_per_dim[dim], npus_counts_per_dim[dim],
+                                         bandwidths_per_config[config][dim], latencies_per_config[config][dim]));
+        }
+    }
+    auto multi_config_topology = MultiConfigTopology(topologies_per_dim, npus_counts_per_dim, bandwidths_per_config[0],
+                                                     latencies_per_config[0]);
+    for (auto config = 1; config < configs_count; config++) {
+        multi_config_topology.add_config(bandwidths_per_config[config], latencies_per_config[config]);
+    }
+    const auto npus_count = multi_config_topology.get_npus_count();
+
+    // workload: random sends
+    constexpr auto chunks_count = size_t{100'000};
+    auto rng = std::mt19937(2024);
+    auto srcs = std::vector<DeviceId>(chunks_count);
+    auto dests = std::vector<DeviceId>(chunks_count);
+    auto chunk_sizes = std::vector<ChunkSize>(chunks_count);
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        srcs[i] = static_cast<DeviceId>(rng() % npus_count);
+        dests[i] = static_cast<DeviceId>((srcs[i] + 1 + rng() % (npus_count - 1)) % npus_count);
+        chunk_sizes[i] = 1 + rng() % 4'194'304;
+    }
+
+    std::printf("[what-if] Ring(16) x FullyConnected(32) x Switch(32), %d configs, %zu chunks\n", configs_count,
+                chunks_count);
+    std::printf("%-40s %14s %14s %20s\n", "method", "total (ms)", "ns/chunk/config", "checksum");
+
+    // run each configuration separately
+    auto total_delay = EventTime{0};
+    auto start = std::chrono::steady_clock::now();
+    for (auto config = 0; config < configs_count; config++) {
+        for (auto i = size_t{0}; i < chunks_count; i++) {
+            total_delay += topologies[config].send(srcs[i], dests[i], chunk_sizes[i]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    auto evaluations_count = static_cast<double>(chunks_count) * configs_count;
+    std::printf("%-40s %14.1f %14.2f %20llu\n", "send per config", elapsed_ns / 1e6, elapsed_ns / evaluations_count,
+                static_cast<unsigned long long>(total_delay));
+
+    // run every configuration at once
+    auto delays = std::vector<EventTime>(static_cast<size_t>(configs_count));
+    total_delay = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        multi_config_topology.send(srcs[i], dests[i], chunk_sizes[i], delays.data());
+        for (const auto delay : delays) {
+            total_delay += delay;
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-40s %14.1f %14.2f %20llu\n", "MultiConfigTopology", elapsed_ns / 1e6,
+                elapsed_ns / evaluations_count, static_cast<unsigned long long>(total_delay));
+
+    return 0;
+}
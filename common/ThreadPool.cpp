@@ -0,0 +1,109 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+ThreadPool::ThreadPool(const int workers_count) noexcept
+    : task(nullptr),
+      tasks_count(0),
+      next_task(0),
+      job_id(0),
+      running_threads_count(0),
+      stopping(false) {
+    assert(workers_count >= 0);
+
+    // use every hardware thread by default
+    auto threads_count = workers_count;
+    if (threads_count == 0) {
+        threads_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // the calling thread is worker 0
+    threads.reserve(threads_count - 1);
+    for (auto worker_id = 1; worker_id < threads_count; worker_id++) {
+        threads.emplace_back(&ThreadPool::work, this, worker_id);
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept {
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex);
+        stopping = true;
+    }
+    job_started.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallel_for(const size_t tasks_count, const Task& task) noexcept {
+    // start a job
+    {
+        const auto lock = std::lock_guard<std::mutex>(mutex);
+        assert(running_threads_count == 0);
+
+        this->task = &task;
+        this->tasks_count = tasks_count;
+        next_task.store(0, std::memory_order_relaxed);
+        running_threads_count = static_cast<int>(threads.size());
+        job_id++;
+    }
+    job_started.notify_all();
+
+    // take part in the job
+    run_tasks(0);
+
+    // wait for the other workers
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    job_finished.wait(lock, [this] { return running_threads_count == 0; });
+    this->task = nullptr;
+}
+
+int ThreadPool::get_workers_count() const noexcept {
+    return static_cast<int>(threads.size()) + 1;
+}
+
+void ThreadPool::work(const int worker_id) noexcept {
+    auto last_job_id = size_t{0};
+    while (true) {
+        // wait for a new job
+        {
+            auto lock = std::unique_lock<std::mutex>(mutex);
+            job_started.wait(lock, [&] { return stopping || job_id != last_job_id; });
+            if (stopping) {
+                return;
+            }
+            last_job_id = job_id;
+        }
+
+        run_tasks(worker_id);
+
+        // report the job is done
+        {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            running_threads_count--;
+            if (running_threads_count == 0) {
+                job_finished.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::run_tasks(const int worker_id) noexcept {
+    assert(task != nullptr);
+
+    while (true) {
+        const auto task_index = next_task.fetch_add(1, std::memory_order_relaxed);
+        if (task_index >= tasks_count) {
+            return;
+        }
+        (*task)(task_index, worker_id);
+    }
+}
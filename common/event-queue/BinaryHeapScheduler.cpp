@@ -0,0 +1,50 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/BinaryHeapScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+BinaryHeapScheduler::BinaryHeapScheduler() noexcept : EventScheduler() {
+    // create an empty heap
+    heap = std::vector<ScheduledEvent>();
+}
+
+void BinaryHeapScheduler::push(ScheduledEvent event) noexcept {
+    heap.push_back(std::move(event));
+    std::push_heap(heap.begin(), heap.end(), follows);
+    events_count++;
+}
+
+ScheduledEvent BinaryHeapScheduler::pop() noexcept {
+    assert(!empty());
+
+    // move the earliest entry to the back, then take it
+    std::pop_heap(heap.begin(), heap.end(), follows);
+    auto event = std::move(heap.back());
+    heap.pop_back();
+    events_count--;
+
+    return event;
+}
+
+EventTime BinaryHeapScheduler::peek_time() const noexcept {
+    assert(!empty());
+
+    return heap.front().event_time;
+}
+
+const ScheduledEvent& BinaryHeapScheduler::peek() const noexcept {
+    assert(!empty());
+
+    return heap.front();
+}
+
+void BinaryHeapScheduler::reset(const EventTime) noexcept {
+    // the heap keeps no time base
+    assert(empty());
+}
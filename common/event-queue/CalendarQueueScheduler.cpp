@@ -0,0 +1,208 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/CalendarQueueScheduler.h"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+using namespace NetworkAnalytical;
+
+CalendarQueueScheduler::CalendarQueueScheduler() noexcept
+    : EventScheduler(),
+      bucket_width(1),
+      last_bucket(0),
+      bucket_top(1),
+      last_time(0) {
+    // create an empty calendar
+    buckets = std::vector<Bucket>(min_buckets_count);
+}
+
+void CalendarQueueScheduler::push(ScheduledEvent event) noexcept {
+    // entries cannot be scheduled before the last popped one
+    assert(event.event_time >= last_time);
+
+    insert(std::move(event));
+    events_count++;
+
+    // grow the calendar if buckets get crowded
+    if (events_count > 2 * buckets.size()) {
+        resize(2 * buckets.size());
+    }
+}
+
+ScheduledEvent CalendarQueueScheduler::pop() noexcept {
+    assert(!empty());
+
+    // take the earliest entry
+    auto searched_directly = false;
+    const auto index = find_earliest_bucket(searched_directly);
+    auto& bucket = buckets[index];
+    auto event = std::move(bucket.events[bucket.head]);
+    bucket.head++;
+    events_count--;
+
+    // drop popped entries of the bucket
+    if (bucket.head == bucket.events.size()) {
+        bucket.events.clear();
+        bucket.head = 0;
+    } else if (bucket.head >= width_samples_count && 2 * bucket.head >= bucket.events.size()) {
+        const auto head = static_cast<std::ptrdiff_t>(bucket.head);
+        bucket.events.erase(bucket.events.begin(), bucket.events.begin() + head);
+        bucket.head = 0;
+    }
+
+    // the calendar now starts from the day of the popped entry
+    last_time = event.event_time;
+    last_bucket = index;
+    bucket_top = (last_time / bucket_width + 1) * bucket_width;
+
+    // shrink the calendar if buckets get sparse,
+    // or re-estimate the bucket width if it doesn't match the spacing of pending entries anymore
+    if (buckets.size() > min_buckets_count && 2 * events_count < buckets.size()) {
+        resize(buckets.size() / 2);
+    } else if (searched_directly) {
+        resize(buckets.size());
+    }
+
+    return event;
+}
+
+EventTime CalendarQueueScheduler::peek_time() const noexcept {
+    assert(!empty());
+
+    auto searched_directly = false;
+    const auto& bucket = buckets[find_earliest_bucket(searched_directly)];
+    return bucket.events[bucket.head].event_time;
+}
+
+const ScheduledEvent& CalendarQueueScheduler::peek() const noexcept {
+    assert(!empty());
+
+    auto searched_directly = false;
+    const auto& bucket = buckets[find_earliest_bucket(searched_directly)];
+    return bucket.events[bucket.head];
+}
+
+void CalendarQueueScheduler::reset(const EventTime time) noexcept {
+    assert(empty());
+
+    // move the day of the last popped entry to the given time
+    last_time = time;
+    last_bucket = (last_time / bucket_width) % buckets.size();
+    bucket_top = (last_time / bucket_width + 1) * bucket_width;
+}
+
+size_t CalendarQueueScheduler::find_earliest_bucket(bool& searched_directly) const noexcept {
+    assert(!empty());
+
+    // scan a year of days, starting from the day of the last popped entry
+    auto index = last_bucket;
+    auto top = bucket_top;
+    for (auto i = size_t{0}; i < buckets.size(); i++) {
+        const auto& bucket = buckets[index];
+        if (bucket.head < bucket.events.size() && bucket.events[bucket.head].event_time < top) {
+            return index;
+        }
+
+        // move to the next day
+        index = (index + 1 == buckets.size()) ? 0 : index + 1;
+        top += bucket_width;
+    }
+
+    // no entry within a year, directly search the earliest one
+    searched_directly = true;
+    auto earliest = buckets.size();
+    for (auto i = size_t{0}; i < buckets.size(); i++) {
+        const auto& bucket = buckets[i];
+        if (bucket.head == bucket.events.size()) {
+            continue;
+        }
+        if (earliest == buckets.size() ||
+            precedes(bucket.events[bucket.head], buckets[earliest].events[buckets[earliest].head])) {
+            earliest = i;
+        }
+    }
+
+    assert(earliest < buckets.size());
+    return earliest;
+}
+
+void CalendarQueueScheduler::insert(ScheduledEvent event) noexcept {
+    const auto day = event.event_time / bucket_width;
+    auto& bucket = buckets[day % buckets.size()];
+    auto& events = bucket.events;
+
+    // usually, the entry is scheduled after the ones already in the bucket
+    if (bucket.head == events.size() || precedes(events.back(), event)) {
+        events.push_back(std::move(event));
+        return;
+    }
+
+    // otherwise, keep the bucket sorted
+    const auto head = static_cast<std::ptrdiff_t>(bucket.head);
+    const auto position = std::upper_bound(events.begin() + head, events.end(), event, precedes);
+    events.insert(position, std::move(event));
+}
+
+void CalendarQueueScheduler::resize(const size_t new_buckets_count) noexcept {
+    assert(new_buckets_count >= min_buckets_count);
+
+    // collect pending entries
+    resize_buffer.clear();
+    for (auto& bucket : buckets) {
+        const auto head = static_cast<std::ptrdiff_t>(bucket.head);
+        std::move(bucket.events.begin() + head, bucket.events.end(), std::back_inserter(resize_buffer));
+        bucket.events.clear();
+        bucket.head = 0;
+    }
+
+    // rebuild the calendar
+    bucket_width = estimate_bucket_width();
+    buckets.resize(new_buckets_count);
+    last_bucket = (last_time / bucket_width) % new_buckets_count;
+    bucket_top = (last_time / bucket_width + 1) * bucket_width;
+
+    // re-insert pending entries
+    for (auto& event : resize_buffer) {
+        insert(std::move(event));
+    }
+    resize_buffer.clear();
+}
+
+EventTime CalendarQueueScheduler::estimate_bucket_width() noexcept {
+    const auto samples_count = std::min(resize_buffer.size(), width_samples_count);
+    if (samples_count < 2) {
+        return 1;
+    }
+
+    // sample the earliest entries
+    width_samples.clear();
+    for (const auto& event : resize_buffer) {
+        width_samples.push_back(event.event_time);
+    }
+    const auto samples_end = width_samples.begin() + static_cast<std::ptrdiff_t>(samples_count);
+    std::partial_sort(width_samples.begin(), samples_end, width_samples.end());
+
+    // average spacing of the samples
+    const auto total_spacing = width_samples[samples_count - 1] - width_samples[0];
+    const auto average = static_cast<double>(total_spacing) / static_cast<double>(samples_count - 1);
+
+    // recompute the average, ignoring outliers (spacing larger than twice the average)
+    auto spacing_sum = 0.0;
+    auto spacing_count = 0;
+    for (auto i = size_t{1}; i < samples_count; i++) {
+        const auto spacing = static_cast<double>(width_samples[i] - width_samples[i - 1]);
+        if (spacing <= 2 * average) {
+            spacing_sum += spacing;
+            spacing_count++;
+        }
+    }
+    const auto refined_average = (spacing_count > 0) ? (spacing_sum / spacing_count) : average;
+
+    // bucket width is three times the average spacing
+    const auto width = static_cast<EventTime>(3 * refined_average);
+    return std::max(width, EventTime{1});
+}
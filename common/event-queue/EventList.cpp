@@ -12,24 +12,29 @@ EventList::EventList(const EventTime event_time) noexcept : event_time(event_tim
     assert(event_time >= 0);
 
     // create an empty event list
-    events = std::list<Event>();
+    slots = std::vector<EventSlot>();
 }
 
 EventTime EventList::get_event_time() const noexcept {
     return event_time;
 }
 
-void EventList::add_event(const Callback callback, const CallbackArg callback_arg) noexcept {
-    assert(callback != nullptr);
-
+void EventList::add_event(const EventSlot slot) noexcept {
     // add the event to the event list
-    events.emplace_back(callback, callback_arg);
+    slots.push_back(slot);
+}
+
+uint64_t EventList::invoke_events(EventStore& event_store) noexcept {
+    // no typed handler to dispatch directly
+    return invoke_events<>(event_store);
+}
+
+void EventList::reset(const EventTime new_event_time) noexcept {
+    // drop events, keeping the storage
+    slots.clear();
+    event_time = new_event_time;
 }
 
-void EventList::invoke_events() noexcept {
-    // invoke all events in the event list
-    while (!events.empty()) {
-        events.front().invoke_event();
-        events.pop_front();
-    }
+bool EventList::empty() const noexcept {
+    return slots.empty();
 }
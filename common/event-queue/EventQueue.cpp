@@ -76,41 +76,149 @@ void EventQueue::schedule_event(const EventTime event_time,
 
 using namespace NetworkAnalytical;
 
-EventQueue::EventQueue() noexcept : current_time(0) {}
+EventQueue::EventQueue(const SchedulingPolicy scheduling_policy) noexcept
+    : current_time(0),
+      next_sequence(0),
+      processed_events_count(0),
+      cancelled_events_count(0),
+      tombstones_count(0),
+      scheduling_policy(scheduling_policy),
+      current_events(0) {
+    // create the scheduler of the given policy
+    scheduler = EventScheduler::create(scheduling_policy);
+}
 
 EventTime EventQueue::get_current_time() const noexcept {
     return current_time;
 }
 
+void EventQueue::set_current_time(const EventTime time) noexcept {
+    assert(finished());
+
+    // drop the tombstones left, then move the time base of the scheduler along,
+    // as it takes no entry earlier than the last popped one
+    while (!scheduler->empty()) {
+        event_store.release(scheduler->pop().slot);
+    }
+    tombstones_count = 0;
+    scheduler->reset(time);
+
+    current_time = time;
+}
+
 bool EventQueue::finished() const noexcept {
-    return event_queue.empty();
+    // tombstones are not pending events
+    return scheduler->size() == tombstones_count;
 }
 
-void EventQueue::proceed() noexcept {
-    // Ensure there are events to process
+EventTime EventQueue::peek_next_time() const noexcept {
     assert(!finished());
 
-    // Get the top event list
-    auto current_event_list = event_queue.top();
-    event_queue.pop();
+    return scheduler->peek_time();
+}
 
-    // Update the current time
-    assert(current_event_list->get_event_time() > current_time);
-    current_time = current_event_list->get_event_time();
+uint64_t EventQueue::get_processed_events_count() const noexcept {
+    return processed_events_count;
+}
 
-    // Invoke the events
-    current_event_list->invoke_events();
+SchedulingPolicy EventQueue::get_scheduling_policy() const noexcept {
+    return scheduling_policy;
 }
 
-void EventQueue::schedule_event(const EventTime event_time,
-                                 const Callback callback,
-                                 const CallbackArg callback_arg) noexcept {
+EventQueueStats EventQueue::get_stats() const noexcept {
+    const auto entries_count = static_cast<uint64_t>(scheduler->size());
+
+    auto stats = EventQueueStats();
+    stats.processed_events_count = processed_events_count;
+    stats.cancelled_events_count = cancelled_events_count;
+    stats.pending_events_count = entries_count - tombstones_count;
+    stats.tombstones_count = tombstones_count;
+    stats.tombstone_ratio =
+        (entries_count > 0) ? static_cast<double>(tombstones_count) / static_cast<double>(entries_count) : 0.0;
+    return stats;
+}
+
+void EventQueue::proceed() noexcept {
+    // no typed handler to dispatch directly
+    proceed<>();
+}
+
+EventHandle EventQueue::schedule_event(const EventTime event_time,
+                                       const Callback callback,
+                                       const CallbackArg callback_arg) noexcept {
     assert(event_time >= current_time);
+    assert(callback != nullptr);
 
-    // Create or reuse an EventList
-    auto event_list = std::make_shared<EventList>(event_time);
-    event_list->add_event(callback, callback_arg);
+    // Store the event record
+    const auto sequence = next_sequence;
+    const auto slot = event_store.allocate({event_time, sequence, callback, callback_arg, 0, false});
+    next_sequence++;
+
+    // Push the event into the scheduler
+    scheduler->push({event_time, sequence, slot});
+    return event_store.get_handle(slot);
+}
+
+bool EventQueue::is_pending(const EventHandle handle) const noexcept {
+    return event_store.is_pending(handle);
+}
+
+bool EventQueue::cancel(const EventHandle handle) noexcept {
+    if (!event_store.is_pending(handle)) {
+        return false;
+    }
+
+    // an event gathered into the current batch is dropped once the batch reaches it
+    const auto gathered = event_store.get(handle.slot).gathered;
+    event_store.cancel(handle.slot);
+    cancelled_events_count++;
+    if (gathered) {
+        return true;
+    }
+
+    // otherwise, leave a tombstone, dropped once it reaches the front of the scheduler
+    tombstones_count++;
+
+    // drop it right away if it's at the front at the current time
+    drop_cancelled_events(current_time);
+    return true;
+}
+
+bool EventQueue::reschedule(EventHandle& handle, const EventTime new_time) noexcept {
+    assert(new_time >= current_time);
+
+    // stale handles are ignored, as the slot may hold nothing or another event
+    if (!event_store.is_pending(handle)) {
+        return false;
+    }
+
+    // cancel the event and schedule it again
+    const auto record = event_store.get(handle.slot);
+    cancel(handle);
+    handle = schedule_event(new_time, record.callback, record.callback_arg);
+    return true;
+}
 
-    // Push the new event list into the priority queue
-    event_queue.push(event_list);
+uint64_t EventQueue::gather_current_events(const uint64_t max_events_count) noexcept {
+    assert(max_events_count > 0);
+
+    // gather the events of the current time into a batch
+    current_events.reset(current_time);
+    auto gathered_events_count = uint64_t{0};
+    do {
+        // the slot is kept until the event is invoked, so that it can still be cancelled
+        const auto scheduled_event = scheduler->pop();
+        if (!event_store.is_cancelled(scheduled_event.slot)) {
+            event_store.gather(scheduled_event.slot);
+            current_events.add_event(scheduled_event.slot);
+            gathered_events_count++;
+        } else {
+            // drop the tombstone of a cancelled event
+            event_store.release(scheduled_event.slot);
+            tombstones_count--;
+        }
+    } while (gathered_events_count < max_events_count && !scheduler->empty() &&
+             scheduler->peek_time() == current_time);
+
+    return gathered_events_count;
 }
@@ -0,0 +1,41 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventScheduler.h"
+#include "common/BinaryHeapScheduler.h"
+#include "common/CalendarQueueScheduler.h"
+#include "common/TimingWheelScheduler.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+
+EventScheduler::EventScheduler() noexcept : events_count(0) {}
+
+// default destructor
+EventScheduler::~EventScheduler() noexcept = default;
+
+bool EventScheduler::empty() const noexcept {
+    return events_count == 0;
+}
+
+size_t EventScheduler::size() const noexcept {
+    return events_count;
+}
+
+std::unique_ptr<EventScheduler> EventScheduler::create(const SchedulingPolicy scheduling_policy) noexcept {
+    switch (scheduling_policy) {
+    case SchedulingPolicy::BinaryHeap:
+        return std::make_unique<BinaryHeapScheduler>();
+    case SchedulingPolicy::CalendarQueue:
+        return std::make_unique<CalendarQueueScheduler>();
+    case SchedulingPolicy::TimingWheel:
+        return std::make_unique<TimingWheelScheduler>();
+    default:
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical) " << "not supported scheduling policy" << std::endl;
+        std::exit(-1);
+    }
+}
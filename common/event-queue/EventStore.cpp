@@ -0,0 +1,18 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventStore.h"
+
+using namespace NetworkAnalytical;
+
+EventStore::EventStore() noexcept {
+    // create an empty slab
+    records = std::vector<EventRecord>();
+    free_slots = std::vector<EventSlot>();
+}
+
+size_t EventStore::get_capacity() const noexcept {
+    return records.size();
+}
@@ -0,0 +1,213 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/TimingWheelScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+TimingWheelScheduler::TimingWheelScheduler() noexcept : EventScheduler(), wheel_time(0), drained_count(0) {
+    // every slot is empty
+    for (auto& level_occupancy : occupancy) {
+        level_occupancy.fill(0);
+    }
+
+    // create an empty overflow heap
+    overflow = std::vector<ScheduledEvent>();
+}
+
+void TimingWheelScheduler::push(ScheduledEvent event) noexcept {
+    // entries cannot be scheduled before the cursor
+    assert(event.event_time >= wheel_time);
+
+    place(std::move(event));
+    events_count++;
+}
+
+ScheduledEvent TimingWheelScheduler::pop() noexcept {
+    assert(!empty());
+
+    // move the cursor to the earliest entry
+    advance();
+
+    // take the next entry of the level 0 slot under the cursor
+    const auto index = slot_index(wheel_time, 0);
+    auto& slot = slots[0][index];
+    auto event = std::move(slot[drained_count]);
+    drained_count++;
+    events_count--;
+
+    // the slot is drained
+    if (drained_count == slot.size()) {
+        slot.clear();
+        clear_occupied(0, index);
+        drained_count = 0;
+    }
+
+    return event;
+}
+
+EventTime TimingWheelScheduler::peek_time() const noexcept {
+    assert(!empty());
+
+    // level 0 slots hold a single event time each
+    const auto index = find_occupied_slot(0, slot_index(wheel_time, 0));
+    if (index < slots_count) {
+        return (wheel_time & ~static_cast<EventTime>(slots_count - 1)) | static_cast<EventTime>(index);
+    }
+
+    // entries of lower levels always precede the ones of higher levels,
+    // so the earliest entry is in the first occupied slot of the lowest non-empty level
+    for (auto level = 1; level < levels_count; level++) {
+        const auto next = find_occupied_slot(level, slot_index(wheel_time, level) + 1);
+        if (next < slots_count) {
+            const auto& slot = slots[level][next];
+            auto earliest_time = slot.front().event_time;
+            for (const auto& event : slot) {
+                earliest_time = std::min(earliest_time, event.event_time);
+            }
+            return earliest_time;
+        }
+    }
+
+    // the wheel is empty
+    assert(!overflow.empty());
+    return overflow.front().event_time;
+}
+
+const ScheduledEvent& TimingWheelScheduler::peek() const noexcept {
+    assert(!empty());
+
+    // level 0 slots hold a single event time each, in the scheduled order
+    // (the slot under the cursor may be partially drained)
+    const auto cursor_index = slot_index(wheel_time, 0);
+    const auto index = find_occupied_slot(0, cursor_index);
+    if (index < slots_count) {
+        const auto& slot = slots[0][index];
+        return (index == cursor_index) ? slot[drained_count] : slot.front();
+    }
+
+    // otherwise, the earliest entry of the first occupied slot of the lowest non-empty level
+    for (auto level = 1; level < levels_count; level++) {
+        const auto next = find_occupied_slot(level, slot_index(wheel_time, level) + 1);
+        if (next < slots_count) {
+            const auto& slot = slots[level][next];
+            return *std::min_element(slot.begin(), slot.end(), precedes);
+        }
+    }
+
+    // the wheel is empty
+    assert(!overflow.empty());
+    return overflow.front();
+}
+
+void TimingWheelScheduler::reset(const EventTime time) noexcept {
+    assert(empty());
+    assert(drained_count == 0);
+
+    // every slot is empty, so the cursor can move anywhere
+    wheel_time = time;
+}
+
+void TimingWheelScheduler::place(ScheduledEvent event) noexcept {
+    // find the lowest level whose slot window contains both the entry and the cursor
+    const auto difference = event.event_time ^ wheel_time;
+    for (auto level = 0; level < levels_count; level++) {
+        if ((difference >> ((level + 1) * slot_bits)) == 0) {
+            const auto index = slot_index(event.event_time, level);
+            slots[level][index].push_back(std::move(event));
+            set_occupied(level, index);
+            return;
+        }
+    }
+
+    // beyond the range of the wheel
+    overflow.push_back(std::move(event));
+    std::push_heap(overflow.begin(), overflow.end(), follows);
+}
+
+void TimingWheelScheduler::advance() noexcept {
+    assert(!empty());
+
+    while (true) {
+        // earliest occupied level 0 slot at or after the cursor
+        const auto index = find_occupied_slot(0, slot_index(wheel_time, 0));
+        if (index < slots_count) {
+            wheel_time = (wheel_time & ~static_cast<EventTime>(slots_count - 1)) | static_cast<EventTime>(index);
+            return;
+        }
+
+        // level 0 is empty: cascade the next occupied slot of the lowest non-empty level
+        auto cascaded = false;
+        for (auto level = 1; level < levels_count && !cascaded; level++) {
+            const auto next = find_occupied_slot(level, slot_index(wheel_time, level) + 1);
+            if (next == slots_count) {
+                continue;
+            }
+
+            // move the cursor to the beginning of the slot
+            const auto shift = level * slot_bits;
+            const auto upper_mask = ~((EventTime{1} << (shift + slot_bits)) - 1);
+            wheel_time = (wheel_time & upper_mask) | (static_cast<EventTime>(next) << shift);
+
+            // re-distribute the entries of the slot to the lower levels
+            cascade_buffer.swap(slots[level][next]);
+            clear_occupied(level, next);
+            for (auto& event : cascade_buffer) {
+                place(std::move(event));
+            }
+            cascade_buffer.clear();
+            cascaded = true;
+        }
+        if (cascaded) {
+            continue;
+        }
+
+        // the wheel is empty: move the cursor to the earliest overflown entry
+        // and bring every overflown entry within the range of the wheel
+        assert(!overflow.empty());
+        wheel_time = overflow.front().event_time;
+        while (!overflow.empty() && ((overflow.front().event_time ^ wheel_time) >> (levels_count * slot_bits)) == 0) {
+            std::pop_heap(overflow.begin(), overflow.end(), follows);
+            place(std::move(overflow.back()));
+            overflow.pop_back();
+        }
+    }
+}
+
+int TimingWheelScheduler::find_occupied_slot(const int level, const int from) const noexcept {
+    assert(0 <= level && level < levels_count);
+    assert(from >= 0);
+
+    if (from >= slots_count) {
+        return slots_count;
+    }
+
+    // check the bitmap word by word
+    auto word = from / 64;
+    auto bits = occupancy[level][word] & (~uint64_t{0} << (from % 64));
+    while (bits == 0) {
+        word++;
+        if (word == occupancy_words) {
+            return slots_count;
+        }
+        bits = occupancy[level][word];
+    }
+
+    return word * 64 + __builtin_ctzll(bits);
+}
+
+int TimingWheelScheduler::slot_index(const EventTime event_time, const int level) noexcept {
+    return static_cast<int>((event_time >> (level * slot_bits)) & (slots_count - 1));
+}
+
+void TimingWheelScheduler::set_occupied(const int level, const int index) noexcept {
+    occupancy[level][index / 64] |= (uint64_t{1} << (index % 64));
+}
+
+void TimingWheelScheduler::clear_occupied(const int level, const int index) noexcept {
+    occupancy[level][index / 64] &= ~(uint64_t{1} << (index % 64));
+}
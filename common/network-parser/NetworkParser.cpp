@@ -9,7 +9,9 @@ LICENSE file in the root directory of this source tree.
 
 using namespace NetworkAnalytical;
 
-NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1) {
+NetworkParser::NetworkParser(const std::string& path) noexcept
+    : dims_count(-1),
+      scheduling_policy(SchedulingPolicy::BinaryHeap) {
     // initialize values
     npus_count_per_dim = {};
     bandwidth_per_dim = {};
@@ -63,6 +65,10 @@ std::vector<TopologyBuildingBlock> NetworkParser::get_topologies_per_dim() const
     return topology_per_dim;
 }
 
+SchedulingPolicy NetworkParser::get_scheduling_policy() const noexcept {
+    return scheduling_policy;
+}
+
 void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) noexcept {
     // parse topology_per_dim
     const auto topology_names = parse_vector<std::string>(network_config["topology"]);
@@ -79,6 +85,18 @@ void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) n
     bandwidth_per_dim = parse_vector<Bandwidth>(network_config["bandwidth"]);
     latency_per_dim = parse_vector<Latency>(network_config["latency"]);
 
+    // parse optional scheduling_policy
+    if (network_config["scheduling_policy"]) {
+        try {
+            const auto scheduling_policy_name = network_config["scheduling_policy"].as<std::string>();
+            scheduling_policy = NetworkParser::parse_scheduling_policy_name(scheduling_policy_name);
+        } catch (const YAML::BadConversion& e) {
+            // error reading scheduling_policy as a string
+            std::cerr << "[Error] (network/analytical) " << e.what() << std::endl;
+            std::exit(-1);
+        }
+    }
+
     // check the validity of the parsed network config
     check_validity();
 }
@@ -103,6 +121,27 @@ TopologyBuildingBlock NetworkParser::parse_topology_name(const std::string& topo
     std::exit(-1);
 }
 
+SchedulingPolicy NetworkParser::parse_scheduling_policy_name(const std::string& scheduling_policy_name) noexcept {
+    assert(!scheduling_policy_name.empty());
+
+    if (scheduling_policy_name == "BinaryHeap") {
+        return SchedulingPolicy::BinaryHeap;
+    }
+
+    if (scheduling_policy_name == "CalendarQueue") {
+        return SchedulingPolicy::CalendarQueue;
+    }
+
+    if (scheduling_policy_name == "TimingWheel") {
+        return SchedulingPolicy::TimingWheel;
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical) " << "Scheduling policy " << scheduling_policy_name << " not supported"
+              << std::endl;
+    std::exit(-1);
+}
+
 void NetworkParser::check_validity() const noexcept {
     // dims_count should match
     if (dims_count != npus_count_per_dim.size()) {
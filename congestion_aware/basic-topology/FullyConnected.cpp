@@ -17,14 +17,10 @@ FullyConnected::FullyConnected(const int npus_count, const Bandwidth bandwidth,
     // set topology type
     basic_topology_type = TopologyBuildingBlock::FullyConnected;
 
-    // fully-connect every src-dest pairs
-    for (auto src = 0; src < npus_count; src++) {
-        for (auto dest = 0; dest < npus_count; dest++) {
-            if (src != dest) {
-                connect(src, dest, bandwidth, latency, false);
-            }
-        }
-    }
+    // fully-connect every src-dest pairs,
+    // instantiating the links on their first use as most workloads touch only a fraction of them
+    build_links();
+    connect_fully(0, npus_count - 1, bandwidth, latency);
 }
 
 Route FullyConnected::route(const DeviceId src, const DeviceId dest) const noexcept {
@@ -35,8 +31,18 @@ Route FullyConnected::route(const DeviceId src, const DeviceId dest) const noexc
     // construct route
     // directly connected
     auto route = Route();
-    route.push_back(devices[src]);
-    route.push_back(devices[dest]);
+    route.push_back(src);
+    route.push_back(dest);
 
     return route;
 }
+
+DeviceId FullyConnected::next_hop(const DeviceId current, const DeviceId dest) const noexcept {
+    // assert npus are in valid range
+    assert(0 <= current && current < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(current != dest);
+
+    // directly connected
+    return dest;
+}
@@ -19,7 +19,11 @@ Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latenc
     for (auto i = 0; i < npus_count - 1; i++) {
         connect(i, i + 1, bandwidth, latency, bidirectional);
     }
-    connect(npus_count - 1, 0, bandwidth, latency, bidirectional);
+    // close the ring (a bidirectional ring of 2 NPUs is closed already)
+    if (!bidirectional || npus_count > 2) {
+        connect(npus_count - 1, 0, bandwidth, latency, bidirectional);
+    }
+    build_links();
 }
 
 Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
@@ -31,25 +35,30 @@ Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
     auto route = Route();
 
     auto step = 1;  // default direction: clockwise
+    auto clockwise_dist = dest - src;
+    if (clockwise_dist < 0) {
+        clockwise_dist += npus_count;
+    }
+    auto dist = clockwise_dist;
     if (bidirectional) {
         // check whether going anticlockwise is shorter
-        auto clockwise_dist = dest - src;
-        if (clockwise_dist < 0) {
-            clockwise_dist += npus_count;
-        }
         const auto anticlockwise_dist = npus_count - clockwise_dist;
 
         if (anticlockwise_dist < clockwise_dist) {
             // traverse the ring anticlockwise
             step = -1;
+            dist = anticlockwise_dist;
         }
     }
 
+    // the route holds the src and every device up to the dest
+    route.reserve(dist + 1);
+
     // construct the route
     auto current = src;
     while (current != dest) {
         // traverse the ring until reaches dest
-        route.push_back(devices[current]);
+        route.push_back(current);
         current = (current + step);
 
         // wrap around
@@ -61,8 +70,29 @@ Route Ring::route(DeviceId src, DeviceId dest) const noexcept {
     }
 
     // arrives at dest
-    route.push_back(devices[dest]);
+    route.push_back(dest);
 
     // return the constructed route
     return route;
 }
+
+DeviceId Ring::next_hop(const DeviceId current, const DeviceId dest) const noexcept {
+    // assert npus are in valid range
+    assert(0 <= current && current < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(current != dest);
+
+    // step clockwise, unless going anticlockwise is shorter
+    // (the same decision route() makes, so that every device on the way keeps the direction)
+    auto clockwise_dist = dest - current;
+    if (clockwise_dist < 0) {
+        clockwise_dist += npus_count;
+    }
+    const auto anticlockwise = bidirectional && (npus_count - clockwise_dist < clockwise_dist);
+
+    // wrap around
+    if (anticlockwise) {
+        return (current == 0) ? npus_count - 1 : current - 1;
+    }
+    return (current == npus_count - 1) ? 0 : current + 1;
+}
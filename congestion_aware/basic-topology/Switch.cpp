@@ -23,6 +23,7 @@ Switch::Switch(const int npus_count, const Bandwidth bandwidth, const Latency la
     for (auto i = 0; i < npus_count; i++) {
         connect(i, switch_id, bandwidth, latency, true);
     }
+    build_links();
 }
 
 Route Switch::route(DeviceId src, DeviceId dest) const noexcept {
@@ -33,9 +34,19 @@ Route Switch::route(DeviceId src, DeviceId dest) const noexcept {
     // construct route
     // start at source, and go to switch, then go to destination
     auto route = Route();
-    route.push_back(devices[src]);
-    route.push_back(devices[switch_id]);
-    route.push_back(devices[dest]);
+    route.push_back(src);
+    route.push_back(switch_id);
+    route.push_back(dest);
 
     return route;
 }
+
+DeviceId Switch::next_hop(const DeviceId current, const DeviceId dest) const noexcept {
+    // assert devices are in valid range
+    assert(0 <= current && current < devices_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(current != dest);
+
+    // go to switch, then go to destination
+    return (current == switch_id) ? dest : switch_id;
+}
@@ -24,11 +24,11 @@ void chunk_arrived_callback(void* const event_queue_ptr) {
 int main() {
     // Instantiate shared resources
     const auto event_queue = std::make_shared<EventQueue>();
-    Topology::set_event_queue(event_queue);
 
     // Parse network config and create topology
     const auto network_parser = NetworkParser("../input/Ring.yml");
     const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
     const auto npus_count = topology->get_npus_count();
     const auto devices_count = topology->get_devices_count();
 
@@ -156,10 +156,10 @@ void process_reduction(int node_id, EventQueue* event_queue) {
 
 int main() {
     const auto event_queue = std::make_shared<EventQueue>();
-    Topology::set_event_queue(event_queue);
 
     const auto network_parser = NetworkParser("../input/FullyConnected.yml");
     topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
     const auto npus_count = topology->get_npus_count();
     const auto devices_count = topology->get_devices_count();
 
@@ -257,11 +257,10 @@ void trigger_all_gather_for_chunk(int node_id, int chunk_id, EventQueue* event_q
     for (int dest = 0; dest < node_buffers.size(); dest++) {
         if (dest == node_id) continue;
 
-        auto route = topology->route(node_id, dest);
         auto* event_queue_ptr = static_cast<void*>(event_queue);
 
-        auto chunk = std::make_unique<Chunk>(
-            chunk_size, route, all_gather_chunk_arrived_callback, event_queue_ptr);
+        auto chunk = topology->make_chunk(
+            chunk_size, node_id, dest, all_gather_chunk_arrived_callback, event_queue_ptr);
         chunk->data = node_buffers[node_id][chunk_id]; // Assign reduced chunk value to chunk
 
         std::cout << "[All-Gather] Sending chunk " << chunk_id
@@ -304,11 +303,10 @@ void process_reduction(int node_id, int chunk_id, EventQueue* event_queue) {
 
 
 int main() {
-    const auto event_queue = std::make_shared<EventQueue>();
-    Topology::set_event_queue(event_queue);
-
     const auto network_parser = NetworkParser("../input/FullyConnected.yml");
+
     topology = construct_topology(network_parser);
+    const auto event_queue = topology->get_event_queue();
     const auto npus_count = topology->get_npus_count();
     const auto devices_count = topology->get_devices_count();
 
@@ -326,10 +324,9 @@ int main() {
             if (i == j) continue;
 
             for (int chunk_id = 0; chunk_id < chunks_per_packet; chunk_id++) {
-                auto route = topology->route(i, j);
                 auto* event_queue_ptr = static_cast<void*>(event_queue.get());
 
-                auto chunk = std::make_unique<Chunk>(chunk_size, route, chunk_arrived_callback, event_queue_ptr);
+                auto chunk = topology->make_chunk(chunk_size, i, j, chunk_arrived_callback, event_queue_ptr);
 
                 std::cout << "[Reduce-Scatter] Sending chunk " << chunk_id
                           << " from Node " << i
@@ -343,7 +340,7 @@ int main() {
     }
 
     while (!event_queue->finished()) {
-        event_queue->proceed();
+        Topology::proceed(*event_queue);
     }
 
     const auto finish_time = event_queue->get_current_time();
@@ -351,5 +348,10 @@ int main() {
     std::cout << "Total devices Count: " << devices_count << std::endl;
     std::cout << "Simulation finished at time: " << finish_time << " ns" << std::endl;
 
+    const auto chunk_pool_stats = topology->get_chunk_pool_stats();
+    std::cout << "Chunks allocated: " << chunk_pool_stats.chunks_allocated
+              << " (peak alive: " << chunk_pool_stats.peak_chunks_alive
+              << ", heap allocations: " << chunk_pool_stats.heap_allocations << ")" << std::endl;
+
     return 0;
 }
@@ -0,0 +1,223 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/MultiDimTopology.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+MultiDimTopology::MultiDimTopology() noexcept : Topology() {
+    // initialize values
+    topology_per_dim.clear();
+    npus_count_per_dim = {};
+
+    // initialize topology shape
+    npus_count = 1;
+    devices_count = 0;
+    dims_count = 0;
+}
+
+void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> basic_topology) noexcept {
+    assert(basic_topology != nullptr);
+
+    // devices shouldn't be instantiated yet
+    assert(devices.empty());
+
+    // increment dims_count
+    dims_count++;
+
+    // increase npus_count
+    const auto topology_size = basic_topology->get_npus_count();
+    stride_per_dim.push_back(npus_count);
+    npus_count *= topology_size;
+
+    // append bandwidth
+    const auto bandwidth = basic_topology->get_bandwidth_per_dim()[0];
+    bandwidth_per_dim.push_back(bandwidth);
+
+    // push back topology and npus_count
+    topology_per_dim.push_back(std::move(basic_topology));
+    npus_count_per_dim.push_back(topology_size);
+}
+
+void MultiDimTopology::build() noexcept {
+    assert(dims_count > 0);
+    assert(devices.empty());
+
+    // non-NPU devices of each dimension follow the NPUs
+    devices_count = npus_count;
+    auto links_count = size_t{0};
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto* const topology = topology_per_dim[dim].get();
+        const auto instances_count = npus_count / npus_count_per_dim[dim];
+        const auto non_npus_count = topology->get_devices_count() - topology->get_npus_count();
+
+        non_npus_offset_per_dim.push_back(devices_count);
+        devices_count += instances_count * non_npus_count;
+        links_count += static_cast<size_t>(instances_count) * topology->get_connections().size();
+    }
+    instantiate_devices();
+
+    // replicate the connections of each dimension's topology to every instance
+    reserve_links(links_count);
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto* const topology = topology_per_dim[dim].get();
+        const auto connections = topology->get_connections();
+        const auto bandwidth = bandwidth_per_dim[dim];
+        const auto latency = topology->get_latency();
+        const auto instances_count = npus_count / npus_count_per_dim[dim];
+
+        for (auto instance = 0; instance < instances_count; instance++) {
+            for (const auto& [src, dest] : connections) {
+                connect(translate_device(dim, instance, src), translate_device(dim, instance, dest), bandwidth,
+                        latency, false);
+            }
+        }
+    }
+    build_links();
+}
+
+Route MultiDimTopology::route(const DeviceId src, const DeviceId dest) const noexcept {
+    // assert npus are in valid range
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    // translate src and dest to multi-dim address
+    const auto src_address = translate_address(src);
+    const auto dest_address = translate_address(dest);
+
+    // construct route
+    auto route = Route();
+    route.push_back(src);
+
+    // traverse each dimension whose address differs, in dimension order
+    auto current = src;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        if (src_address[dim] == dest_address[dim]) {
+            continue;
+        }
+
+        // route within the dimension's instance the current NPU belongs to
+        const auto instance = get_instance(dim, current);
+        const auto local_route = topology_per_dim[dim]->route(src_address[dim], dest_address[dim]);
+        for (auto i = size_t{1}; i < local_route.size(); i++) {
+            route.push_back(translate_device(dim, instance, local_route[i]));
+        }
+
+        // the chunk arrives at the NPU with the dest address in this dimension
+        current += (dest_address[dim] - src_address[dim]) * stride_per_dim[dim];
+        assert(route.back() == current);
+    }
+
+    return route;
+}
+
+DeviceId MultiDimTopology::next_hop(const DeviceId current, const DeviceId dest) const noexcept {
+    // assert devices are in valid range
+    assert(0 <= current && current < devices_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(current != dest);
+
+    // a non-NPU device: keep routing within the dimension's instance it belongs to
+    if (current >= npus_count) {
+        auto dim = dims_count - 1;
+        while (current < non_npus_offset_per_dim[dim]) {
+            dim--;
+        }
+        assert(dim >= 0);
+
+        const auto* const topology = topology_per_dim[dim].get();
+        const auto non_npus_count = topology->get_devices_count() - npus_count_per_dim[dim];
+        const auto instance = (current - non_npus_offset_per_dim[dim]) / non_npus_count;
+        const auto local_id = npus_count_per_dim[dim] + (current - non_npus_offset_per_dim[dim]) % non_npus_count;
+        const auto local_next = topology->next_hop(local_id, get_address(dim, dest));
+        return translate_device(dim, instance, local_next);
+    }
+
+    // an NPU: route within the lowest dimension whose address differs
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto current_address = get_address(dim, current);
+        const auto dest_address = get_address(dim, dest);
+        if (current_address != dest_address) {
+            const auto local_next = topology_per_dim[dim]->next_hop(current_address, dest_address);
+            return translate_device(dim, get_instance(dim, current), local_next);
+        }
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_aware): " << "current and dest have the same address"
+              << std::endl;
+    std::exit(-1);
+}
+
+MultiDimTopology::MultiDimAddress MultiDimTopology::translate_address(const DeviceId npu_id) const noexcept {
+    // If units-count if [2, 8, 4], and the given id is 47, then the id should be
+    // 47 // 16 = 2, leftover = 47 % 16 = 15
+    // 15 // 2 = 7, leftover = 15 % 2 = 1
+    // 1 // 1 = 1, leftover = 0
+    // therefore the address is [1, 7, 2]
+
+    // create empty address
+    auto multi_dim_address = MultiDimAddress(dims_count, -1);
+
+    auto leftover = npu_id;
+    for (auto dim = dims_count - 1; dim >= 0; dim--) {
+        // get and update address
+        multi_dim_address[dim] = leftover / stride_per_dim[dim];
+        leftover %= stride_per_dim[dim];
+    }
+
+    // check address translation
+    for (auto i = 0; i < dims_count; i++) {
+        assert(0 <= multi_dim_address[i]);
+        assert(multi_dim_address[i] < npus_count_per_dim[i]);
+    }
+
+    // return retrieved address
+    return multi_dim_address;
+}
+
+DeviceId MultiDimTopology::get_address(const int dim, const DeviceId npu_id) const noexcept {
+    assert(0 <= dim && dim < dims_count);
+    assert(0 <= npu_id && npu_id < npus_count);
+
+    return (npu_id / stride_per_dim[dim]) % npus_count_per_dim[dim];
+}
+
+int MultiDimTopology::get_instance(const int dim, const DeviceId npu_id) const noexcept {
+    assert(0 <= dim && dim < dims_count);
+    assert(0 <= npu_id && npu_id < npus_count);
+
+    // drop the address of the given dimension
+    // e.g., for [2, 8, 4] and dim 1, NPU 31 ([1, 7, 1]) belongs to instance 3 ([1, 1])
+    const auto stride = stride_per_dim[dim];
+    const auto higher_dims = npu_id / (stride * npus_count_per_dim[dim]);
+    const auto lower_dims = npu_id % stride;
+    return higher_dims * stride + lower_dims;
+}
+
+DeviceId MultiDimTopology::translate_device(const int dim, const int instance, const DeviceId local_id) const noexcept {
+    assert(0 <= dim && dim < dims_count);
+    assert(0 <= local_id);
+
+    const auto* const topology = topology_per_dim[dim].get();
+    const auto topology_size = npus_count_per_dim[dim];
+    const auto stride = stride_per_dim[dim];
+
+    // non-NPU devices of each instance are laid out contiguously
+    if (local_id >= topology_size) {
+        const auto non_npus_count = topology->get_devices_count() - topology_size;
+        assert(local_id - topology_size < non_npus_count);
+        return non_npus_offset_per_dim[dim] + instance * non_npus_count + (local_id - topology_size);
+    }
+
+    // NPU: restore the dropped address of the given dimension
+    const auto higher_dims = instance / stride;
+    const auto lower_dims = instance % stride;
+    return (higher_dims * topology_size + local_id) * stride + lower_dims;
+}
@@ -4,17 +4,19 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkPool.h"
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Link.h"
+#include "congestion_aware/Topology.h"
 #include <cassert>
 
 using namespace NetworkAnalyticalCongestionAware;
 
-void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
+void Chunk::chunk_arrived_next_device(Chunk* const chunk_ptr) noexcept {
     assert(chunk_ptr != nullptr);
 
-    // cast to unique_ptr<Chunk>
-    auto chunk = std::unique_ptr<Chunk>(static_cast<Chunk*>(chunk_ptr));
+    // take over the ownership of the chunk
+    auto chunk = std::unique_ptr<Chunk>(chunk_ptr);
 
     // mark chunk arrived next node
     chunk->mark_arrived_next_device();
@@ -25,55 +27,142 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
         chunk->invoke_callback();
     } else {
         // send this chunk to next dest
-        const auto current_node = chunk->current_device();
+        auto* const current_node = chunk->get_topology()->get_device(chunk->current_device());
         current_node->send(std::move(chunk));  // send chunk to next des
     }
 }
 
+void* Chunk::operator new(const size_t size) {
+    // allocate the header and the chunk together
+    auto* const header = static_cast<ChunkHeader*>(::operator new(sizeof(ChunkHeader) + size));
+    header->pool = nullptr;
+    return header + 1;
+}
+
+void Chunk::operator delete(void* const ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    // release the storage to where it came from
+    auto* const header = static_cast<ChunkHeader*>(ptr) - 1;
+    if (header->pool != nullptr) {
+        header->pool->release(ptr);
+    } else {
+        ::operator delete(header);
+    }
+}
+
 Chunk::Chunk(const ChunkSize chunk_size, Route route, const Callback callback, const CallbackArg callback_arg) noexcept
     : chunk_size(chunk_size),
       route(std::move(route)),
+      routed(true),
+      topology(nullptr),
       callback(callback),
       callback_arg(callback_arg) {
     assert(chunk_size > 0);
     assert(!this->route.empty());
     assert(callback != nullptr);
 
+    // the route designates the devices
+    current_id = this->route.front();
+    dest_id = this->route.back();
+    update_next_device();
+
+    // Initialize the chunk's data to represent its contribution
+    data = 1; // Each chunk starts with a value of 1 for reduction
+}
+
+Chunk::Chunk(const ChunkSize chunk_size,
+             const DeviceId src,
+             const DeviceId dest,
+             const Callback callback,
+             const CallbackArg callback_arg) noexcept
+    : chunk_size(chunk_size),
+      route(),
+      routed(false),
+      topology(nullptr),
+      callback(callback),
+      callback_arg(callback_arg),
+      current_id(src),
+      next_id(-1),
+      dest_id(dest) {
+    assert(chunk_size > 0);
+    assert(src >= 0);
+    assert(dest >= 0);
+    assert(callback != nullptr);
+
     // Initialize the chunk's data to represent its contribution
     data = 1; // Each chunk starts with a value of 1 for reduction
 }
 
-std::shared_ptr<Device> Chunk::current_device() const noexcept {
-    // assert the route is not empty
+void Chunk::set_topology(Topology* const topology_ptr) noexcept {
+    assert(topology_ptr != nullptr);
+
+    topology = topology_ptr;
+
+    // a routeless chunk asks the topology for the next hop
+    if (!routed) {
+        update_next_device();
+    }
+}
+
+Topology* Chunk::get_topology() const noexcept {
+    assert(topology != nullptr);
+
+    return topology;
+}
+
+bool Chunk::is_routed() const noexcept {
+    return routed;
+}
+
+const Route& Chunk::get_route() const noexcept {
+    // assert the chunk is routed
+    assert(routed);
     assert(!route.empty());
 
-    // return the first npu in route
-    return route.front();
+    return route;
 }
 
-std::shared_ptr<Device> Chunk::next_device() const noexcept {
-    // assert the chunk has next dest
-    assert(!arrived_dest());
+ChunkCursor Chunk::get_cursor() const noexcept {
+    return {current_id, next_id, routed ? route.get_cursor() : 0};
+}
+
+void Chunk::set_cursor(const ChunkCursor& cursor) noexcept {
+    assert(cursor.current_id >= 0);
 
-    // return next dest
-    const auto next_dest = std::next(route.begin(), 1);
-    return *next_dest;
+    current_id = cursor.current_id;
+    next_id = cursor.next_id;
+    if (routed) {
+        route.set_cursor(cursor.route_cursor);
+        assert(route.front() == current_id);
+    }
 }
 
 void Chunk::mark_arrived_next_device() noexcept {
     // if this method is being called,
     // it means the chunk hasn't arrived its final dest yet
     assert(!arrived_dest());
+    assert(next_id >= 0);
 
     // pop previous node from the route
     // marking the current node has been changed
-    route.pop_front();
+    if (routed) {
+        route.pop_front();
+    }
+    current_id = next_id;
+    update_next_device();
 }
 
-bool Chunk::arrived_dest() const noexcept {
-    // if a chunk arrived dest, route length should be 1
-    // i.e., only containing the dest node
-    return route.size() == 1;
+void Chunk::update_next_device() noexcept {
+    if (arrived_dest()) {
+        next_id = -1;
+    } else if (routed) {
+        next_id = route[1];
+    } else {
+        next_id = topology->next_hop(current_id, dest_id);
+    }
 }
 
 ChunkSize Chunk::get_size() const noexcept {
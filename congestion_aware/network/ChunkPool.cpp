@@ -0,0 +1,83 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ChunkPool.h"
+#include "congestion_aware/Chunk.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+struct ChunkPool::ChunkSlot {
+    /// header telling the owning pool
+    ChunkHeader header;
+
+    /// storage of the chunk
+    alignas(Chunk) unsigned char storage[sizeof(Chunk)];
+};
+
+// the storage should follow its header directly
+static_assert(alignof(Chunk) <= alignof(ChunkHeader));
+static_assert(sizeof(ChunkHeader) % alignof(ChunkHeader) == 0);
+
+ChunkPool::ChunkPool() noexcept : blocks(), free_list(nullptr), stats({0, 0, 0, 0}) {}
+
+ChunkPool::~ChunkPool() noexcept {
+    // chunks shouldn't outlive the pool
+    assert(stats.chunks_alive == 0);
+}
+
+void* ChunkPool::allocate() noexcept {
+    // grow the pool if every storage is in use
+    if (free_list == nullptr) {
+        grow();
+    }
+
+    // pop a storage from the free list
+    auto* const storage = free_list;
+    free_list = *static_cast<void**>(storage);
+
+    // update counters
+    stats.chunks_allocated++;
+    stats.chunks_alive++;
+    stats.peak_chunks_alive = std::max(stats.peak_chunks_alive, stats.chunks_alive);
+
+    return storage;
+}
+
+void ChunkPool::release(void* const storage) noexcept {
+    assert(storage != nullptr);
+    assert(stats.chunks_alive > 0);
+
+    // push the storage to the free list
+    *static_cast<void**>(storage) = free_list;
+    free_list = storage;
+
+    stats.chunks_alive--;
+}
+
+ChunkPoolStats ChunkPool::get_stats() const noexcept {
+    return stats;
+}
+
+void ChunkPool::grow() noexcept {
+    assert(free_list == nullptr);
+
+    // allocate a new block
+    blocks.push_back(std::make_unique<ChunkSlot[]>(chunks_per_block));
+    stats.heap_allocations++;
+
+    // link every storage of the block, so that they're handed out in order
+    auto* const block = blocks.back().get();
+    for (auto i = chunks_per_block; i > 0; i--) {
+        auto& slot = block[i - 1];
+        assert(static_cast<void*>(slot.storage) == static_cast<void*>(&slot.header + 1));
+
+        slot.header.pool = this;
+        *reinterpret_cast<void**>(slot.storage) = free_list;
+        free_list = slot.storage;
+    }
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ChunkQueue.h"
+#include <cassert>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+ChunkQueue::ChunkQueue() noexcept : buffer(nullptr), capacity(0), head(0), count(0) {}
+
+ChunkQueue::~ChunkQueue() noexcept {
+    // destroy the chunks left
+    while (!empty()) {
+        delete buffer[head];
+        head = (head + 1) & (capacity - 1);
+        count--;
+    }
+}
+
+ChunkQueue::ChunkQueue(ChunkQueue&& other) noexcept
+    : buffer(std::move(other.buffer)),
+      capacity(other.capacity),
+      head(other.head),
+      count(other.count) {
+    // the other queue is left empty
+    other.capacity = 0;
+    other.head = 0;
+    other.count = 0;
+}
+
+void ChunkQueue::grow() noexcept {
+    assert(count == capacity);
+
+    // start small, as most links never queue many chunks
+    const auto new_capacity = (capacity == 0) ? uint32_t{4} : capacity * 2;
+    assert(new_capacity > capacity);
+
+    // move the chunks to the front of the new buffer
+    auto new_buffer = std::make_unique<Chunk*[]>(new_capacity);
+    for (auto i = uint32_t{0}; i < count; i++) {
+        new_buffer[i] = buffer[(head + i) & (capacity - 1)];
+    }
+
+    buffer = std::move(new_buffer);
+    capacity = new_capacity;
+    head = 0;
+}
@@ -5,13 +5,27 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/FusedTransmission.h"
 #include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationContext.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Device::Device(const DeviceId id) noexcept : device_id(id) {
+Device::Device(const DeviceId id, SimulationContext* const context) noexcept
+    : device_id(id),
+      context(context),
+      links(nullptr),
+      links_dests(nullptr),
+      links_count(0),
+      dense_links(false),
+      implicit_links_parameters(nullptr),
+      implicit_first_dest(-1),
+      implicit_last_dest(-1),
+      implicit_links() {
     assert(id >= 0);
+    assert(context != nullptr);
 }
 
 DeviceId Device::get_id() const noexcept {
@@ -25,38 +39,150 @@ void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     // assert this node is the current source of the chunk
-    assert(chunk->current_device()->get_id() == device_id);
+    assert(chunk->current_device() == device_id);
 
     // assert the chunk hasn't arrived its final destination yet
     assert(!chunk->arrived_dest());
 
+    // reserve the whole remaining route at once if no other chunk interferes
+    if (context->is_route_fusion_enabled() && FusedTransmission::try_send(chunk)) {
+        return;
+    }
+
     // get next dest
-    const auto next_dest = chunk->next_device();
-    const auto next_dest_id = next_dest->get_id();
+    const auto next_dest_id = chunk->next_device();
 
     // assert the next dest is connected to this node
     assert(connected(next_dest_id));
 
     // send the chunk to the next dest
     // delegate this task to the link
-    links[next_dest_id]->send(std::move(chunk));
+    get_link(next_dest_id)->send(std::move(chunk));
 }
 
-void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency latency) noexcept {
-    assert(id >= 0);
-    assert(bandwidth > 0);
-    assert(latency >= 0);
+void Device::set_links(Link* const links, const DeviceId* const dests, const int links_count) noexcept {
+    assert(links_count >= 0);
+    assert(links_count == 0 || (links != nullptr && dests != nullptr));
+    assert(std::is_sorted(dests, dests + links_count));
+
+    this->links = links;
+    this->links_dests = dests;
+    this->links_count = links_count;
+
+    // check whether the dests are contiguous, skipping this device itself
+    if (links_count == 0) {
+        dense_links = false;
+        return;
+    }
+    const auto dests_range = links_dests[links_count - 1] - links_dests[0] + 1;
+    const auto self_in_range = (links_dests[0] < device_id && device_id < links_dests[links_count - 1]);
+    dense_links = (links_count == dests_range - (self_in_range ? 1 : 0));
+}
+
+void Device::set_implicit_links(const DeviceId first_dest,
+                                const DeviceId last_dest,
+                                const LinkParameters* const parameters) noexcept {
+    assert(0 <= first_dest && first_dest <= last_dest);
+    assert(parameters != nullptr);
+    assert(links_count == 0);
+
+    implicit_first_dest = first_dest;
+    implicit_last_dest = last_dest;
+    implicit_links_parameters = parameters;
+}
+
+Link* Device::get_link(const DeviceId dest) noexcept {
+    assert(dest >= 0);
+
+    // assert the connection exists
+    assert(connected(dest));
+
+    // implicit links: instantiate the link on its first use
+    if (implicit_links_parameters != nullptr) {
+        auto link = implicit_links.find(dest);
+        if (link == implicit_links.end()) {
+            const auto id = context->get_link_store().add_link(implicit_links_parameters);
+            link = implicit_links.try_emplace(dest, context, id).first;
+        }
+        return &link->second;
+    }
+
+    return &links[link_index(dest)];
+}
+
+const Link* Device::find_link(const DeviceId dest) const noexcept {
+    assert(dest >= 0);
 
-    // assert there's no existing connection
-    assert(!connected(id));
+    // assert the connection exists
+    assert(connected(dest));
 
-    // create link
-    links[id] = std::make_shared<Link>(bandwidth, latency);
+    // implicit links: the link may not be instantiated yet
+    if (implicit_links_parameters != nullptr) {
+        const auto link = implicit_links.find(dest);
+        return (link == implicit_links.end()) ? nullptr : &link->second;
+    }
+
+    return &links[link_index(dest)];
+}
+
+const LinkParameters& Device::get_link_parameters(const DeviceId dest) const noexcept {
+    assert(dest >= 0);
+
+    // assert the connection exists
+    assert(connected(dest));
+
+    // implicit links share their parameters
+    if (implicit_links_parameters != nullptr) {
+        return *implicit_links_parameters;
+    }
+
+    return context->get_link_store().parameters(links[link_index(dest)].get_id());
+}
+
+std::vector<DeviceId> Device::get_links_dests() const noexcept {
+    // links in the table
+    if (implicit_links_parameters == nullptr) {
+        return {links_dests, links_dests + links_count};
+    }
+
+    // implicit links, skipping this device itself
+    auto dests = std::vector<DeviceId>();
+    dests.reserve(implicit_last_dest - implicit_first_dest + 1);
+    for (auto dest = implicit_first_dest; dest <= implicit_last_dest; dest++) {
+        if (dest != device_id) {
+            dests.push_back(dest);
+        }
+    }
+    return dests;
+}
+
+int Device::link_index(const DeviceId dest) const noexcept {
+    assert(dest >= 0);
+
+    // dense links: the index is the offset of dest, skipping this device itself
+    if (dense_links) {
+        if (dest < links_dests[0] || dest > links_dests[links_count - 1] || dest == device_id) {
+            return links_count;
+        }
+        return dest - links_dests[0] - ((dest > device_id && links_dests[0] < device_id) ? 1 : 0);
+    }
+
+    // sparse links: binary search the dest
+    const auto* const position = std::lower_bound(links_dests, links_dests + links_count, dest);
+    if (position == links_dests + links_count || *position != dest) {
+        return links_count;
+    }
+    return static_cast<int>(position - links_dests);
 }
 
 bool Device::connected(const DeviceId dest) const noexcept {
     assert(dest >= 0);
 
+    // implicit links: check whether dest is in the range
+    if (implicit_links_parameters != nullptr) {
+        return implicit_first_dest <= dest && dest <= implicit_last_dest && dest != device_id;
+    }
+
     // check whether the connection exists
-    return links.find(dest) != links.end();
+    return link_index(dest) < links_count;
 }
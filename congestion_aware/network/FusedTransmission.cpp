@@ -0,0 +1,136 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/FusedTransmission.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Topology.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+bool FusedTransmission::try_send(std::unique_ptr<Chunk>& chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // a single hop takes a single event anyway
+    const auto dest = chunk->dest_device();
+    if (chunk->next_device() == dest) {
+        return false;
+    }
+
+    // walk through the remaining route, checking every link is available when the chunk reaches it
+    const auto chunk_size = chunk->get_size();
+    auto hops = std::vector<Hop>();
+    if (chunk->is_routed()) {
+        hops.reserve(chunk->get_route().size() - 1);
+    }
+    const auto* const topology = chunk->get_topology();
+    auto* const context = topology->get_context();
+    assert(context->is_route_fusion_enabled());
+    assert(context->get_partition() == nullptr);
+    auto start = context->get_event_queue()->get_current_time();
+    auto current = chunk->current_device();
+    auto next = chunk->next_device();
+    while (true) {
+        auto* const link = topology->get_device(current)->get_link(next);
+        const auto end = start + link->serialization_delay(chunk_size);
+        if (!link->available(start, end)) {
+            return false;
+        }
+
+        const auto arrival = start + link->communication_delay(chunk_size);
+        hops.push_back({link, start, end, arrival});
+        start = arrival;
+
+        // move on to the next hop, following the route if carried
+        if (next == dest) {
+            break;
+        }
+        current = next;
+        next = chunk->is_routed() ? chunk->get_route()[hops.size() + 1] : topology->next_hop(current, dest);
+    }
+
+    // reserve the links
+    const auto arrival_time = hops.back().arrival;
+    auto* const transmission = new FusedTransmission(context, std::move(chunk), std::move(hops));
+    for (const auto& hop : transmission->hops) {
+        hop.link->reserve(hop.start, hop.end, transmission);
+    }
+
+    // the first link starts serializing the chunk right away
+    transmission->hops.front().link->update_reservations();
+
+    // schedule the final arrival, kept to be cancelled on falling back
+    transmission->arrival_event =
+        context->schedule_event<&FusedTransmission::chunk_arrived_dest>(arrival_time, transmission);
+    return true;
+}
+
+void FusedTransmission::chunk_arrived_dest(FusedTransmission* const transmission) noexcept {
+    assert(transmission != nullptr);
+
+    // take over the transmission
+    auto fused_transmission = std::unique_ptr<FusedTransmission>(transmission);
+    assert(fused_transmission->chunk != nullptr);
+
+    // every reservation has started
+    for (const auto& hop : fused_transmission->hops) {
+        hop.link->update_reservations();
+    }
+
+    // move the chunk to its destination
+    auto chunk = std::move(fused_transmission->chunk);
+    while (!chunk->arrived_dest()) {
+        chunk->mark_arrived_next_device();
+    }
+
+    // chunk arrived dest, invoke callback
+    chunk->invoke_callback();
+}
+
+void FusedTransmission::fall_back() noexcept {
+    assert(chunk != nullptr);
+
+    // cancel reservations which haven't started yet
+    const auto current_time = context->get_event_queue()->get_current_time();
+    for (const auto& hop : hops) {
+        if (hop.start > current_time) {
+            hop.link->cancel_reservations(this);
+        }
+    }
+
+    // find the hop the chunk is on, i.e., the last started one
+    auto current_hop = size_t{0};
+    while (current_hop + 1 < hops.size() && hops[current_hop + 1].start <= current_time) {
+        current_hop++;
+    }
+    for (auto i = size_t{0}; i < current_hop; i++) {
+        chunk->mark_arrived_next_device();
+    }
+
+    // continue hop-by-hop from the next device
+    const auto arrival_time = hops[current_hop].arrival;
+    context->schedule_event<&Chunk::chunk_arrived_next_device>(arrival_time, chunk.release());
+
+    // the final arrival won't happen, and the transmission is over
+    [[maybe_unused]] const auto cancelled = context->get_event_queue()->cancel(arrival_event);
+    assert(cancelled);
+    delete this;
+}
+
+FusedTransmission::FusedTransmission(SimulationContext* const context,
+                                     std::unique_ptr<Chunk> chunk,
+                                     std::vector<Hop> hops) noexcept
+    : context(context),
+      chunk(std::move(chunk)),
+      hops(std::move(hops)),
+      arrival_event(invalid_event_handle) {
+    assert(this->context != nullptr);
+    assert(this->chunk != nullptr);
+    assert(!this->hops.empty());
+}
@@ -4,68 +4,55 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Link.h"
-#include "common/NetworkFunction.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/FusedTransmission.h"
+#include "congestion_aware/SimulationContext.h"
+#include <algorithm>
 #include <cassert>
-#include <iostream>
+#include <iterator>
+#include <limits>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
-// declaring static event_queue
-std::shared_ptr<EventQueue> Link::event_queue;
-
-void Link::link_become_free(void* const link_ptr) noexcept {
-    assert(link_ptr != nullptr);
-
-    // cast to Link*
-    auto* const link = static_cast<Link*>(link_ptr);
-
-    // set link free
-    link->set_free();
-
-    // process pending chunks if one exist
-    if (link->pending_chunk_exists()) {
-        link->process_pending_transmission();
-    }
+Link::Link(SimulationContext* const context, const LinkId id) noexcept : context(context), id(id) {
+    assert(context != nullptr);
+    assert(id < context->get_link_store().size());
 }
 
-void Link::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
-    assert(event_queue_ptr != nullptr);
-
-    // set the event queue
-    Link::event_queue = std::move(event_queue_ptr);
-}
-
-Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
-    : bandwidth(bandwidth),
-      latency(latency),
-      pending_chunks(),
-      busy(false) {
-    assert(bandwidth > 0);
-    assert(latency >= 0);
-
-    // convert bandwidth from GB/s to B/ns
-    bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
-
-    // Debug: Log initialization
-        /*
-    std::cout << "[DEBUG] Link initialized with bandwidth: " << bandwidth
-              << " GB/s (" << bandwidth_Bpns << " B/ns)"
-              << ", latency: " << latency << " ns." << std::endl;
-        */
+LinkId Link::get_id() const noexcept {
+    return id;
 }
 
 void Link::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
-    if (busy) {
-        // link is busy, add to pending chunks
-        pending_chunks.push_back(std::move(chunk));
-    } else {
-        // service this chunk immediately
+    // started reservations keep the link busy
+    update_reservations();
+
+    if (!busy() && !pending_chunk_exists()) {
+        // link is free, service this chunk immediately
         schedule_chunk_transmission(std::move(chunk));
+        return;
+    }
+
+    // pending chunks are served before any chunk reaching the link later:
+    // fused transmissions reserving the link fall back to hop-by-hop
+    resolve_conflicts(std::numeric_limits<EventTime>::max());
+
+    // link is busy, add to pending chunks
+    auto& pending_chunks = context->get_link_store().pending_chunks(id);
+    auto& queue_counters = context->get_link_store().queue_counters(id);
+    update_queued_time(context->get_event_queue()->get_current_time());
+    pending_chunks.push_back(std::move(chunk));
+    queue_counters.queued_chunks_count++;
+    queue_counters.peak_pending_chunks =
+        std::max(queue_counters.peak_pending_chunks, static_cast<uint32_t>(pending_chunks.size()));
+
+    // the first pending chunk wakes the link up when it becomes free
+    if (pending_chunks.size() == 1) {
+        schedule_link_free();
     }
 }
 
@@ -73,34 +60,134 @@ void Link::process_pending_transmission() noexcept {
     // pending chunk should exist
     assert(pending_chunk_exists());
 
+    // started reservations keep the link busy:
+    // wake up again once they are over
+    update_reservations();
+    if (busy()) {
+        schedule_link_free();
+        return;
+    }
+
     // get chunk to process
-    auto chunk = std::move(pending_chunks.front());
-    pending_chunks.pop_front();
+    update_queued_time(context->get_event_queue()->get_current_time());
+    auto chunk = context->get_link_store().pending_chunks(id).pop_front();
 
     // service this chunk
     schedule_chunk_transmission(std::move(chunk));
+
+    // keep processing the remaining pending chunks
+    if (pending_chunk_exists()) {
+        schedule_link_free();
+    }
 }
 
 bool Link::pending_chunk_exists() const noexcept {
     // check pending chunks is not empty
-    return !pending_chunks.empty();
+    return !context->get_link_store().pending_chunks(id).empty();
 }
 
-void Link::set_busy() noexcept {
-    // set busy to true
-    busy = true;
+LinkStats Link::get_stats() const noexcept {
+    // account the chunks still pending up to the current time
+    auto& link_store = context->get_link_store();
+    const auto& queue_counters = link_store.queue_counters(id);
+    const auto current_time = context->get_event_queue()->get_current_time();
+    assert(current_time >= queue_counters.last_queue_update);
+    const auto pending_chunks_count = link_store.pending_chunks(id).size();
+    const auto total_queued_time =
+        queue_counters.queued_time + pending_chunks_count * (current_time - queue_counters.last_queue_update);
+
+    auto stats = LinkStats();
+    stats.peak_pending_chunks = queue_counters.peak_pending_chunks;
+    stats.queued_chunks_count = queue_counters.queued_chunks_count;
+    stats.total_queued_time = total_queued_time;
+    stats.average_pending_chunks =
+        (current_time > 0) ? static_cast<double>(total_queued_time) / static_cast<double>(current_time) : 0.0;
+    return stats;
 }
 
-void Link::set_free() noexcept {
-    // set busy to false
-    busy = false;
+bool Link::busy() const noexcept {
+    // link is busy until the last scheduled chunk is serialized
+    return context->get_event_queue()->get_current_time() < context->get_link_store().busy_until(id);
+}
+
+bool Link::available(const EventTime start, const EventTime end) const noexcept {
+    assert(start >= context->get_event_queue()->get_current_time());
+    assert(start <= end);
+
+    // pending chunks would be served first
+    auto& link_store = context->get_link_store();
+    if (pending_chunk_exists() || link_store.busy_until(id) > start) {
+        return false;
+    }
+
+    // check overlapping reservations
+    for (const auto& reservation : link_store.reservations(id)) {
+        if (reservation.start >= end) {
+            break;
+        }
+        if (reservation.end > start) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Link::reserve(const EventTime start, const EventTime end, FusedTransmission* const owner) noexcept {
+    assert(owner != nullptr);
+    assert(available(start, end));
+
+    // keep reservations sorted by start time
+    auto& reservations = context->get_link_store().reservations(id);
+    auto position = reservations.end();
+    while (position != reservations.begin() && std::prev(position)->start > start) {
+        position--;
+    }
+    reservations.insert(position, {start, end, owner});
+    context->get_link_store().reservations_count()++;
+}
+
+void Link::cancel_reservations(const FusedTransmission* const owner) noexcept {
+    assert(owner != nullptr);
+
+    // drop the reservations of the owner which haven't started yet
+    auto& link_store = context->get_link_store();
+    auto& reservations = link_store.reservations(id);
+    const auto current_time = context->get_event_queue()->get_current_time();
+    const auto cancelled = [owner, current_time](const LinkReservation& reservation) {
+        return reservation.owner == owner && reservation.start > current_time;
+    };
+    const auto remaining = std::remove_if(reservations.begin(), reservations.end(), cancelled);
+    link_store.reservations_count() -= std::distance(remaining, reservations.end());
+    reservations.erase(remaining, reservations.end());
+}
+
+void Link::update_reservations() noexcept {
+    // no link has reservations (i.e., the common case without route fusion)
+    auto& link_store = context->get_link_store();
+    if (link_store.reservations_count() == 0) {
+        return;
+    }
+
+    // merge started reservations into busy_until
+    auto& reservations = link_store.reservations(id);
+    auto& busy_until = link_store.busy_until(id);
+    const auto current_time = context->get_event_queue()->get_current_time();
+    auto started = reservations.begin();
+    while (started != reservations.end() && started->start <= current_time) {
+        busy_until = std::max(busy_until, started->end);
+        started++;
+    }
+    link_store.reservations_count() -= std::distance(reservations.begin(), started);
+    reservations.erase(reservations.begin(), started);
 }
 
 EventTime Link::serialization_delay(const ChunkSize chunk_size) const noexcept {
     assert(chunk_size > 0);
 
     // calculate serialization delay
-    const auto delay = static_cast<Bandwidth>(chunk_size) / bandwidth_Bpns;
+    const auto& parameters = context->get_link_store().parameters(id);
+    const auto delay = static_cast<Bandwidth>(chunk_size) * parameters.inverse_bandwidth_nspB;
 
     // return serialization delay in EventTime type
     return static_cast<EventTime>(delay);
@@ -110,7 +197,8 @@ EventTime Link::communication_delay(const ChunkSize chunk_size) const noexcept {
     assert(chunk_size > 0);
 
     // calculate communication delay
-    const auto delay = latency + (static_cast<Bandwidth>(chunk_size) / bandwidth_Bpns);
+    const auto& parameters = context->get_link_store().parameters(id);
+    const auto delay = parameters.latency + (static_cast<Bandwidth>(chunk_size) * parameters.inverse_bandwidth_nspB);
 
     // return communication delay in EventTime type
     return static_cast<EventTime>(delay);
@@ -120,34 +208,57 @@ void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     // link should be free
-    assert(!busy);
-
-    // set link busy
-    set_busy();
+    assert(!busy());
 
     // get metadata
     const auto chunk_size = chunk->get_size();
-    const auto current_time = Link::event_queue->get_current_time();
+    const auto current_time = context->get_event_queue()->get_current_time();
+
+    // this chunk comes first, fused transmissions it would delay fall back to hop-by-hop
+    const auto serialization_time = serialization_delay(chunk_size);
+    resolve_conflicts(current_time + serialization_time);
 
     // schedule chunk arrival event
     const auto communication_time = communication_delay(chunk_size);
     const auto chunk_arrival_time = current_time + communication_time;
-    auto* const chunk_ptr = static_cast<void*>(chunk.release());
-    Link::event_queue->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
-
-    // Debug: Log delay and event scheduling
-    /*
-    std::cout << "[DEBUG] Scheduling chunk transmission:"
-              << " Current Time: " << current_time
-              << " Communication Delay: " << communication_time
-              << " Chunk Arrival Time: " << chunk_arrival_time << std::endl;
-    */
-    // schedule link free time
-    const auto serialization_time = serialization_delay(chunk_size);
-    const auto link_free_time = current_time + serialization_time;
-    auto* const link_ptr = static_cast<void*>(this);
-    Link::event_queue->schedule_event(link_free_time, link_become_free, link_ptr);
+    context->schedule_event<&Chunk::chunk_arrived_next_device>(chunk_arrival_time, chunk.release());
+
+    // link is busy until the chunk is serialized
+    context->get_link_store().busy_until(id) = current_time + serialization_time;
+}
+
+void Link::schedule_link_free() noexcept {
+    assert(pending_chunk_exists());
+
+    // link becomes free once the last scheduled chunk is serialized
+    const auto current_time = context->get_event_queue()->get_current_time();
+    const auto link_free_time = std::max(context->get_link_store().busy_until(id), current_time);
+    context->schedule_event<&Link::link_become_free>(link_free_time, this);
+}
+
+void Link::resolve_conflicts(const EventTime end) noexcept {
+    // no link has reservations (i.e., the common case without route fusion)
+    auto& link_store = context->get_link_store();
+    if (link_store.reservations_count() == 0) {
+        return;
+    }
+
+    // reservations starting before the end time conflict with it
+    auto& reservations = link_store.reservations(id);
+    while (!reservations.empty() && reservations.front().start < end) {
+        assert(reservations.front().start > context->get_event_queue()->get_current_time());
+
+        // cancels the reservations of the fused transmission, including this one
+        reservations.front().owner->fall_back();
+    }
+}
 
-    // Debug: Log link free time
-    //std::cout << "[DEBUG] Scheduling link free at time: " << link_free_time << std::endl;
+void Link::update_queued_time(const EventTime current_time) noexcept {
+    // every pending chunk has waited since the last update
+    auto& link_store = context->get_link_store();
+    auto& queue_counters = link_store.queue_counters(id);
+    assert(current_time >= queue_counters.last_queue_update);
+    queue_counters.queued_time +=
+        link_store.pending_chunks(id).size() * (current_time - queue_counters.last_queue_update);
+    queue_counters.last_queue_update = current_time;
 }
@@ -0,0 +1,41 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/LinkStore.h"
+#include <cassert>
+#include <limits>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+LinkStore::LinkStore() noexcept
+    : busy_until_per_link(),
+      pending_chunks_per_link(),
+      parameters_per_link(),
+      reservations_per_link(),
+      queue_counters_per_link(),
+      total_reservations_count(0) {}
+
+void LinkStore::reserve(const size_t links_count) noexcept {
+    busy_until_per_link.reserve(links_count);
+    pending_chunks_per_link.reserve(links_count);
+    parameters_per_link.reserve(links_count);
+    reservations_per_link.reserve(links_count);
+    queue_counters_per_link.reserve(links_count);
+}
+
+LinkId LinkStore::add_link(const LinkParameters* const parameters) noexcept {
+    assert(parameters != nullptr);
+    assert(size() < std::numeric_limits<LinkId>::max());
+
+    // a new link is free, with nothing pending
+    const auto id = static_cast<LinkId>(size());
+    busy_until_per_link.push_back(0);
+    pending_chunks_per_link.emplace_back();
+    parameters_per_link.push_back(parameters);
+    reservations_per_link.emplace_back();
+    queue_counters_per_link.push_back({0, 0, 0, 0});
+
+    return id;
+}
@@ -0,0 +1,28 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Route.h"
+
+using namespace NetworkAnalyticalCongestionAware;
+
+Route::Route() noexcept : inline_devices(), spilled_devices(), devices_count(0), cursor(0) {}
+
+void Route::reserve(const size_t devices_count) noexcept {
+    // short routes don't need any storage
+    if (devices_count > inline_capacity) {
+        spilled_devices.reserve(devices_count);
+    }
+}
+
+void Route::spill(const DeviceId device) noexcept {
+    assert(devices_count >= inline_capacity);
+
+    // move the inline devices into the heap buffer
+    if (devices_count == inline_capacity) {
+        spilled_devices.insert(spilled_devices.end(), inline_devices.begin(), inline_devices.end());
+    }
+
+    spilled_devices.push_back(device);
+}
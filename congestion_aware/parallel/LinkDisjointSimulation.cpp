@@ -0,0 +1,259 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/LinkDisjointSimulation.h"
+#include "congestion_aware/Helper.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/**
+ * Component being simulated by the calling thread.
+ */
+struct CurrentComponent {
+    /// simulation of the component, or nullptr if none is being simulated
+    const LinkDisjointSimulation* simulation;
+
+    /// id of the component
+    int component;
+
+    /// replica of the topology simulating the component
+    Topology* topology;
+};
+
+/// component being simulated by each thread, so that callbacks can send chunks within it
+thread_local CurrentComponent current_component = {nullptr, -1, nullptr};
+
+/**
+ * Find the root of the set of an element, halving the path on the way.
+ *
+ * @param parents parent of each element, the root being its own parent
+ * @param element element to look up
+ * @return root of the set
+ */
+int find_root(std::vector<int>& parents, int element) noexcept {
+    while (parents[element] != element) {
+        parents[element] = parents[parents[element]];
+        element = parents[element];
+    }
+    return element;
+}
+
+}  // namespace
+
+LinkDisjointSimulation::LinkDisjointSimulation(const NetworkParser& network_parser, const int threads_count) noexcept
+    : thread_pool(threads_count),
+      devices_count(0),
+      current_time(0),
+      running(false) {
+    assert(threads_count >= 0);
+
+    // construct a replica of the topology per worker
+    const auto workers_count = thread_pool.get_workers_count();
+    topologies.resize(workers_count);
+    thread_pool.parallel_for(workers_count, [&](const size_t worker, int) {
+        topologies[worker] = construct_topology(network_parser);
+    });
+
+    devices_count = topologies.front()->get_devices_count();
+}
+
+void LinkDisjointSimulation::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(0 <= chunk->current_device() && chunk->current_device() < devices_count);
+
+    // chunks sent before running are simulated by the next run
+    if (!running) {
+        pending_chunks.push_back(std::move(chunk));
+        return;
+    }
+
+    // otherwise, chunks are sent from the callbacks, within the component being simulated
+    if (current_component.simulation != this) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "a running link-disjoint simulation accepts chunks from the callbacks only" << std::endl;
+        std::exit(-1);
+    }
+    auto keys = std::vector<uint64_t>();
+    route_links(*current_component.topology, *chunk, keys);
+    for (const auto key : keys) {
+        const auto it = component_per_link.find(key);
+        if (it == component_per_link.end() || it->second != current_component.component) {
+            std::cerr << "[Error] (network/analytical/congestion_aware): "
+                      << "chunks sent from callbacks should stay within the links of their component" << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    current_component.topology->send(std::move(chunk));
+}
+
+void LinkDisjointSimulation::run() noexcept {
+    assert(!running);
+
+    // the links of each chunk are in the same component:
+    // union the links a chunk traverses, indexing the links in the order found
+    const auto& topology = *topologies.front();
+    const auto chunks_count = pending_chunks.size();
+    auto parents = std::vector<int>();
+    auto first_link_per_chunk = std::vector<int>(chunks_count, -1);
+    auto hops_per_chunk = std::vector<uint64_t>(chunks_count, 0);
+    auto keys = std::vector<uint64_t>();
+    component_per_link.clear();
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        keys.clear();
+        route_links(topology, *pending_chunks[i], keys);
+        hops_per_chunk[i] = keys.size();
+
+        for (const auto key : keys) {
+            const auto [it, inserted] = component_per_link.try_emplace(key, static_cast<int>(parents.size()));
+            if (inserted) {
+                parents.push_back(it->second);
+            }
+
+            if (first_link_per_chunk[i] < 0) {
+                first_link_per_chunk[i] = it->second;
+            } else {
+                const auto root = find_root(parents, it->second);
+                const auto first_root = find_root(parents, first_link_per_chunk[i]);
+                parents[root] = first_root;
+            }
+        }
+    }
+
+    // group the chunks into components, in the order of their first chunks sent
+    // (a chunk traversing no link makes its own component)
+    auto components = std::vector<Component>();
+    auto component_per_root = std::vector<int>(parents.size(), -1);
+    for (auto i = size_t{0}; i < chunks_count; i++) {
+        auto component = static_cast<int>(components.size());
+        if (first_link_per_chunk[i] >= 0) {
+            const auto root = find_root(parents, first_link_per_chunk[i]);
+            if (component_per_root[root] < 0) {
+                component_per_root[root] = component;
+            }
+            component = component_per_root[root];
+        }
+        if (component == static_cast<int>(components.size())) {
+            components.push_back({{}, 0});
+        }
+        components[component].chunks.push_back(std::move(pending_chunks[i]));
+        components[component].hops_count += hops_per_chunk[i];
+    }
+    pending_chunks.clear();
+    for (auto& [key, component] : component_per_link) {
+        component = component_per_root[find_root(parents, component)];
+    }
+
+    // simulate the largest components first, so that the small ones fill in the workers at the end
+    const auto components_count = components.size();
+    auto order = std::vector<size_t>(components_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const size_t lhs, const size_t rhs) {
+        return components[lhs].hops_count > components[rhs].hops_count;
+    });
+
+    // every component starts from the current time
+    for (const auto& replica : topologies) {
+        replica->get_event_queue()->set_current_time(current_time);
+    }
+
+    // simulate each component by itself, on the replica of the worker
+    running = true;
+    component_finish_times.assign(components_count, current_time);
+    thread_pool.parallel_for(components_count, [&](const size_t task, const int worker) {
+        const auto component = order[task];
+        auto& replica = *topologies[worker];
+        auto& event_queue = *replica.get_event_queue();
+        current_component = {this, static_cast<int>(component), &replica};
+
+        for (auto& chunk : components[component].chunks) {
+            replica.send(std::move(chunk));
+        }
+        while (!event_queue.finished()) {
+            Topology::proceed(event_queue);
+        }
+
+        // rewind the replica for the next component of the worker
+        // (which also rewinds the time base of the scheduler, e.g., the cursor of a timing wheel)
+        component_finish_times[component] = event_queue.get_current_time();
+        event_queue.set_current_time(current_time);
+        current_component = {nullptr, -1, nullptr};
+    });
+    running = false;
+
+    // the run ends once every component has finished
+    for (const auto finish_time : component_finish_times) {
+        current_time = std::max(current_time, finish_time);
+    }
+}
+
+EventTime LinkDisjointSimulation::get_current_time() const noexcept {
+    // in a callback, the time of the component invoking it
+    if (current_component.simulation == this) {
+        return current_component.topology->get_event_queue()->get_current_time();
+    }
+
+    return current_time;
+}
+
+int LinkDisjointSimulation::get_components_count() const noexcept {
+    return static_cast<int>(component_finish_times.size());
+}
+
+const std::vector<EventTime>& LinkDisjointSimulation::get_component_finish_times() const noexcept {
+    return component_finish_times;
+}
+
+uint64_t LinkDisjointSimulation::get_processed_events_count() const noexcept {
+    // sum up the events invoked by every replica
+    auto processed_events_count = uint64_t{0};
+    for (const auto& replica : topologies) {
+        processed_events_count += replica->get_event_queue()->get_processed_events_count();
+    }
+    return processed_events_count;
+}
+
+int LinkDisjointSimulation::get_npus_count() const noexcept {
+    return topologies.front()->get_npus_count();
+}
+
+uint64_t LinkDisjointSimulation::link_key(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < devices_count);
+    assert(0 <= dest && dest < devices_count);
+
+    // both directions share the key, so that chunks can be sent back the way they came
+    const auto [first, second] = std::minmax(src, dest);
+    return static_cast<uint64_t>(first) * static_cast<uint64_t>(devices_count) + static_cast<uint64_t>(second);
+}
+
+void LinkDisjointSimulation::route_links(const Topology& topology,
+                                         const Chunk& chunk,
+                                         std::vector<uint64_t>& keys) const noexcept {
+    // routed chunks carry their remaining route
+    if (chunk.is_routed()) {
+        const auto& route = chunk.get_route();
+        for (auto i = size_t{1}; i < route.size(); i++) {
+            keys.push_back(link_key(route[i - 1], route[i]));
+        }
+        return;
+    }
+
+    // routeless chunks follow the next hops
+    auto current = chunk.current_device();
+    const auto dest = chunk.dest_device();
+    while (current != dest) {
+        const auto next = topology.next_hop(current, dest);
+        keys.push_back(link_key(current, next));
+        current = next;
+    }
+}
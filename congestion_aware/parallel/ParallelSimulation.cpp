@@ -0,0 +1,249 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ParallelSimulation.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/Partition.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <tuple>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+ParallelSimulation::ParallelSimulation(const NetworkParser& network_parser, const int threads_count) noexcept
+    : thread_pool(threads_count),
+      lookahead(SimulationPartition::no_event_time),
+      roots_count(0),
+      next_rank(1),
+      windows_count(0),
+      parity(1),
+      started(false) {
+    assert(threads_count >= 0);
+
+    // construct a replica of the topology per partition
+    const auto partitions_count = thread_pool.get_workers_count();
+    auto topologies = std::vector<std::shared_ptr<Topology>>(partitions_count);
+    thread_pool.parallel_for(partitions_count, [&](const size_t partition, int) {
+        topologies[partition] = construct_topology(network_parser);
+    });
+
+    // split the devices into partitions
+    partition_per_device = Partition::split_devices(*topologies[0], partitions_count);
+
+    // create the partitions
+    for (auto partition = 0; partition < partitions_count; partition++) {
+        partitions.push_back(std::make_unique<SimulationPartition>(partition, std::move(topologies[partition]),
+                                                                   partition_per_device, partitions_count,
+                                                                   &roots_count));
+    }
+
+    lookahead = compute_lookahead();
+}
+
+void ParallelSimulation::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // chunks are sent before the simulation runs, or by the partition of the src device
+    const auto src = chunk->current_device();
+    assert(0 <= src && src < get_npus_count());
+    auto* const partition = partitions[partition_per_device[src]].get();
+    if (started && SimulationPartition::get_current() != partition) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "a running parallel simulation accepts chunks from the callbacks at their src devices only"
+                  << std::endl;
+        std::exit(-1);
+    }
+
+    partition->send(std::move(chunk));
+}
+
+void ParallelSimulation::run() noexcept {
+    // a simulation runs once, as the partitions end up at different times
+    if (started) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): " << "a parallel simulation runs only once"
+                  << std::endl;
+        std::exit(-1);
+    }
+    started = true;
+
+    const auto next_event_time = [this]() {
+        auto time = SimulationPartition::no_event_time;
+        for (const auto& partition : partitions) {
+            time = std::min(time, partition->get_next_event_time());
+        }
+        return time;
+    };
+
+    // each partition receives the events of the previous window, then processes the current one
+    auto window_end = EventTime{0};
+    const auto process_window = [this, &window_end](const size_t partition, int) {
+        partitions[partition]->receive(partitions, parity ^ 1);
+        partitions[partition]->process(window_end, parity);
+    };
+
+    // proceed window by window, starting each from the earliest event
+    auto window_start = next_event_time();
+    while (window_start != SimulationPartition::no_event_time) {
+        const auto remaining_time = SimulationPartition::no_event_time - window_start;
+        window_end = (lookahead < remaining_time) ? window_start + lookahead : SimulationPartition::no_event_time;
+        parity ^= 1;
+        thread_pool.parallel_for(partitions.size(), process_window);
+        rank_processed_events();
+        windows_count++;
+
+        window_start = next_event_time();
+    }
+}
+
+EventTime ParallelSimulation::get_current_time() const noexcept {
+    // in a callback, the time of the partition invoking it
+    const auto* const current_partition = SimulationPartition::get_current();
+    if (current_partition != nullptr) {
+        return current_partition->get_topology()->get_event_queue()->get_current_time();
+    }
+
+    // otherwise, the time of the last event of every partition
+    auto current_time = EventTime{0};
+    for (const auto& partition : partitions) {
+        current_time = std::max(current_time, partition->get_topology()->get_event_queue()->get_current_time());
+    }
+    return current_time;
+}
+
+int ParallelSimulation::get_partitions_count() const noexcept {
+    return static_cast<int>(partitions.size());
+}
+
+int ParallelSimulation::get_partition(const DeviceId device) const noexcept {
+    assert(0 <= device && device < partition_per_device.size());
+
+    return partition_per_device[device];
+}
+
+EventTime ParallelSimulation::get_lookahead() const noexcept {
+    return lookahead;
+}
+
+uint64_t ParallelSimulation::get_windows_count() const noexcept {
+    return windows_count;
+}
+
+uint64_t ParallelSimulation::get_processed_events_count() const noexcept {
+    auto processed_events_count = uint64_t{0};
+    for (const auto& partition : partitions) {
+        processed_events_count += partition->get_topology()->get_event_queue()->get_processed_events_count();
+    }
+    return processed_events_count;
+}
+
+LinkStats ParallelSimulation::get_link_stats(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < partition_per_device.size());
+
+    // the link is simulated by the partition of its src device
+    return partitions[partition_per_device[src]]->get_topology()->get_link_stats(src, dest);
+}
+
+int ParallelSimulation::get_npus_count() const noexcept {
+    return partitions.front()->get_topology()->get_npus_count();
+}
+
+EventTime ParallelSimulation::compute_lookahead() const noexcept {
+    // find the minimum latency of the links crossing partitions
+    const auto* const topology = partitions.front()->get_topology();
+    auto min_latency = std::numeric_limits<Latency>::infinity();
+    for (auto src = 0; src < topology->get_devices_count(); src++) {
+        const auto* const device = topology->get_device(src);
+        for (const auto dest : device->get_links_dests()) {
+            if (partition_per_device[src] != partition_per_device[dest]) {
+                min_latency = std::min(min_latency, device->get_link_parameters(dest).latency);
+            }
+        }
+    }
+
+    // a single partition (or disconnected ones) needs no synchronization
+    if (min_latency == std::numeric_limits<Latency>::infinity()) {
+        return SimulationPartition::no_event_time;
+    }
+
+    // chunks should take time to cross partitions, so that the partitions can proceed
+    const auto min_delay = static_cast<EventTime>(min_latency);
+    if (min_delay == 0) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "parallel simulation needs the links crossing partitions to have a latency of 1 ns or more"
+                  << std::endl;
+        std::exit(-1);
+    }
+    return min_delay;
+}
+
+void ParallelSimulation::rank_processed_events() noexcept {
+    // merge the processed events of the partitions, each already in the order of the sequential simulation
+    const auto partitions_count = static_cast<int>(partitions.size());
+    auto positions = std::vector<uint64_t>(partitions_count, 0);
+    auto heads = std::vector<int>();
+    for (auto partition = 0; partition < partitions_count; partition++) {
+        const auto processed_events_count = partitions[partition]->get_processed_events(parity).size();
+        partitions[partition]->get_ranks(parity).resize(processed_events_count);
+        if (processed_events_count > 0) {
+            heads.push_back(partition);
+        }
+    }
+
+    // keep the partition of the earliest event on the top of the heap
+    const auto later = [this, &positions](const int lhs, const int rhs) {
+        return precedes(rhs, positions[rhs], lhs, positions[lhs]);
+    };
+    std::make_heap(heads.begin(), heads.end(), later);
+    while (!heads.empty()) {
+        std::pop_heap(heads.begin(), heads.end(), later);
+        const auto partition = heads.back();
+        auto& ranks = partitions[partition]->get_ranks(parity);
+        ranks[positions[partition]] = next_rank;
+        next_rank++;
+        positions[partition]++;
+
+        if (positions[partition] < ranks.size()) {
+            std::push_heap(heads.begin(), heads.end(), later);
+        } else {
+            heads.pop_back();
+        }
+    }
+}
+
+bool ParallelSimulation::precedes(int lhs_partition, uint64_t lhs, int rhs_partition, uint64_t rhs) const noexcept {
+    assert(lhs_partition != rhs_partition);
+
+    while (true) {
+        const auto& lhs_event = partitions[lhs_partition]->get_processed_events(parity)[lhs];
+        const auto& rhs_event = partitions[rhs_partition]->get_processed_events(parity)[rhs];
+
+        // events are invoked in (event time, scheduled order)
+        if (lhs_event.event_time != rhs_event.event_time) {
+            return lhs_event.event_time < rhs_event.event_time;
+        }
+
+        // events scheduled by the events of previous windows are ordered by the ranks of their parents
+        const auto lhs_local = (lhs_event.origin.parent & SimulationPartition::local_parent_flag) != 0;
+        const auto rhs_local = (rhs_event.origin.parent & SimulationPartition::local_parent_flag) != 0;
+        if (!lhs_local && !rhs_local) {
+            return std::tie(lhs_event.origin.parent, lhs_event.origin.child_index) <
+                   std::tie(rhs_event.origin.parent, rhs_event.origin.child_index);
+        }
+
+        // events of previous windows have been invoked before any event of this window
+        if (lhs_local != rhs_local) {
+            return rhs_local;
+        }
+
+        // otherwise, events are ordered as their parents, which are of this window as well
+        lhs = lhs_event.origin.parent & ~SimulationPartition::local_parent_flag;
+        rhs = rhs_event.origin.parent & ~SimulationPartition::local_parent_flag;
+    }
+}
@@ -0,0 +1,29 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Partition.h"
+#include "congestion_aware/Topology.h"
+#include <cassert>
+#include <cstdint>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+std::vector<int> Partition::split_devices(const Topology& topology, const int partitions_count) noexcept {
+    assert(partitions_count > 0);
+
+    const auto npus_count = int64_t{topology.get_npus_count()};
+    const auto devices_count = int64_t{topology.get_devices_count()};
+    auto partition_per_device = std::vector<int>(devices_count);
+    for (auto device = int64_t{0}; device < devices_count; device++) {
+        if (device < npus_count) {
+            partition_per_device[device] = static_cast<int>(device * partitions_count / npus_count);
+        } else {
+            const auto others_count = devices_count - npus_count;
+            partition_per_device[device] = static_cast<int>((device - npus_count) * partitions_count / others_count);
+        }
+    }
+    return partition_per_device;
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/SimulationPartition.h"
+#include "common/EventHandler.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Link.h"
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// partition being processed by the calling thread
+thread_local SimulationPartition* current_partition = nullptr;
+
+/// tag of the chunk arrival events, which go to the partition of the device the chunk arrives at
+using ChunkArrival = EventHandler<&Chunk::chunk_arrived_next_device>;
+
+}  // namespace
+
+SimulationPartition* SimulationPartition::get_current() noexcept {
+    return current_partition;
+}
+
+void SimulationPartition::invoke_event(PendingEvent* const event) noexcept {
+    assert(event != nullptr);
+
+    // record the event, so that the events it schedules know their parent
+    auto* const partition = event->partition;
+    auto& processed_events = partition->processed_events[partition->parity];
+    partition->current_event = processed_events.size();
+    partition->children_count = 0;
+    processed_events.push_back({partition->event_queue->get_current_time(), event->origin});
+
+    // release the pending event before invoking it, so that the events it schedules can reuse the storage
+    const auto callback = event->callback;
+    const auto callback_arg = event->callback_arg;
+    partition->free_pending_events.push_back(event);
+
+    // dispatch the events of the network directly
+    EventDispatcher<&Link::link_become_free, &Chunk::chunk_arrived_next_device>::dispatch(callback, callback_arg);
+}
+
+SimulationPartition::SimulationPartition(const int id,
+                                         std::shared_ptr<Topology> topology,
+                                         const std::vector<int>& partition_per_device,
+                                         const int partitions_count,
+                                         uint64_t* const roots_count) noexcept
+    : id(id),
+      topology(std::move(topology)),
+      partition_per_device(partition_per_device),
+      roots_count(roots_count),
+      boundary_events_time{no_event_time, no_event_time},
+      window_end(0),
+      parity(1),
+      processing(false),
+      current_event(0),
+      children_count(0) {
+    assert(0 <= id && id < partitions_count);
+    assert(this->topology != nullptr);
+    assert(roots_count != nullptr);
+
+    // the topology schedules the events of the network through the partition
+    event_queue = this->topology->get_event_queue().get();
+    this->topology->get_context()->set_partition(this);
+
+    boundary_events[0].resize(partitions_count);
+    boundary_events[1].resize(partitions_count);
+}
+
+Topology* SimulationPartition::get_topology() const noexcept {
+    return topology.get();
+}
+
+void SimulationPartition::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(partition_per_device[chunk->current_device()] == id);
+
+    topology->send(std::move(chunk));
+}
+
+void SimulationPartition::schedule_event(const EventTime event_time,
+                                         const Callback callback,
+                                         const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    // events scheduled by an event are its children,
+    // while the ones scheduled before the simulation runs are ordered as they are scheduled
+    auto origin = EventOrigin();
+    if (processing) {
+        origin = {local_parent_flag | current_event, children_count};
+        children_count++;
+    } else {
+        origin = {0, *roots_count};
+        (*roots_count)++;
+    }
+
+    // events within the window are always of this partition, as the window is shorter than the lookahead
+    if (processing && event_time < window_end) {
+        assert(!ChunkArrival::matches(callback) ||
+               partition_per_device[static_cast<Chunk*>(callback_arg)->next_device()] == id);
+
+        enqueue_event(event_time, origin, callback, callback_arg);
+        return;
+    }
+
+    // otherwise, the event is handed over once the window ends,
+    // to the partition of the device the chunk arrives at if it's a chunk arrival
+    auto destination = id;
+    if (ChunkArrival::matches(callback)) {
+        destination = partition_per_device[static_cast<Chunk*>(callback_arg)->next_device()];
+    }
+    boundary_events[parity][destination].push_back({event_time, origin, callback, callback_arg});
+    boundary_events_time[parity] = std::min(boundary_events_time[parity], event_time);
+}
+
+void SimulationPartition::receive(const std::vector<std::unique_ptr<SimulationPartition>>& partitions,
+                                  const int parity) noexcept {
+    assert(parity == 0 || parity == 1);
+
+    // gather the boundary events sent to this partition,
+    // resolving their parents into ranks now that every partition has processed the window
+    received_events.clear();
+    for (const auto& partition : partitions) {
+        auto& events = partition->boundary_events[parity][id];
+        const auto& partition_ranks = partition->ranks[parity];
+        for (auto& event : events) {
+            if ((event.origin.parent & local_parent_flag) != 0) {
+                event.origin.parent = partition_ranks[event.origin.parent & ~local_parent_flag];
+            }
+            received_events.push_back(event);
+        }
+        events.clear();
+    }
+
+    // schedule them in the order the sequential simulation would have scheduled them
+    std::sort(received_events.begin(), received_events.end(), [](const BoundaryEvent& lhs, const BoundaryEvent& rhs) {
+        return std::tie(lhs.event_time, lhs.origin.parent, lhs.origin.child_index) <
+               std::tie(rhs.event_time, rhs.origin.parent, rhs.origin.child_index);
+    });
+    for (const auto& event : received_events) {
+        // a chunk arriving from another partition continues on this replica of the topology
+        if (ChunkArrival::matches(event.callback)) {
+            static_cast<Chunk*>(event.callback_arg)->set_topology(topology.get());
+        }
+        enqueue_event(event.event_time, event.origin, event.callback, event.callback_arg);
+    }
+}
+
+void SimulationPartition::process(const EventTime window_end, const int parity) noexcept {
+    assert(parity == 0 || parity == 1);
+
+    // the buffers of this parity were handed over during the previous window
+    this->window_end = window_end;
+    this->parity = parity;
+    processed_events[parity].clear();
+    ranks[parity].clear();
+    boundary_events_time[parity] = no_event_time;
+
+    // invoke the events of the window
+    processing = true;
+    current_partition = this;
+    while (!event_queue->finished() && event_queue->peek_next_time() < window_end) {
+        event_queue->proceed<&SimulationPartition::invoke_event>();
+    }
+    current_partition = nullptr;
+    processing = false;
+}
+
+EventTime SimulationPartition::get_next_event_time() const noexcept {
+    const auto next_event_time = event_queue->finished() ? no_event_time : event_queue->peek_next_time();
+    return std::min(next_event_time, boundary_events_time[parity]);
+}
+
+const std::vector<ProcessedEvent>& SimulationPartition::get_processed_events(const int parity) const noexcept {
+    assert(parity == 0 || parity == 1);
+
+    return processed_events[parity];
+}
+
+std::vector<uint64_t>& SimulationPartition::get_ranks(const int parity) noexcept {
+    assert(parity == 0 || parity == 1);
+
+    return ranks[parity];
+}
+
+void SimulationPartition::enqueue_event(const EventTime event_time,
+                                        const EventOrigin origin,
+                                        const Callback callback,
+                                        const CallbackArg callback_arg) noexcept {
+    // recycle a released pending event if one exists
+    auto* event = static_cast<PendingEvent*>(nullptr);
+    if (!free_pending_events.empty()) {
+        event = free_pending_events.back();
+        free_pending_events.pop_back();
+    } else {
+        event = &pending_events.emplace_back();
+    }
+    *event = {this, origin, callback, callback_arg};
+
+    event_queue->schedule_event<&SimulationPartition::invoke_event>(event_time, event);
+}
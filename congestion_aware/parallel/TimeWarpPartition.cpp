@@ -0,0 +1,393 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TimeWarpPartition.h"
+#include "common/EventHandler.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationContext.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// partition being processed by the calling thread
+thread_local TimeWarpPartition* current_partition = nullptr;
+
+/// tag of the link-free events, which stay in the partition of the link
+using LinkFree = EventHandler<&Link::link_become_free>;
+
+/// tag of the chunk arrival events, which go to the partition of the device the chunk arrives at
+using ChunkArrival = EventHandler<&Chunk::chunk_arrived_next_device>;
+
+}  // namespace
+
+TimeWarpPartition* TimeWarpPartition::get_current() noexcept {
+    return current_partition;
+}
+
+TimeWarpPartition::TimeWarpPartition(const int id,
+                                     std::shared_ptr<Topology> topology,
+                                     const std::vector<int>& partition_per_device,
+                                     const int partitions_count) noexcept
+    : id(id),
+      topology(std::move(topology)),
+      partition_per_device(partition_per_device),
+      parity(0),
+      processing(false),
+      current_key(),
+      min_sent_key(no_event_key),
+      last_committed_time(0),
+      stats() {
+    assert(0 <= id && id < partitions_count);
+    assert(this->topology != nullptr);
+
+    // the topology schedules the events of the network through the partition
+    event_queue = this->topology->get_event_queue().get();
+    link_store = &this->topology->get_context()->get_link_store();
+    this->topology->get_context()->set_partition(this);
+
+    outgoing_messages[0].resize(partitions_count);
+    outgoing_messages[1].resize(partitions_count);
+}
+
+TimeWarpPartition::~TimeWarpPartition() noexcept = default;
+
+Topology* TimeWarpPartition::get_topology() const noexcept {
+    return topology.get();
+}
+
+void TimeWarpPartition::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+    assert(partition_per_device[chunk->current_device()] == id);
+
+    topology->send(std::move(chunk));
+}
+
+void TimeWarpPartition::schedule_event(const EventTime event_time,
+                                       const Callback callback,
+                                       const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    // the link scheduling the event identifies it, so find the link and where the event goes
+    auto event = TimeWarpEvent();
+    event.callback = callback;
+    event.callback_arg = callback_arg;
+    auto cursor = ChunkCursor();
+    auto destination = id;
+    auto* link = static_cast<const Link*>(nullptr);
+    if (LinkFree::matches(callback)) {
+        // the link frees up for its first pending chunk
+        link = static_cast<const Link*>(callback_arg);
+        cursor = pending_chunk_cursor(link_store->pending_chunks(link->get_id()).front());
+    } else if (ChunkArrival::matches(callback)) {
+        // the chunk is sent through the link from its current device
+        const auto* const chunk = static_cast<const Chunk*>(callback_arg);
+        cursor = chunk->get_cursor();
+        link = topology->get_device(cursor.current_id)->find_link(cursor.next_id);
+        event.cursor = cursor;
+        destination = partition_per_device[cursor.next_id];
+    } else {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "optimistic simulation supports the events of the network only" << std::endl;
+        std::exit(-1);
+    }
+    assert(link != nullptr);
+
+    // events of the same time come after their parent
+    const auto depth = (processing && event_time == current_key.time) ? current_key.depth + 1 : 0;
+    auto& sequence = link_sequence(link);
+    event.key = {event_time, depth, cursor.current_id, cursor.next_id, sequence};
+    sequence++;
+
+    // remember the events sent by the event being processed, to cancel them on a rollback
+    if (processing) {
+        assert(current_key < event.key);
+        sent_events.push_back({event.key, destination});
+        logs.back().children_count++;
+    }
+
+    if (destination == id) {
+        pending_events.insert(allocate_event(event));
+        return;
+    }
+    outgoing_messages[parity][destination].push_back({event, false});
+    if (processing) {
+        min_sent_key = std::min(min_sent_key, event.key);
+    }
+}
+
+void TimeWarpPartition::receive(const std::vector<std::unique_ptr<TimeWarpPartition>>& partitions,
+                                const int parity) noexcept {
+    assert(parity == 0 || parity == 1);
+
+    // messages sent from now on belong to this step
+    this->parity = parity;
+
+    // gather the messages sent to this partition in the previous step
+    received_messages.clear();
+    for (const auto& partition : partitions) {
+        auto& messages = partition->outgoing_messages[parity ^ 1][id];
+        received_messages.insert(received_messages.end(), messages.begin(), messages.end());
+        messages.clear();
+    }
+    if (received_messages.empty()) {
+        return;
+    }
+
+    // handle the earliest first, so that the first straggler rolls back the most
+    std::sort(received_messages.begin(), received_messages.end(),
+              [](const TimeWarpMessage& lhs, const TimeWarpMessage& rhs) { return lhs.event.key < rhs.event.key; });
+    for (const auto& message : received_messages) {
+        const auto& key = message.event.key;
+        if (!message.anti) {
+            // a straggler rolls back the events processed after it
+            if (!logs.empty() && key < logs.back().event->key) {
+                rollback(key, false);
+            }
+            pending_events.insert(allocate_event(message.event));
+            continue;
+        }
+
+        // an anti-message cancels the event, rolling it back first if processed
+        auto cancelled = pending_events.find(key);
+        if (cancelled == pending_events.end()) {
+            rollback(key, true);
+            cancelled = pending_events.find(key);
+        }
+        assert(cancelled != pending_events.end());
+        free_events.push_back(*cancelled);
+        pending_events.erase(cancelled);
+    }
+}
+
+void TimeWarpPartition::commit(const EventKey& gvt) noexcept {
+    // events earlier than the GVT can't be rolled back anymore
+    while (!logs.empty() && logs.front().event->key < gvt) {
+        auto& log = logs.front();
+        last_committed_time = log.event->key.time;
+        sent_events.erase(sent_events.begin(), sent_events.begin() + log.children_count);
+        free_events.push_back(log.event);
+        logs.pop_front();
+        stats.committed_events_count++;
+    }
+}
+
+void TimeWarpPartition::process(const EventKey& safe_key, const EventTime end_time, const uint64_t batch_size) noexcept {
+    processing = true;
+    current_partition = this;
+    min_sent_key = no_event_key;
+
+    for (auto processed = uint64_t{0}; processed < batch_size && !pending_events.empty(); processed++) {
+        auto* const event = *pending_events.begin();
+        if (event->key.time >= end_time) {
+            break;
+        }
+
+        // callbacks can't be undone: wait until no earlier event can reach this partition,
+        // either from the other partitions or as a consequence of the events sent in this step
+        if (irreversible(event) && !(event->key < safe_key && event->key < min_sent_key)) {
+            break;
+        }
+
+        pending_events.erase(pending_events.begin());
+        execute(event);
+    }
+
+    current_partition = nullptr;
+    processing = false;
+}
+
+EventKey TimeWarpPartition::get_next_event_key() const noexcept {
+    return pending_events.empty() ? no_event_key : (*pending_events.begin())->key;
+}
+
+bool TimeWarpPartition::sent_messages(const int parity) const noexcept {
+    assert(parity == 0 || parity == 1);
+
+    return std::any_of(outgoing_messages[parity].begin(), outgoing_messages[parity].end(),
+                       [](const std::vector<TimeWarpMessage>& messages) { return !messages.empty(); });
+}
+
+uint64_t TimeWarpPartition::get_uncommitted_events_count() const noexcept {
+    return logs.size();
+}
+
+EventTime TimeWarpPartition::get_last_committed_time() const noexcept {
+    return last_committed_time;
+}
+
+const TimeWarpStats& TimeWarpPartition::get_stats() const noexcept {
+    return stats;
+}
+
+void TimeWarpPartition::execute(TimeWarpEvent* const event) noexcept {
+    assert(event != nullptr);
+
+    event_queue->set_current_time(event->key.time);
+    current_key = event->key;
+    auto& log = logs.emplace_back();
+    log.event = event;
+    log.link = nullptr;
+    log.children_count = 0;
+    stats.processed_events_count++;
+
+    if (LinkFree::matches(event->callback)) {
+        // the first pending chunk may have been put back by a rollback
+        auto* const link = static_cast<Link*>(event->callback_arg);
+        auto* const front_chunk = link_store->pending_chunks(link->get_id()).front();
+        const auto requeued_cursor = requeued_cursors.find(front_chunk);
+        if (requeued_cursor != requeued_cursors.end()) {
+            front_chunk->set_cursor(requeued_cursor->second);
+            requeued_cursors.erase(requeued_cursor);
+        }
+
+        save_link_state(log, link);
+        Link::link_become_free(link);
+        return;
+    }
+
+    // the chunk arrives at the next device of its position when sent
+    auto* const chunk = static_cast<Chunk*>(event->callback_arg);
+    chunk->set_cursor(event->cursor);
+    if (chunk->get_topology() != topology.get()) {
+        chunk->set_topology(topology.get());
+    }
+    chunk->mark_arrived_next_device();
+
+    if (chunk->arrived_dest()) {
+        // chunk arrived dest, invoke callback (committed, see process())
+        auto arrived_chunk = std::unique_ptr<Chunk>(chunk);
+        arrived_chunk->invoke_callback();
+        return;
+    }
+
+    // send this chunk to next dest
+    auto* const link = topology->get_device(chunk->current_device())->get_link(chunk->next_device());
+    save_link_state(log, link);
+    link->send(std::unique_ptr<Chunk>(chunk));
+}
+
+void TimeWarpPartition::save_link_state(TimeWarpLog& log, Link* const link) noexcept {
+    assert(link != nullptr);
+
+    const auto link_id = link->get_id();
+    const auto& pending_chunks = link_store->pending_chunks(link_id);
+    log.link = link;
+    log.busy_until = link_store->busy_until(link_id);
+    log.queue_counters = link_store->queue_counters(link_id);
+    log.pending_chunks_count = pending_chunks.size();
+    log.front_chunk = pending_chunks.empty() ? nullptr : pending_chunks.front();
+    log.front_cursor = pending_chunks.empty() ? ChunkCursor() : pending_chunk_cursor(log.front_chunk);
+    log.link_sequence = link_sequence(link);
+}
+
+void TimeWarpPartition::rollback(const EventKey& key, const bool inclusive) noexcept {
+    stats.rollbacks_count++;
+
+    // undo the processed events in the reverse order
+    while (!logs.empty() && (key < logs.back().event->key || (inclusive && !(logs.back().event->key < key)))) {
+        undo();
+    }
+}
+
+void TimeWarpPartition::undo() noexcept {
+    assert(!logs.empty());
+
+    auto& log = logs.back();
+    assert(!irreversible(log.event));
+
+    // cancel the events sent by the event, the latest first
+    for (auto i = uint32_t{0}; i < log.children_count; i++) {
+        const auto sent_event = sent_events.back();
+        sent_events.pop_back();
+        if (sent_event.partition != id) {
+            // an anti-message only carries the key of the event to cancel
+            auto anti_event = TimeWarpEvent();
+            anti_event.key = sent_event.key;
+            anti_event.callback = nullptr;
+            anti_event.callback_arg = nullptr;
+            anti_event.cursor = ChunkCursor();
+            outgoing_messages[parity][sent_event.partition].push_back({anti_event, true});
+            stats.anti_messages_count++;
+            continue;
+        }
+
+        // local events processed later have been undone already
+        const auto cancelled = pending_events.find(sent_event.key);
+        assert(cancelled != pending_events.end());
+        free_events.push_back(*cancelled);
+        pending_events.erase(cancelled);
+    }
+
+    // restore the link
+    if (log.link != nullptr) {
+        const auto link_id = log.link->get_id();
+        auto& pending_chunks = link_store->pending_chunks(link_id);
+        if (pending_chunks.size() > log.pending_chunks_count) {
+            // the chunk has been queued: it goes back to its arrival event
+            auto* const queued_chunk = pending_chunks.pop_back().release();
+            requeued_cursors.erase(queued_chunk);
+        } else if (pending_chunks.size() < log.pending_chunks_count) {
+            // the first chunk has been dequeued and sent: put it back in its position when dequeued
+            pending_chunks.push_front(std::unique_ptr<Chunk>(log.front_chunk));
+            requeued_cursors[log.front_chunk] = log.front_cursor;
+        }
+        link_store->busy_until(link_id) = log.busy_until;
+        link_store->queue_counters(link_id) = log.queue_counters;
+        link_sequence(log.link) = log.link_sequence;
+    }
+
+    // the event will be processed again
+    pending_events.insert(log.event);
+    logs.pop_back();
+    stats.rolled_back_events_count++;
+}
+
+bool TimeWarpPartition::irreversible(const TimeWarpEvent* const event) noexcept {
+    assert(event != nullptr);
+
+    if (!ChunkArrival::matches(event->callback)) {
+        return false;
+    }
+    const auto* const chunk = static_cast<const Chunk*>(event->callback_arg);
+    return event->cursor.next_id == chunk->dest_device();
+}
+
+ChunkCursor TimeWarpPartition::pending_chunk_cursor(Chunk* const chunk) const noexcept {
+    assert(chunk != nullptr);
+
+    const auto requeued_cursor = requeued_cursors.find(chunk);
+    return (requeued_cursor != requeued_cursors.end()) ? requeued_cursor->second : chunk->get_cursor();
+}
+
+TimeWarpEvent* TimeWarpPartition::allocate_event(const TimeWarpEvent& event) noexcept {
+    // recycle a released record if one exists
+    auto* record = static_cast<TimeWarpEvent*>(nullptr);
+    if (!free_events.empty()) {
+        record = free_events.back();
+        free_events.pop_back();
+    } else {
+        record = &events.emplace_back();
+    }
+    *record = event;
+    return record;
+}
+
+uint64_t& TimeWarpPartition::link_sequence(const Link* const link) noexcept {
+    assert(link != nullptr);
+
+    // links of a fully-connected topology are instantiated on their first use
+    const auto link_id = link->get_id();
+    if (link_id >= link_sequences.size()) {
+        link_sequences.resize(link_store->size(), 0);
+    }
+    return link_sequences[link_id];
+}
@@ -0,0 +1,210 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/TimeWarpSimulation.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/Partition.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+TimeWarpSimulation::TimeWarpSimulation(const NetworkParser& network_parser,
+                                       const int threads_count,
+                                       const EventTime optimism_window,
+                                       const uint64_t batch_size) noexcept
+    : thread_pool(threads_count),
+      optimism_window(optimism_window),
+      batch_size(batch_size),
+      parity(0),
+      rounds_count(0),
+      peak_uncommitted_events_count(0),
+      wall_time_s(0.0),
+      started(false) {
+    assert(threads_count >= 0);
+    assert(optimism_window > 0);
+    assert(batch_size > 0);
+
+    // construct a replica of the topology per partition
+    const auto partitions_count = thread_pool.get_workers_count();
+    auto topologies = std::vector<std::shared_ptr<Topology>>(partitions_count);
+    thread_pool.parallel_for(partitions_count, [&](const size_t partition, int) {
+        topologies[partition] = construct_topology(network_parser);
+    });
+
+    // split the devices into partitions
+    partition_per_device = Partition::split_devices(*topologies[0], partitions_count);
+    for (auto partition = 0; partition < partitions_count; partition++) {
+        partitions.push_back(std::make_unique<TimeWarpPartition>(partition, std::move(topologies[partition]),
+                                                                 partition_per_device, partitions_count));
+    }
+}
+
+void TimeWarpSimulation::send(std::unique_ptr<Chunk> chunk) noexcept {
+    assert(chunk != nullptr);
+
+    // chunks are sent before the simulation runs, or by the partition of the src device
+    const auto src = chunk->current_device();
+    assert(0 <= src && src < get_npus_count());
+    auto* const partition = partitions[partition_per_device[src]].get();
+    if (started && TimeWarpPartition::get_current() != partition) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): "
+                  << "a running optimistic simulation accepts chunks from the callbacks of the same partition only"
+                  << std::endl;
+        std::exit(-1);
+    }
+
+    partition->send(std::move(chunk));
+}
+
+void TimeWarpSimulation::run() noexcept {
+    // a simulation runs once, as the partitions end up at different times
+    if (started) {
+        std::cerr << "[Error] (network/analytical/congestion_aware): " << "an optimistic simulation runs only once"
+                  << std::endl;
+        std::exit(-1);
+    }
+    started = true;
+    const auto start = std::chrono::steady_clock::now();
+
+    // every partition receives the messages of the previous step,
+    // then (in a processing step) commits and processes its events
+    const auto partitions_count = partitions.size();
+    auto gvt = TimeWarpPartition::no_event_key;
+    auto safe_keys = std::vector<EventKey>(partitions_count);
+    auto end_time = EventTime{0};
+    const auto step = [&](const bool processing) {
+        parity ^= 1;
+        thread_pool.parallel_for(partitions_count, [&](const size_t partition, int) {
+            partitions[partition]->receive(partitions, parity);
+            if (processing) {
+                partitions[partition]->commit(gvt);
+                partitions[partition]->process(safe_keys[partition], end_time, batch_size);
+            }
+        });
+    };
+    const auto messages_in_flight = [&]() {
+        return std::any_of(partitions.begin(), partitions.end(),
+                           [&](const auto& partition) { return partition->sent_messages(parity); });
+    };
+
+    while (true) {
+        // exchange the messages until none is left, as rollbacks send anti-messages
+        while (messages_in_flight()) {
+            step(false);
+        }
+
+        // the GVT is the earliest unprocessed event, as no message is in flight
+        // (and each partition is safe up to the earliest unprocessed event of the others)
+        auto earliest = TimeWarpPartition::no_event_key;
+        auto second_earliest = TimeWarpPartition::no_event_key;
+        auto earliest_partition = size_t{0};
+        for (auto partition = size_t{0}; partition < partitions_count; partition++) {
+            const auto next_event_key = partitions[partition]->get_next_event_key();
+            if (next_event_key < earliest) {
+                second_earliest = earliest;
+                earliest = next_event_key;
+                earliest_partition = partition;
+            } else if (next_event_key < second_earliest) {
+                second_earliest = next_event_key;
+            }
+        }
+        gvt = earliest;
+        if (!(gvt < TimeWarpPartition::no_event_key)) {
+            break;
+        }
+        for (auto partition = size_t{0}; partition < partitions_count; partition++) {
+            safe_keys[partition] = (partition == earliest_partition) ? second_earliest : earliest;
+        }
+        const auto remaining_time = TimeWarpPartition::no_event_key.time - gvt.time;
+        end_time = (optimism_window < remaining_time) ? gvt.time + optimism_window : TimeWarpPartition::no_event_key.time;
+
+        // processing step
+        step(true);
+        rounds_count++;
+
+        auto uncommitted_events_count = uint64_t{0};
+        for (const auto& partition : partitions) {
+            uncommitted_events_count += partition->get_uncommitted_events_count();
+        }
+        peak_uncommitted_events_count = std::max(peak_uncommitted_events_count, uncommitted_events_count);
+    }
+
+    // every event is committed, and the simulation ends at the last one
+    auto end = EventTime{0};
+    for (const auto& partition : partitions) {
+        partition->commit(TimeWarpPartition::no_event_key);
+        end = std::max(end, partition->get_last_committed_time());
+    }
+    for (const auto& partition : partitions) {
+        partition->get_topology()->get_event_queue()->set_current_time(end);
+    }
+
+    const auto finish = std::chrono::steady_clock::now();
+    wall_time_s = std::chrono::duration<double>(finish - start).count();
+}
+
+EventTime TimeWarpSimulation::get_current_time() const noexcept {
+    // in a callback, the time of the partition invoking it
+    const auto* const current_partition = TimeWarpPartition::get_current();
+    if (current_partition != nullptr) {
+        return current_partition->get_topology()->get_event_queue()->get_current_time();
+    }
+
+    // otherwise, the time of the last committed event of every partition
+    auto current_time = EventTime{0};
+    for (const auto& partition : partitions) {
+        current_time = std::max(current_time, partition->get_last_committed_time());
+    }
+    return current_time;
+}
+
+int TimeWarpSimulation::get_partitions_count() const noexcept {
+    return static_cast<int>(partitions.size());
+}
+
+int TimeWarpSimulation::get_partition(const DeviceId device) const noexcept {
+    assert(0 <= device && device < partition_per_device.size());
+
+    return partition_per_device[device];
+}
+
+TimeWarpStats TimeWarpSimulation::get_stats() const noexcept {
+    // sum up the counters of the partitions
+    auto stats = TimeWarpStats();
+    for (const auto& partition : partitions) {
+        const auto& partition_stats = partition->get_stats();
+        stats.processed_events_count += partition_stats.processed_events_count;
+        stats.committed_events_count += partition_stats.committed_events_count;
+        stats.rolled_back_events_count += partition_stats.rolled_back_events_count;
+        stats.rollbacks_count += partition_stats.rollbacks_count;
+        stats.anti_messages_count += partition_stats.anti_messages_count;
+    }
+    stats.rounds_count = rounds_count;
+    stats.peak_uncommitted_events_count = peak_uncommitted_events_count;
+
+    // report the rates
+    stats.wall_time_s = wall_time_s;
+    stats.event_rate = (wall_time_s > 0) ? static_cast<double>(stats.committed_events_count) / wall_time_s : 0.0;
+    stats.rollback_ratio = (stats.processed_events_count > 0) ? static_cast<double>(stats.rolled_back_events_count) /
+                                                                    static_cast<double>(stats.processed_events_count)
+                                                              : 0.0;
+    return stats;
+}
+
+LinkStats TimeWarpSimulation::get_link_stats(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < partition_per_device.size());
+
+    // the link is simulated by the partition of its src device
+    return partitions[partition_per_device[src]]->get_topology()->get_link_stats(src, dest);
+}
+
+int TimeWarpSimulation::get_npus_count() const noexcept {
+    return partitions.front()->get_topology()->get_npus_count();
+}
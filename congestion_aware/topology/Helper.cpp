@@ -5,10 +5,12 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Helper.h"
 #include "congestion_aware/FullyConnected.h"
+#include "congestion_aware/MultiDimTopology.h"
 #include "congestion_aware/Ring.h"
 #include "congestion_aware/Switch.h"
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
@@ -22,28 +24,49 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
     const auto bandwidths_per_dim = network_parser.get_bandwidths_per_dim();
     const auto latencies_per_dim = network_parser.get_latencies_per_dim();
 
-    // for now, congestion_aware backend supports 1-dim topology only
-    if (dims_count != 1) {
-        std::cerr << "[Error] (network/analytical/congestion_aware) " << "only support 1-dim topology" << std::endl;
-        std::exit(-1);
+    // create the network dimensions
+    auto topology_per_dim = std::vector<std::unique_ptr<BasicTopology>>();
+    for (auto dim = 0; dim < dims_count; dim++) {
+        // retrieve basic basic-topology info
+        const auto topology_type = topologies_per_dim[dim];
+        const auto npus_count = npus_counts_per_dim[dim];
+        const auto bandwidth = bandwidths_per_dim[dim];
+        const auto latency = latencies_per_dim[dim];
+
+        switch (topology_type) {
+        case TopologyBuildingBlock::Ring:
+            topology_per_dim.push_back(std::make_unique<Ring>(npus_count, bandwidth, latency));
+            break;
+        case TopologyBuildingBlock::Switch:
+            topology_per_dim.push_back(std::make_unique<Switch>(npus_count, bandwidth, latency));
+            break;
+        case TopologyBuildingBlock::FullyConnected:
+            topology_per_dim.push_back(std::make_unique<FullyConnected>(npus_count, bandwidth, latency));
+            break;
+        default:
+            // shouldn't reaach here
+            std::cerr << "[Error] (network/analytical/congestion_aware) " << "not supported basic-topology"
+                      << std::endl;
+            std::exit(-1);
+        }
     }
 
-    // retrieve basic basic-topology info
-    const auto topology_type = topologies_per_dim[0];
-    const auto npus_count = npus_counts_per_dim[0];
-    const auto bandwidth = bandwidths_per_dim[0];
-    const auto latency = latencies_per_dim[0];
-
-    switch (topology_type) {
-    case TopologyBuildingBlock::Ring:
-        return std::make_shared<Ring>(npus_count, bandwidth, latency);
-    case TopologyBuildingBlock::Switch:
-        return std::make_shared<Switch>(npus_count, bandwidth, latency);
-    case TopologyBuildingBlock::FullyConnected:
-        return std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
-    default:
-        // shouldn't reaach here
-        std::cerr << "[Error] (network/analytical/congestion_aware) " << "not supported basic-topology" << std::endl;
-        std::exit(-1);
+    // if dims_count is 1, just use the basic topology
+    auto topology = std::shared_ptr<Topology>();
+    if (dims_count == 1) {
+        topology = std::move(topology_per_dim[0]);
+    } else {
+        // otherwise, stack up the dimensions
+        auto multi_dim_topology = std::make_shared<MultiDimTopology>();
+        for (auto& dim_topology : topology_per_dim) {
+            multi_dim_topology->append_dimension(std::move(dim_topology));
+        }
+        multi_dim_topology->build();
+        topology = std::move(multi_dim_topology);
     }
+
+    // simulate with the configured scheduling policy
+    topology->set_event_queue(std::make_shared<EventQueue>(network_parser.get_scheduling_policy()));
+
+    return topology;
 }
@@ -0,0 +1,46 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/SimulationContext.h"
+#include "congestion_aware/Partition.h"
+#include <cassert>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+SimulationContext::SimulationContext() noexcept
+    : event_queue(std::make_shared<EventQueue>()),
+      chunk_pool(),
+      link_store(),
+      route_fusion(false),
+      partition(nullptr) {}
+
+void SimulationContext::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
+    assert(event_queue_ptr != nullptr);
+
+    // set the event queue
+    event_queue = std::move(event_queue_ptr);
+}
+
+ChunkPool& SimulationContext::get_chunk_pool() noexcept {
+    return chunk_pool;
+}
+
+void SimulationContext::set_route_fusion(const bool enabled) noexcept {
+    route_fusion = enabled;
+}
+
+void SimulationContext::set_partition(Partition* const partition_ptr) noexcept {
+    assert(partition_ptr != nullptr);
+
+    partition = partition_ptr;
+}
+
+void SimulationContext::schedule_partitioned_event(const EventTime event_time,
+                                                   const Callback callback,
+                                                   const CallbackArg callback_arg) noexcept {
+    assert(partition != nullptr);
+
+    partition->schedule_event(event_time, callback, callback_arg);
+}
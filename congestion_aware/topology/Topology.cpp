@@ -4,20 +4,72 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Topology.h"
+#include "common/NetworkFunction.h"
+#include "congestion_aware/FusedTransmission.h"
 #include "congestion_aware/Link.h"
+#include <algorithm>
 #include <cassert>
+#include <new>
+#include <numeric>
+#include <tuple>
 
 using namespace NetworkAnalyticalCongestionAware;
 
+void Topology::proceed(EventQueue& event_queue) noexcept {
+    assert(!event_queue.finished());
+
+    // dispatch the events of the network directly
+    event_queue.proceed<&Link::link_become_free, &Chunk::chunk_arrived_next_device,
+                        &FusedTransmission::chunk_arrived_dest>();
+}
+
+void Topology::run_until(EventQueue& event_queue, const EventTime end_time) noexcept {
+    event_queue.run_until<&Link::link_become_free, &Chunk::chunk_arrived_next_device,
+                          &FusedTransmission::chunk_arrived_dest>(end_time);
+}
+
+uint64_t Topology::run_events(EventQueue& event_queue, const uint64_t events_count) noexcept {
+    return event_queue.run_events<&Link::link_become_free, &Chunk::chunk_arrived_next_device,
+                                  &FusedTransmission::chunk_arrived_dest>(events_count);
+}
+
+Topology::Topology() noexcept
+    : npus_count(-1),
+      devices_count(-1),
+      dims_count(-1),
+      context(std::make_unique<SimulationContext>()) {
+    npus_count_per_dim = {};
+}
+
 void Topology::set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept {
     assert(event_queue != nullptr);
 
-    // pass the given event_queue to Link
-    Link::set_event_queue(std::move(event_queue));
+    // pass the given event_queue to the context
+    context->set_event_queue(std::move(event_queue));
 }
 
-Topology::Topology() noexcept : npus_count(-1), devices_count(-1), dims_count(-1) {
-    npus_count_per_dim = {};
+std::shared_ptr<EventQueue> Topology::get_event_queue() const noexcept {
+    return context->get_event_queue();
+}
+
+void Topology::set_route_fusion(const bool enabled) noexcept {
+    // pass the flag to the context
+    context->set_route_fusion(enabled);
+}
+
+std::vector<std::pair<DeviceId, DeviceId>> Topology::get_connections() const noexcept {
+    // links should be built
+    assert(links_offsets.size() == devices_count + 1);
+
+    // links in the table and implicit ones alike
+    auto connections = std::vector<std::pair<DeviceId, DeviceId>>();
+    connections.reserve(links.size());
+    for (auto src = 0; src < devices_count; src++) {
+        for (const auto dest : devices[src]->get_links_dests()) {
+            connections.emplace_back(src, dest);
+        }
+    }
+    return connections;
 }
 
 int Topology::get_devices_count() const noexcept {
@@ -54,15 +106,63 @@ std::vector<Bandwidth> Topology::get_bandwidth_per_dim() const noexcept {
     return bandwidth_per_dim;
 }
 
+std::unique_ptr<Chunk> Topology::make_chunk(const ChunkSize chunk_size,
+                                            const DeviceId src,
+                                            const DeviceId dest,
+                                            const Callback callback,
+                                            const CallbackArg callback_arg) noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    // construct the chunk on a pooled storage
+    auto* const storage = context->get_chunk_pool().allocate();
+    auto* const chunk = ::new (storage) Chunk(chunk_size, src, dest, callback, callback_arg);
+    chunk->set_topology(this);
+
+    return std::unique_ptr<Chunk>(chunk);
+}
+
+std::unique_ptr<Chunk> Topology::make_chunk(const ChunkSize chunk_size,
+                                            Route route,
+                                            const Callback callback,
+                                            const CallbackArg callback_arg) noexcept {
+    assert(!route.empty());
+    assert(0 <= route.front() && route.front() < npus_count);
+    assert(0 <= route.back() && route.back() < npus_count);
+
+    // construct the chunk on a pooled storage, moving the route in
+    auto* const storage = context->get_chunk_pool().allocate();
+    auto* const chunk = ::new (storage) Chunk(chunk_size, std::move(route), callback, callback_arg);
+    chunk->set_topology(this);
+
+    return std::unique_ptr<Chunk>(chunk);
+}
+
+ChunkPoolStats Topology::get_chunk_pool_stats() const noexcept {
+    return context->get_chunk_pool().get_stats();
+}
+
+LinkStats Topology::get_link_stats(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < devices_count);
+    assert(0 <= dest && dest < devices_count);
+
+    // links not instantiated yet haven't queued any chunk
+    const auto* const link = devices[src]->find_link(dest);
+    return (link != nullptr) ? link->get_stats() : LinkStats();
+}
+
 void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     // get src npu node_id
-    const auto src = chunk->current_device()->get_id();
+    const auto src = chunk->current_device();
 
     // assert src is valid
     assert(0 <= src && src < devices_count);
 
+    // the chunk is transmitted through this topology
+    chunk->set_topology(this);
+
     // initiate transmission from src
     devices[src]->send(std::move(chunk));
 }
@@ -81,17 +181,135 @@ void Topology::connect(const DeviceId src,
     assert(latency >= 0);
 
     // connect src -> dest
-    devices[src]->connect(dest, bandwidth, latency);
+    const auto* const parameters = get_link_parameters(bandwidth, latency);
+    links_srcs.push_back(src);
+    links_dests.push_back(dest);
+    links_staged_parameters.push_back(parameters);
 
     // if bidirectional, connect dest -> src
     if (bidirectional) {
-        devices[dest]->connect(src, bandwidth, latency);
+        links_srcs.push_back(dest);
+        links_dests.push_back(src);
+        links_staged_parameters.push_back(parameters);
+    }
+}
+
+void Topology::connect_fully(const DeviceId first,
+                             const DeviceId last,
+                             const Bandwidth bandwidth,
+                             const Latency latency) noexcept {
+    // assert the devices are valid
+    assert(0 <= first && first <= last && last < devices_count);
+
+    // assert bandwidth and latency are valid
+    assert(bandwidth > 0);
+    assert(latency >= 0);
+
+    // every device connects to the others once it sends a chunk to them
+    const auto* const parameters = get_link_parameters(bandwidth, latency);
+    for (auto device = first; device <= last; device++) {
+        devices[device]->set_implicit_links(first, last, parameters);
+    }
+}
+
+const LinkParameters* Topology::get_link_parameters(const Bandwidth bandwidth, const Latency latency) noexcept {
+    // convert bandwidth from GB/s to B/ns
+    const auto inverse_bandwidth_nspB = 1.0 / bw_GBps_to_Bpns(bandwidth);
+
+    // a topology has a few distinct parameters (e.g., one per dimension), the last one most likely matching
+    for (auto parameters = links_parameters.rbegin(); parameters != links_parameters.rend(); parameters++) {
+        if (parameters->inverse_bandwidth_nspB == inverse_bandwidth_nspB && parameters->latency == latency) {
+            return &*parameters;
+        }
+    }
+
+    links_parameters.push_back({inverse_bandwidth_nspB, latency});
+    return &links_parameters.back();
+}
+
+void Topology::reserve_links(const size_t links_count) noexcept {
+    links_srcs.reserve(links_count);
+    links_dests.reserve(links_count);
+    links_staged_parameters.reserve(links_count);
+}
+
+void Topology::build_links() noexcept {
+    assert(links_srcs.size() == links_dests.size());
+    assert(links_srcs.size() == links_staged_parameters.size());
+    assert(links.empty());
+    assert(links_offsets.empty());
+
+    // sort the links by (src, dest), unless connected in that order already
+    const auto links_count = links_srcs.size();
+    const auto link_precedes = [this](const size_t lhs, const size_t rhs) {
+        return std::tie(links_srcs[lhs], links_dests[lhs]) < std::tie(links_srcs[rhs], links_dests[rhs]);
+    };
+    auto sorted = true;
+    for (auto i = size_t{1}; i < links_count; i++) {
+        if (!link_precedes(i - 1, i)) {
+            sorted = false;
+            break;
+        }
+    }
+    if (!sorted) {
+        auto order = std::vector<size_t>(links_count);
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::sort(order.begin(), order.end(), link_precedes);
+
+        auto sorted_srcs = std::vector<DeviceId>();
+        auto sorted_dests = std::vector<DeviceId>();
+        auto sorted_parameters = std::vector<const LinkParameters*>();
+        sorted_srcs.reserve(links_count);
+        sorted_dests.reserve(links_count);
+        sorted_parameters.reserve(links_count);
+        for (const auto i : order) {
+            sorted_srcs.push_back(links_srcs[i]);
+            sorted_dests.push_back(links_dests[i]);
+            sorted_parameters.push_back(links_staged_parameters[i]);
+        }
+        links_srcs = std::move(sorted_srcs);
+        links_dests = std::move(sorted_dests);
+        links_staged_parameters = std::move(sorted_parameters);
+    }
+
+    // assert there's no duplicated connection
+    for (auto i = size_t{1}; i < links_count; i++) {
+        assert(link_precedes(i - 1, i));
+    }
+
+    // store the state of the links in the same order, so that the links of a device are adjacent in the store too
+    auto& link_store = context->get_link_store();
+    link_store.reserve(link_store.size() + links_count);
+    links.reserve(links_count);
+    for (const auto* const parameters : links_staged_parameters) {
+        links.emplace_back(context.get(), link_store.add_link(parameters));
+    }
+
+    // compute the range of links of each device
+    links_offsets.assign(devices_count + 1, 0);
+    for (const auto src : links_srcs) {
+        links_offsets[src + 1]++;
+    }
+    std::partial_sum(links_offsets.begin(), links_offsets.end(), links_offsets.begin());
+
+    // src ids and parameters are implied by the offsets and the link store now
+    links_srcs.clear();
+    links_srcs.shrink_to_fit();
+    links_staged_parameters.clear();
+    links_staged_parameters.shrink_to_fit();
+    links_dests.shrink_to_fit();
+
+    // hand each device its links
+    for (auto i = 0; i < devices_count; i++) {
+        const auto offset = links_offsets[i];
+        const auto count = static_cast<int>(links_offsets[i + 1] - offset);
+        devices[i]->set_links(links.data() + offset, links_dests.data() + offset, count);
     }
 }
 
 void Topology::instantiate_devices() noexcept {
     // instantiate all devices
     for (auto i = 0; i < devices_count; i++) {
-        devices.push_back(std::make_shared<Device>(i));
+        devices.push_back(std::make_shared<Device>(i, context.get()));
     }
 }
@@ -5,14 +5,60 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_unaware/BasicTopology.h"
 #include "common/NetworkFunction.h"
+#include "common/Vectorize.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <limits>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
+namespace {
+
+/**
+ * Compute the communication delay of each chunk, as compute_communication_delay does.
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void compute_communication_delays(const int* const hops_counts,
+                                  const ChunkSize* const chunk_sizes,
+                                  EventTime* const delays,
+                                  const size_t count,
+                                  const Latency latency,
+                                  const Bandwidth bandwidth_Bpns) noexcept {
+    for (auto i = size_t{0}; i < count; i++) {
+        const auto link_delay = hops_counts[i] * latency;
+        const auto serialization_delay = static_cast<double>(chunk_sizes[i]) / bandwidth_Bpns;
+        delays[i] = static_cast<EventTime>(link_delay + serialization_delay);
+    }
+}
+
+/**
+ * Compute the communication delay of each chunk in the precomputed mode, as send_precomputed does.
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void compute_communication_delays_precomputed(const int* const hops_counts,
+                                              const ChunkSize* const chunk_sizes,
+                                              EventTime* const delays,
+                                              const size_t count,
+                                              const Latency latency,
+                                              const double inverse_bandwidth_nspB) noexcept {
+    for (auto i = size_t{0}; i < count; i++) {
+        const auto delay = std::fma(static_cast<double>(hops_counts[i]), latency,
+                                    static_cast<double>(chunk_sizes[i]) * inverse_bandwidth_nspB);
+        delays[i] = static_cast<EventTime>(delay);
+    }
+}
+
+}  // namespace
+
 BasicTopology::BasicTopology(const int npus_count, const Bandwidth bandwidth, const Latency latency) noexcept
     : latency(latency),
       basic_topology_type(TopologyBuildingBlock::Undefined),
+      precomputed(false),
+      inverse_bandwidth_nspB(0),
+      hops_table(),
       Topology() {
     assert(npus_count > 0);
     assert(bandwidth > 0);
@@ -38,6 +84,11 @@ EventTime BasicTopology::send(const DeviceId src, const DeviceId dest, const Chu
     assert(src != dest);
     assert(chunk_size > 0);
 
+    // look up the precomputed delay
+    if (precomputed) {
+        return send_precomputed(src, dest, chunk_size);
+    }
+
     // get hops count
     auto hops_count = compute_hops_count(src, dest);
 
@@ -45,19 +96,66 @@ EventTime BasicTopology::send(const DeviceId src, const DeviceId dest, const Chu
     return compute_communication_delay(hops_count, chunk_size);
 }
 
-EventTime BasicTopology::compute_communication_delay(const int hops_count, const ChunkSize chunk_size) const noexcept {
-    assert(hops_count > 0);
-    assert(chunk_size > 0);
+void BasicTopology::send_batch(const DeviceId* const srcs,
+                               const DeviceId* const dests,
+                               const ChunkSize* const chunk_sizes,
+                               EventTime* const delays,
+                               const size_t count) const noexcept {
+    assert(count == 0 || (srcs != nullptr && dests != nullptr && chunk_sizes != nullptr && delays != nullptr));
+
+    auto hops_counts = std::array<int, batch_block_size>();
+    for (auto begin = size_t{0}; begin < count; begin += batch_block_size) {
+        const auto block_size = std::min(batch_block_size, count - begin);
+        for (auto i = begin; i < begin + block_size; i++) {
+            assert(0 <= srcs[i] && srcs[i] < npus_count);
+            assert(0 <= dests[i] && dests[i] < npus_count);
+            assert(srcs[i] != dests[i]);
+            assert(chunk_sizes[i] > 0);
+        }
+
+        // get hops counts, then communication delays
+        compute_hops_counts(srcs + begin, dests + begin, hops_counts.data(), block_size);
+        if (precomputed) {
+            compute_communication_delays_precomputed(hops_counts.data(), chunk_sizes + begin, delays + begin,
+                                                     block_size, latency, inverse_bandwidth_nspB);
+        } else {
+            compute_communication_delays(hops_counts.data(), chunk_sizes + begin, delays + begin, block_size, latency,
+                                         bandwidth_Bpns);
+        }
+    }
+}
+
+size_t BasicTopology::precompute_delays(const size_t max_tables_bytes) noexcept {
+    // precompute the inverse bandwidth
+    precomputed = true;
+    inverse_bandwidth_nspB = 1.0 / bandwidth_Bpns;
 
-    // compute link delay and serialization delay
-    auto link_delay = hops_count * latency;
-    auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+    // tabulate the hops count of every pair if the table fits
+    hops_table.clear();
+    const auto table_size = static_cast<size_t>(npus_count) * static_cast<size_t>(npus_count);
+    if (table_size > max_tables_bytes) {
+        hops_table.shrink_to_fit();
+        return 0;
+    }
+    hops_table.resize(table_size, 0);
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src == dest) {
+                continue;
+            }
 
-    // comms_delay is the summation of the two
-    auto comms_delay = link_delay + serialization_delay;
+            // hops count should fit in the table entry
+            const auto hops_count = compute_hops_count(src, dest);
+            if (hops_count > std::numeric_limits<uint8_t>::max()) {
+                hops_table.clear();
+                hops_table.shrink_to_fit();
+                return 0;
+            }
+            hops_table[(src * npus_count) + dest] = static_cast<uint8_t>(hops_count);
+        }
+    }
 
-    // return EventTime type of comms_delay
-    return static_cast<EventTime>(comms_delay);
+    return hops_table.size();
 }
 
 TopologyBuildingBlock BasicTopology::get_basic_topology_type() const noexcept {
@@ -4,6 +4,7 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/FullyConnected.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
@@ -19,11 +20,10 @@ FullyConnected::FullyConnected(const int npus_count, const Bandwidth bandwidth,
     basic_topology_type = TopologyBuildingBlock::FullyConnected;
 }
 
-int FullyConnected::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
-    // for FullyConnected, hops_count is always 1 (src -> dest)
-    return 1;
+void FullyConnected::compute_hops_counts(const DeviceId* const,
+                                         const DeviceId* const,
+                                         int* const hops_counts,
+                                         const size_t count) const noexcept {
+    // hops_count is always 1 (src -> dest)
+    std::fill_n(hops_counts, count, 1);
 }
@@ -4,11 +4,38 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Ring.h"
+#include "common/Vectorize.h"
 #include <cassert>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
+namespace {
+
+/**
+ * Compute the number of hops of each (src, dest) pair in a Ring, without branches.
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void compute_ring_hops_counts(const DeviceId* const srcs,
+                              const DeviceId* const dests,
+                              int* const hops_counts,
+                              const size_t count,
+                              const int npus_count,
+                              const bool bidirectional) noexcept {
+    for (auto i = size_t{0}; i < count; i++) {
+        // compute clockwise and anticlockwise distance
+        auto clockwise_distance = dests[i] - srcs[i];
+        clockwise_distance += (clockwise_distance < 0) ? npus_count : 0;
+        const auto anticlockwise_distance = npus_count - clockwise_distance;
+
+        // bidirectional: use the shorter distance
+        const auto shorter = bidirectional && (anticlockwise_distance < clockwise_distance);
+        hops_counts[i] = shorter ? anticlockwise_distance : clockwise_distance;
+    }
+}
+
+}  // namespace
+
 Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latency, const bool bidirectional) noexcept
     : bidirectional(bidirectional),
       BasicTopology(npus_count, bandwidth, latency) {
@@ -20,30 +47,9 @@ Ring::Ring(const int npus_count, const Bandwidth bandwidth, const Latency latenc
     basic_topology_type = TopologyBuildingBlock::Ring;
 }
 
-int Ring::compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept {
-    assert(0 <= src && src < npus_count);
-    assert(0 <= dest && dest < npus_count);
-    assert(src != dest);
-
-    // for Ring topology
-    // 1. compute clockwise and anti-clockwise distance
-    // 2. if unidirectional, use clockwise one
-    // 3. if bidirectional, use the shorter one
-
-    // compute clockwise distance
-    auto clockwise_distance = (dest - src);
-    if (clockwise_distance < 0) {
-        clockwise_distance += npus_count;
-    }
-
-    // compute anticlockwise distance
-    const auto anticlockwise_distance = npus_count - clockwise_distance;
-
-    // unidirectional: return clockwise distance
-    if (!bidirectional) {
-        return clockwise_distance;
-    }
-
-    // bidirectional: return shorter distance
-    return (clockwise_distance < anticlockwise_distance) ? clockwise_distance : anticlockwise_distance;
+void Ring::compute_hops_counts(const DeviceId* const srcs,
+                               const DeviceId* const dests,
+                               int* const hops_counts,
+                               const size_t count) const noexcept {
+    compute_ring_hops_counts(srcs, dests, hops_counts, count, npus_count, bidirectional);
 }
@@ -4,14 +4,134 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/MultiDimTopology.h"
+#include "common/Vectorize.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
-MultiDimTopology::MultiDimTopology() noexcept : Topology() {
+namespace {
+
+/**
+ * Peel off the address of src and dest in a dimension.
+ *
+ * @param npus_count_divisor number of NPUs of the dimension, as a divisor
+ * @param src_leftovers (in/out) src NPU IDs with the lower dimensions peeled off
+ * @param dest_leftovers (in/out) dest NPU IDs with the lower dimensions peeled off
+ * @param src_local_ids (out) src address in the dimension
+ * @param dest_local_ids (out) dest address in the dimension
+ * @param count number of chunks
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void peel_off_addresses(const FastDivisor npus_count_divisor,
+                        DeviceId* const src_leftovers,
+                        DeviceId* const dest_leftovers,
+                        DeviceId* const src_local_ids,
+                        DeviceId* const dest_local_ids,
+                        const size_t count) noexcept {
+    const auto dim_npus_count = npus_count_divisor.get_divisor();
+    for (auto i = size_t{0}; i < count; i++) {
+        const auto src_quotient = npus_count_divisor.divide(src_leftovers[i]);
+        const auto dest_quotient = npus_count_divisor.divide(dest_leftovers[i]);
+        src_local_ids[i] = src_leftovers[i] - (src_quotient * dim_npus_count);
+        dest_local_ids[i] = dest_leftovers[i] - (dest_quotient * dim_npus_count);
+        src_leftovers[i] = src_quotient;
+        dest_leftovers[i] = dest_quotient;
+    }
+}
+
+/**
+ * Select the dimension for the chunks whose src and dest addresses first differ in it.
+ * A chunk has no dimension selected yet if its hops count is 0.
+ *
+ * @param src_local_ids src address in the dimension
+ * @param dest_local_ids dest address in the dimension
+ * @param dim_hops_counts hops count in the dimension
+ * @param dim_latency latency of the dimension
+ * @param dim_bandwidth bandwidth (or inverse bandwidth) of the dimension
+ * @param hops_counts (in/out) hops count in the selected dimension
+ * @param latencies (in/out) latency of the selected dimension
+ * @param bandwidths (in/out) bandwidth (or inverse bandwidth) of the selected dimension
+ * @param count number of chunks
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void select_dimension(const DeviceId* const src_local_ids,
+                      const DeviceId* const dest_local_ids,
+                      const int* const dim_hops_counts,
+                      const Latency dim_latency,
+                      const double dim_bandwidth,
+                      int* const hops_counts,
+                      Latency* const latencies,
+                      double* const bandwidths,
+                      const size_t count) noexcept {
+    for (auto i = size_t{0}; i < count; i++) {
+        const auto selected = (hops_counts[i] == 0) && (src_local_ids[i] != dest_local_ids[i]);
+        hops_counts[i] = selected ? dim_hops_counts[i] : hops_counts[i];
+        latencies[i] = selected ? dim_latency : latencies[i];
+        bandwidths[i] = selected ? dim_bandwidth : bandwidths[i];
+    }
+}
+
+/**
+ * Count the chunks with no dimension selected, i.e., whose src and dest have the same address.
+ *
+ * @param hops_counts hops count in the selected dimension, or 0 if not selected
+ * @param count number of chunks
+ * @return number of chunks with no dimension selected
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+size_t count_unselected(const int* const hops_counts, const size_t count) noexcept {
+    auto unselected_count = size_t{0};
+    for (auto i = size_t{0}; i < count; i++) {
+        unselected_count += (hops_counts[i] == 0) ? 1 : 0;
+    }
+    return unselected_count;
+}
+
+/**
+ * Compute the communication delay of each chunk, as BasicTopology::compute_communication_delay does.
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void compute_communication_delays(const int* const hops_counts,
+                                  const Latency* const latencies,
+                                  const Bandwidth* const bandwidths_Bpns,
+                                  const ChunkSize* const chunk_sizes,
+                                  EventTime* const delays,
+                                  const size_t count) noexcept {
+    for (auto i = size_t{0}; i < count; i++) {
+        const auto link_delay = hops_counts[i] * latencies[i];
+        const auto serialization_delay = static_cast<double>(chunk_sizes[i]) / bandwidths_Bpns[i];
+        delays[i] = static_cast<EventTime>(link_delay + serialization_delay);
+    }
+}
+
+/**
+ * Compute the communication delay of each chunk in the precomputed mode,
+ * as BasicTopology::send_precomputed does.
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void compute_communication_delays_precomputed(const int* const hops_counts,
+                                              const Latency* const latencies,
+                                              const double* const inverse_bandwidths_nspB,
+                                              const ChunkSize* const chunk_sizes,
+                                              EventTime* const delays,
+                                              const size_t count) noexcept {
+    for (auto i = size_t{0}; i < count; i++) {
+        const auto delay = std::fma(static_cast<double>(hops_counts[i]), latencies[i],
+                                    static_cast<double>(chunk_sizes[i]) * inverse_bandwidths_nspB[i]);
+        delays[i] = static_cast<EventTime>(delay);
+    }
+}
+
+}  // namespace
+
+MultiDimTopology::MultiDimTopology() noexcept : Topology(), precomputed(false) {
     // initialize values
     topology_per_dim.clear();
     npus_count_per_dim = {};
@@ -22,91 +142,178 @@ MultiDimTopology::MultiDimTopology() noexcept : Topology() {
 }
 
 EventTime MultiDimTopology::send(const DeviceId src, const DeviceId dest, const ChunkSize chunk_size) const noexcept {
-    // translate src and dest to multi-dim address
-    const auto src_address = translate_address(src);
-    const auto dest_address = translate_address(dest);
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
 
-    // get dim to transfer
-    const auto dim_to_transfer = get_dim_to_transfer(src_address, dest_address);
+    // peel off the address of src and dest dimension by dimension, from the lowest one
+    // e.g., if the topology size is [2, 8, 4], NPU 47 has the address [1, 7, 2]
+    auto src_leftover = src;
+    auto dest_leftover = dest;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        // get the address in this dimension
+        const auto& npus_count_divisor = npus_count_divisor_per_dim[dim];
+        const auto src_quotient = npus_count_divisor.divide(src_leftover);
+        const auto dest_quotient = npus_count_divisor.divide(dest_leftover);
+        const auto src_local_id = src_leftover - (src_quotient * npus_count_divisor.get_divisor());
+        const auto dest_local_id = dest_leftover - (dest_quotient * npus_count_divisor.get_divisor());
 
-    // prepare localized topology and address info
-    auto* const topology = topology_per_dim[dim_to_transfer].get();
-    const auto src_local_id = src_address[dim_to_transfer];
-    const auto dest_local_id = dest_address[dim_to_transfer];
+        // the first dim that has different address is the dim to transfer
+        if (src_local_id != dest_local_id) {
+            // run localized communication
+            const auto* const topology = topology_per_dim[dim].get();
+            if (precomputed) {
+                return topology->send_precomputed(src_local_id, dest_local_id, chunk_size);
+            }
+            return topology->send(src_local_id, dest_local_id, chunk_size);
+        }
 
-    // run localized communication
-    const auto comms_delay = topology->send(src_local_id, dest_local_id, chunk_size);
+        // move on to the next dimension
+        src_leftover = src_quotient;
+        dest_leftover = dest_quotient;
+    }
 
-    // return communication delay
-    return comms_delay;
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
+              << std::endl;
+    std::exit(-1);
 }
 
-void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology) noexcept {
-    // increment dims_count
-    dims_count++;
+void MultiDimTopology::send_batch(const DeviceId* const srcs,
+                                  const DeviceId* const dests,
+                                  const ChunkSize* const chunk_sizes,
+                                  EventTime* const delays,
+                                  const size_t count) const noexcept {
+    assert(count == 0 || (srcs != nullptr && dests != nullptr && chunk_sizes != nullptr && delays != nullptr));
 
-    // increase npus_count
-    const auto topology_size = topology->get_npus_count();
-    npus_count *= topology_size;
+    auto src_leftovers = std::array<DeviceId, batch_block_size>();
+    auto dest_leftovers = std::array<DeviceId, batch_block_size>();
+    auto src_local_ids = std::array<DeviceId, batch_block_size>();
+    auto dest_local_ids = std::array<DeviceId, batch_block_size>();
+    auto dim_hops_counts = std::array<int, batch_block_size>();
+    auto hops_counts = std::array<int, batch_block_size>();
+    auto latencies = std::array<Latency, batch_block_size>();
+    auto bandwidths = std::array<double, batch_block_size>();
 
-    // append bandwidth
-    const auto bandwidth = topology->get_bandwidth_per_dim()[0];
-    bandwidth_per_dim.push_back(bandwidth);
+    for (auto begin = size_t{0}; begin < count; begin += batch_block_size) {
+        const auto block_size = std::min(batch_block_size, count - begin);
+        for (auto i = begin; i < begin + block_size; i++) {
+            assert(0 <= srcs[i] && srcs[i] < npus_count);
+            assert(0 <= dests[i] && dests[i] < npus_count);
+        }
 
-    // push back topology and npus_count
-    topology_per_dim.push_back(std::move(topology));
-    npus_count_per_dim.push_back(topology_size);
-}
+        // peel off the address of src and dest dimension by dimension, from the lowest one
+        std::copy_n(srcs + begin, block_size, src_leftovers.begin());
+        std::copy_n(dests + begin, block_size, dest_leftovers.begin());
+        std::fill_n(hops_counts.begin(), block_size, 0);
+        for (auto dim = 0; dim < dims_count; dim++) {
+            // the leftover is the address in the highest dimension as is
+            const auto highest_dim = (dim == dims_count - 1);
+            if (!highest_dim) {
+                peel_off_addresses(npus_count_divisor_per_dim[dim], src_leftovers.data(), dest_leftovers.data(),
+                                   src_local_ids.data(), dest_local_ids.data(), block_size);
+            }
+            const auto* const dim_src_ids = highest_dim ? src_leftovers.data() : src_local_ids.data();
+            const auto* const dim_dest_ids = highest_dim ? dest_leftovers.data() : dest_local_ids.data();
+
+            // the first dim that has different address is the dim to transfer
+            const auto* const topology = topology_per_dim[dim].get();
+            topology->compute_hops_counts(dim_src_ids, dim_dest_ids, dim_hops_counts.data(), block_size);
+            const auto bandwidth_Bpns = topology->get_bandwidth_Bpns();
+            const auto bandwidth = precomputed ? (1.0 / bandwidth_Bpns) : bandwidth_Bpns;
+            select_dimension(dim_src_ids, dim_dest_ids, dim_hops_counts.data(), topology->get_latency(), bandwidth,
+                             hops_counts.data(), latencies.data(), bandwidths.data(), block_size);
+        }
 
-MultiDimTopology::MultiDimAddress MultiDimTopology::translate_address(const DeviceId npu_id) const noexcept {
-    // If units-count if [2, 8, 4], and the given id is 47, then the id should be
-    // 47 // 16 = 2, leftover = 47 % 16 = 15
-    // 15 // 2 = 7, leftover = 15 % 2 = 1
-    // 1 // 1 = 1, leftover = 0
-    // therefore the address is [1, 7, 2]
-
-    // create empty address
-    auto multi_dim_address = MultiDimAddress();
-    for (auto i = 0; i < dims_count; i++) {
-        multi_dim_address.push_back(-1);
+        // every chunk should have a dimension to transfer
+        if (count_unselected(hops_counts.data(), block_size) > 0) {
+            std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
+                      << std::endl;
+            std::exit(-1);
+        }
+
+        // compute communication delays in the selected dimensions
+        if (precomputed) {
+            compute_communication_delays_precomputed(hops_counts.data(), latencies.data(), bandwidths.data(),
+                                                     chunk_sizes + begin, delays + begin, block_size);
+        } else {
+            compute_communication_delays(hops_counts.data(), latencies.data(), bandwidths.data(), chunk_sizes + begin,
+                                         delays + begin, block_size);
+        }
     }
+}
 
-    auto leftover = npu_id;
-    auto denominator = npus_count;
+void MultiDimTopology::compute_delay_row(const DeviceId src,
+                                         const ChunkSize chunk_size,
+                                         EventTime* const delays) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(delays != nullptr);
 
-    for (auto dim = dims_count - 1; dim >= 0; dim--) {
-        // change denominator
-        denominator /= npus_count_per_dim[dim];
+    // get the address of src in each dimension
+    auto src_address = std::vector<DeviceId>(dims_count);
+    auto src_leftover = src;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        const auto& npus_count_divisor = npus_count_divisor_per_dim[dim];
+        const auto src_quotient = npus_count_divisor.divide(src_leftover);
+        src_address[dim] = src_leftover - (src_quotient * npus_count_divisor.get_divisor());
+        src_leftover = src_quotient;
+    }
+
+    // start from the row of the highest dimension
+    const auto highest_dim = dims_count - 1;
+    topology_per_dim[highest_dim]->compute_delay_row(src_address[highest_dim], chunk_size, delays);
+    auto expanded_count = static_cast<size_t>(npus_count_per_dim[highest_dim]);
 
-        // get and update address
-        const auto quotient = leftover / denominator;
-        leftover %= denominator;
+    // expand each entry into a block of the lower dimension, in place from the back:
+    // dests whose address differs from src in the dimension take the delay of the dimension,
+    // while the dest having the same address keeps the delay of the higher dimensions
+    auto dim_delays = std::vector<EventTime>();
+    for (auto dim = highest_dim - 1; dim >= 0; dim--) {
+        const auto dim_npus_count = static_cast<size_t>(npus_count_per_dim[dim]);
+        dim_delays.resize(dim_npus_count);
+        topology_per_dim[dim]->compute_delay_row(src_address[dim], chunk_size, dim_delays.data());
 
-        // update address
-        multi_dim_address[dim] = quotient;
+        for (auto block = expanded_count; block-- > 0;) {
+            const auto higher_dims_delay = delays[block];
+            auto* const block_delays = delays + (block * dim_npus_count);
+            std::copy(dim_delays.begin(), dim_delays.end(), block_delays);
+            block_delays[src_address[dim]] = higher_dims_delay;
+        }
+        expanded_count *= dim_npus_count;
     }
+    assert(expanded_count == npus_count);
+}
 
-    // check address translation
-    for (auto i = 0; i < dims_count; i++) {
-        assert(0 <= multi_dim_address[i]);
-        assert(multi_dim_address[i] < npus_count_per_dim[i]);
+size_t MultiDimTopology::precompute_delays(const size_t max_tables_bytes) noexcept {
+    // tabulate lower dimensions first, within the remaining bound
+    auto tables_bytes = size_t{0};
+    for (auto& topology : topology_per_dim) {
+        tables_bytes += topology->precompute_delays(max_tables_bytes - tables_bytes);
     }
+    assert(tables_bytes <= max_tables_bytes);
 
-    // return retrieved address
-    return multi_dim_address;
+    precomputed = true;
+    return tables_bytes;
 }
 
-int MultiDimTopology::get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept {
-    for (auto dim = 0; dim < dims_count; dim++) {
-        // check the dim that has different address
-        if (src_address[dim] != dest_address[dim]) {
-            return dim;
-        }
+void MultiDimTopology::append_dimension(std::unique_ptr<BasicTopology> topology) noexcept {
+    // increment dims_count
+    dims_count++;
+
+    // increase npus_count
+    const auto topology_size = topology->get_npus_count();
+    npus_count *= topology_size;
+
+    // append bandwidth
+    const auto bandwidth = topology->get_bandwidth_per_dim()[0];
+    bandwidth_per_dim.push_back(bandwidth);
+
+    // the dimension follows the precomputed mode
+    if (precomputed) {
+        topology->precompute_delays(0);
     }
 
-    // shouldn't reach here
-    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
-              << std::endl;
-    std::exit(-1);
+    // push back topology and npus_count
+    topology_per_dim.push_back(std::move(topology));
+    npus_count_per_dim.push_back(topology_size);
+    npus_count_divisor_per_dim.emplace_back(topology_size);
 }
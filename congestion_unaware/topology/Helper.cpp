@@ -8,13 +8,80 @@ LICENSE file in the root directory of this source tree.
 #include "congestion_unaware/FullyConnected.h"
 #include "congestion_unaware/MultiDimTopology.h"
 #include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
 #include "congestion_unaware/Switch.h"
 #include <cstdlib>
 #include <iostream>
+#include <utility>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
+#ifdef NETWORK_BACKEND_STATIC_TOPOLOGY
+namespace {
+
+/// multi-dimensional topology whose shape is fixed at compile time
+using StaticTopology = StaticMultiDimTopology<NETWORK_BACKEND_STATIC_TOPOLOGY>;
+
+/**
+ * Construct the static topology from a NetworkParser, if the network has the same shape.
+ *
+ * @param network_parser NetworkParser to parse the network input file
+ * @return pointer to the constructed topology, or nullptr if the network has another shape
+ */
+template <typename... Dims, size_t... Dim>
+std::shared_ptr<Topology> construct_static_topology(const NetworkParser& network_parser,
+                                                    std::index_sequence<Dim...>) noexcept {
+    // check the number of dimensions
+    if (network_parser.get_dims_count() != static_cast<int>(sizeof...(Dims))) {
+        return nullptr;
+    }
+
+    // create each dimension and check its building block
+    const auto topologies_per_dim = network_parser.get_topologies_per_dim();
+    const auto npus_counts_per_dim = network_parser.get_npus_counts_per_dim();
+    const auto bandwidths_per_dim = network_parser.get_bandwidths_per_dim();
+    const auto latencies_per_dim = network_parser.get_latencies_per_dim();
+    auto topology = std::make_shared<StaticMultiDimTopology<Dims...>>(
+        Dims(npus_counts_per_dim[Dim], bandwidths_per_dim[Dim], latencies_per_dim[Dim])...);
+    if (((topology->template get_dim<Dim>().get_basic_topology_type() != topologies_per_dim[Dim]) || ...)) {
+        return nullptr;
+    }
+
+    return topology;
+}
+
+/**
+ * Construct the static topology from a NetworkParser, if the network has the same shape.
+ */
+template <typename... Dims>
+std::shared_ptr<Topology> construct_static_topology(const NetworkParser& network_parser,
+                                                    StaticMultiDimTopology<Dims...>*) noexcept {
+    return construct_static_topology<Dims...>(network_parser, std::index_sequence_for<Dims...>());
+}
+
+}  // namespace
+#endif
+
+std::unique_ptr<BasicTopology> NetworkAnalyticalCongestionUnaware::construct_basic_topology(
+    const TopologyBuildingBlock topology_type,
+    const int npus_count,
+    const Bandwidth bandwidth,
+    const Latency latency) noexcept {
+    switch (topology_type) {
+    case TopologyBuildingBlock::Ring:
+        return std::make_unique<Ring>(npus_count, bandwidth, latency);
+    case TopologyBuildingBlock::Switch:
+        return std::make_unique<Switch>(npus_count, bandwidth, latency);
+    case TopologyBuildingBlock::FullyConnected:
+        return std::make_unique<FullyConnected>(npus_count, bandwidth, latency);
+    default:
+        // shouldn't reach here
+        std::cerr << "[Error] (network/analytical/congestion_unaware)" << "Not supported basic-topology" << std::endl;
+        std::exit(-1);
+    }
+}
+
 std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology(
     const NetworkParser& network_parser) noexcept {
     // get network_parser info
@@ -24,27 +91,17 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
     const auto bandwidths_per_dim = network_parser.get_bandwidths_per_dim();
     const auto latencies_per_dim = network_parser.get_latencies_per_dim();
 
+#ifdef NETWORK_BACKEND_STATIC_TOPOLOGY
+    // use the static topology if the network has its shape
+    if (auto static_topology = construct_static_topology(network_parser, static_cast<StaticTopology*>(nullptr))) {
+        return static_topology;
+    }
+#endif
+
     // if dims_count is 1, just create basic topology
     if (dims_count == 1) {
-        // retrieve basic topology info
-        const auto topology_type = topologies_per_dim[0];
-        const auto npus_count = npus_counts_per_dim[0];
-        const auto bandwidth = bandwidths_per_dim[0];
-        const auto latency = latencies_per_dim[0];
-
-        // create and return basic topology
-        switch (topology_type) {
-        case TopologyBuildingBlock::Ring:
-            return std::make_shared<Ring>(npus_count, bandwidth, latency);
-        case TopologyBuildingBlock::Switch:
-            return std::make_shared<Switch>(npus_count, bandwidth, latency);
-        case TopologyBuildingBlock::FullyConnected:
-            return std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
-        default:
-            // shouldn't reach here
-            std::cerr << "[Error] (network/analytical/congestion_unaware)" << "Not supported topology" << std::endl;
-            std::exit(-1);
-        }
+        return construct_basic_topology(topologies_per_dim[0], npus_counts_per_dim[0], bandwidths_per_dim[0],
+                                        latencies_per_dim[0]);
     }
 
     // otherwise, create multi-dim basic-topology
@@ -52,32 +109,8 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionUnaware::construct_topology
 
     // create and append dims
     for (auto dim = 0; dim < dims_count; dim++) {
-        // retrieve info
-        const auto topology_type = topologies_per_dim[dim];
-        const auto npus_count = npus_counts_per_dim[dim];
-        const auto bandwidth = bandwidths_per_dim[dim];
-        const auto latency = latencies_per_dim[dim];
-
-        // create a network dim
-        std::unique_ptr<BasicTopology> dim_topology;
-        switch (topology_type) {
-        case TopologyBuildingBlock::Ring:
-            dim_topology = std::make_unique<Ring>(npus_count, bandwidth, latency);
-            break;
-        case TopologyBuildingBlock::Switch:
-            dim_topology = std::make_unique<Switch>(npus_count, bandwidth, latency);
-            break;
-        case TopologyBuildingBlock::FullyConnected:
-            dim_topology = std::make_unique<FullyConnected>(npus_count, bandwidth, latency);
-            break;
-        default:
-            // shouldn't reach here
-            std::cerr << "[Error] (network/analytical/congestion_unaware)" << "Not supported basic-topology"
-                      << std::endl;
-            std::exit(-1);
-        }
-
-        // append network dimension
+        auto dim_topology = construct_basic_topology(topologies_per_dim[dim], npus_counts_per_dim[dim],
+                                                     bandwidths_per_dim[dim], latencies_per_dim[dim]);
         multi_dim_topology->append_dimension(std::move(dim_topology));
     }
 
@@ -0,0 +1,170 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_unaware/MultiConfigTopology.h"
+#include "common/NetworkFunction.h"
+#include "common/Vectorize.h"
+#include "congestion_unaware/Helper.h"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionUnaware;
+
+namespace {
+
+/**
+ * Compute the communication delay of a chunk in each configuration,
+ * as BasicTopology::compute_communication_delay does.
+ *
+ * @param hops_count number of hops between src and dest
+ * @param chunk_size size of the chunk
+ * @param latencies latency of each configuration
+ * @param bandwidths_Bpns bandwidth of each configuration
+ * @param delays (out) communication delay in each configuration
+ * @param configs_count number of configurations
+ */
+NETWORK_ANALYTICAL_VECTORIZE
+void compute_communication_delays(const int hops_count,
+                                  const ChunkSize chunk_size,
+                                  const Latency* const latencies,
+                                  const Bandwidth* const bandwidths_Bpns,
+                                  EventTime* const delays,
+                                  const size_t configs_count) noexcept {
+    const auto chunk_size_bytes = static_cast<double>(chunk_size);
+    for (auto config = size_t{0}; config < configs_count; config++) {
+        const auto link_delay = hops_count * latencies[config];
+        const auto serialization_delay = chunk_size_bytes / bandwidths_Bpns[config];
+        delays[config] = static_cast<EventTime>(link_delay + serialization_delay);
+    }
+}
+
+}  // namespace
+
+MultiConfigTopology::MultiConfigTopology(const NetworkParser& network_parser) noexcept
+    : MultiConfigTopology(network_parser.get_topologies_per_dim(),
+                          network_parser.get_npus_counts_per_dim(),
+                          network_parser.get_bandwidths_per_dim(),
+                          network_parser.get_latencies_per_dim()) {}
+
+MultiConfigTopology::MultiConfigTopology(const std::vector<TopologyBuildingBlock>& topologies_per_dim,
+                                         const std::vector<int>& npus_counts_per_dim,
+                                         const std::vector<Bandwidth>& bandwidths_per_dim,
+                                         const std::vector<Latency>& latencies_per_dim) noexcept
+    : npus_count(1),
+      dims_count(static_cast<int>(topologies_per_dim.size())),
+      configs_count(0) {
+    assert(dims_count > 0);
+
+    // check the shape and the first configuration have every dimension
+    const auto dims_count_size = static_cast<size_t>(dims_count);
+    if (npus_counts_per_dim.size() != dims_count_size || bandwidths_per_dim.size() != dims_count_size ||
+        latencies_per_dim.size() != dims_count_size) {
+        std::cerr << "[Error] (network/analytical/congestion_unaware): "
+                  << "topology should have the npus count, bandwidth, and latency of each dimension" << std::endl;
+        std::exit(-1);
+    }
+
+    // create the shape of each dimension
+    for (auto dim = 0; dim < dims_count; dim++) {
+        topology_per_dim.push_back(construct_basic_topology(topologies_per_dim[dim], npus_counts_per_dim[dim],
+                                                            bandwidths_per_dim[dim], latencies_per_dim[dim]));
+        npus_count_divisor_per_dim.emplace_back(npus_counts_per_dim[dim]);
+        npus_count *= npus_counts_per_dim[dim];
+    }
+    this->latencies_per_dim.resize(dims_count);
+    bandwidths_Bpns_per_dim.resize(dims_count);
+
+    // the given bandwidth and latency are the first configuration
+    add_config(bandwidths_per_dim, latencies_per_dim);
+}
+
+int MultiConfigTopology::add_config(const std::vector<Bandwidth>& bandwidths_per_dim,
+                                    const std::vector<Latency>& latencies_per_dim) noexcept {
+    // check the configuration has every dimension
+    if (bandwidths_per_dim.size() != static_cast<size_t>(dims_count) ||
+        latencies_per_dim.size() != static_cast<size_t>(dims_count)) {
+        std::cerr << "[Error] (network/analytical/congestion_unaware): "
+                  << "configuration should have the bandwidth and latency of each dimension" << std::endl;
+        std::exit(-1);
+    }
+
+    // append the configuration to each dimension
+    for (auto dim = 0; dim < dims_count; dim++) {
+        assert(bandwidths_per_dim[dim] > 0);
+        assert(latencies_per_dim[dim] >= 0);
+
+        this->latencies_per_dim[dim].push_back(latencies_per_dim[dim]);
+        bandwidths_Bpns_per_dim[dim].push_back(bw_GBps_to_Bpns(bandwidths_per_dim[dim]));
+    }
+
+    return configs_count++;
+}
+
+void MultiConfigTopology::send(const DeviceId src,
+                               const DeviceId dest,
+                               const ChunkSize chunk_size,
+                               EventTime* const delays) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+    assert(chunk_size > 0);
+    assert(delays != nullptr);
+
+    // peel off the address of src and dest dimension by dimension, from the lowest one,
+    // once for every configuration
+    auto src_leftover = src;
+    auto dest_leftover = dest;
+    for (auto dim = 0; dim < dims_count; dim++) {
+        // get the address in this dimension
+        const auto& npus_count_divisor = npus_count_divisor_per_dim[dim];
+        const auto src_quotient = npus_count_divisor.divide(src_leftover);
+        const auto dest_quotient = npus_count_divisor.divide(dest_leftover);
+        const auto src_local_id = src_leftover - (src_quotient * npus_count_divisor.get_divisor());
+        const auto dest_local_id = dest_leftover - (dest_quotient * npus_count_divisor.get_divisor());
+
+        // the first dim that has different address is the dim to transfer
+        if (src_local_id != dest_local_id) {
+            const auto hops_count = topology_per_dim[dim]->compute_hops_count(src_local_id, dest_local_id);
+            compute_communication_delays(hops_count, chunk_size, latencies_per_dim[dim].data(),
+                                         bandwidths_Bpns_per_dim[dim].data(), delays, configs_count);
+            return;
+        }
+
+        // move on to the next dimension
+        src_leftover = src_quotient;
+        dest_leftover = dest_quotient;
+    }
+
+    // shouldn't reach here
+    std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
+              << std::endl;
+    std::exit(-1);
+}
+
+void MultiConfigTopology::send_batch(const DeviceId* const srcs,
+                                     const DeviceId* const dests,
+                                     const ChunkSize* const chunk_sizes,
+                                     EventTime* const delays,
+                                     const size_t count) const noexcept {
+    assert(count == 0 || (srcs != nullptr && dests != nullptr && chunk_sizes != nullptr && delays != nullptr));
+
+    // each chunk fills a row of configurations
+    for (auto i = size_t{0}; i < count; i++) {
+        send(srcs[i], dests[i], chunk_sizes[i], delays + (i * configs_count));
+    }
+}
+
+int MultiConfigTopology::get_configs_count() const noexcept {
+    assert(configs_count > 0);
+
+    return configs_count;
+}
+
+int MultiConfigTopology::get_npus_count() const noexcept {
+    assert(npus_count > 0);
+
+    return npus_count;
+}
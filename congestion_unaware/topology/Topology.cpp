@@ -4,13 +4,86 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_unaware/Topology.h"
+#include "common/ThreadPool.h"
 #include <cassert>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
 Topology::Topology() noexcept : npus_count(-1), dims_count(-1) {}
 
+void Topology::send_batch(const DeviceId* const srcs,
+                          const DeviceId* const dests,
+                          const ChunkSize* const chunk_sizes,
+                          EventTime* const delays,
+                          const size_t count) const noexcept {
+    assert(count == 0 || (srcs != nullptr && dests != nullptr && chunk_sizes != nullptr && delays != nullptr));
+
+    // send chunks one by one
+    for (auto i = size_t{0}; i < count; i++) {
+        delays[i] = send(srcs[i], dests[i], chunk_sizes[i]);
+    }
+}
+
+void Topology::compute_delay_matrix(const std::vector<ChunkSize>& chunk_sizes,
+                                    const std::string& path,
+                                    const int threads_count) const noexcept {
+    assert(threads_count >= 0);
+
+    // create the file
+    const auto npus = static_cast<size_t>(get_npus_count());
+    const auto rows_count = chunk_sizes.size() * npus;
+    const auto file_size = rows_count * npus * sizeof(EventTime);
+    const auto fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(file_size)) != 0) {
+        std::cerr << "[Error] (network/analytical/congestion_unaware): " << "cannot create the delay matrix file "
+                  << path << std::endl;
+        std::exit(-1);
+    }
+    if (file_size == 0) {
+        close(fd);
+        return;
+    }
+
+    // map the file, so that rows are written back to the file by the kernel rather than held in memory
+    auto* const mapped = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        std::cerr << "[Error] (network/analytical/congestion_unaware): " << "cannot map the delay matrix file " << path
+                  << std::endl;
+        std::exit(-1);
+    }
+    auto* const matrices = static_cast<EventTime*>(mapped);
+
+    // compute rows in parallel
+    auto thread_pool = ThreadPool(threads_count);
+    thread_pool.parallel_for(rows_count, [&](const size_t row, int) {
+        const auto chunk_size = chunk_sizes[row / npus];
+        const auto src = static_cast<DeviceId>(row % npus);
+        compute_delay_row(src, chunk_size, matrices + (row * npus));
+    });
+
+    // flush and close the file
+    msync(mapped, file_size, MS_SYNC);
+    munmap(mapped, file_size);
+    close(fd);
+}
+
+void Topology::compute_delay_row(const DeviceId src,
+                                 const ChunkSize chunk_size,
+                                 EventTime* const delays) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(delays != nullptr);
+
+    for (auto dest = 0; dest < npus_count; dest++) {
+        delays[dest] = (dest == src) ? 0 : send(src, dest, chunk_size);
+    }
+}
+
 int Topology::get_npus_count() const noexcept {
     assert(npus_count > 0);
 
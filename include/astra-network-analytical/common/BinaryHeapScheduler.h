@@ -0,0 +1,55 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventScheduler.h"
+#include "common/Type.h"
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * BinaryHeapScheduler keeps pending events in a binary min-heap.
+ * Both push and pop take O(log n).
+ */
+class BinaryHeapScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    BinaryHeapScheduler() noexcept;
+
+    /**
+     * Implementation of push method of EventScheduler.
+     */
+    void push(ScheduledEvent event) noexcept override;
+
+    /**
+     * Implementation of pop method of EventScheduler.
+     */
+    [[nodiscard]] ScheduledEvent pop() noexcept override;
+
+    /**
+     * Implementation of peek_time method of EventScheduler.
+     */
+    [[nodiscard]] EventTime peek_time() const noexcept override;
+
+    /**
+     * Implementation of peek method of EventScheduler.
+     */
+    [[nodiscard]] const ScheduledEvent& peek() const noexcept override;
+
+    /**
+     * Implementation of reset method of EventScheduler.
+     */
+    void reset(EventTime time) noexcept override;
+
+  private:
+    /// heap of scheduled entries, the earliest entry is at the front
+    std::vector<ScheduledEvent> heap;
+};
+
+}  // namespace NetworkAnalytical
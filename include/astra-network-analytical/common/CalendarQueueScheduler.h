@@ -0,0 +1,133 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventScheduler.h"
+#include "common/Type.h"
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * CalendarQueueScheduler implements the calendar queue
+ * (R. Brown, "Calendar Queues", CACM 1988).
+ *
+ * Time is split into days of bucket_width ns,
+ * and a year of buckets_count days wraps around the bucket array.
+ * An entry is kept (sorted) in the bucket of its day,
+ * so both push and pop take O(1) on average
+ * as long as the bucket width follows the average event spacing.
+ * The calendar is resized whenever the number of entries
+ * grows beyond twice or shrinks below half the number of buckets,
+ * and the bucket width is re-estimated whenever the earliest entry is more than a year ahead.
+ */
+class CalendarQueueScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    CalendarQueueScheduler() noexcept;
+
+    /**
+     * Implementation of push method of EventScheduler.
+     */
+    void push(ScheduledEvent event) noexcept override;
+
+    /**
+     * Implementation of pop method of EventScheduler.
+     */
+    [[nodiscard]] ScheduledEvent pop() noexcept override;
+
+    /**
+     * Implementation of peek_time method of EventScheduler.
+     */
+    [[nodiscard]] EventTime peek_time() const noexcept override;
+
+    /**
+     * Implementation of peek method of EventScheduler.
+     */
+    [[nodiscard]] const ScheduledEvent& peek() const noexcept override;
+
+    /**
+     * Implementation of reset method of EventScheduler.
+     */
+    void reset(EventTime time) noexcept override;
+
+  private:
+    /**
+     * Bucket holds the entries of a day, sorted in (event_time, sequence) order.
+     * Entries before head are already popped.
+     */
+    struct Bucket {
+        /// sorted entries
+        std::vector<ScheduledEvent> events;
+
+        /// index of the earliest entry not popped yet
+        size_t head = 0;
+    };
+
+    /// minimum number of buckets
+    static constexpr size_t min_buckets_count = 2;
+
+    /// number of entries sampled to estimate the bucket width
+    static constexpr size_t width_samples_count = 25;
+
+    /// buckets of the calendar
+    std::vector<Bucket> buckets;
+
+    /// width of a bucket (i.e., a day) in ns
+    EventTime bucket_width;
+
+    /// bucket the last popped entry came from
+    size_t last_bucket;
+
+    /// end time (exclusive) of the day of last_bucket
+    EventTime bucket_top;
+
+    /// event time of the last popped entry
+    EventTime last_time;
+
+    /// buffer holding pending entries while resizing
+    std::vector<ScheduledEvent> resize_buffer;
+
+    /// buffer holding sampled event times while estimating the bucket width
+    std::vector<EventTime> width_samples;
+
+    /**
+     * Find the bucket holding the earliest entry.
+     * The scheduler should not be empty.
+     *
+     * @param searched_directly set to true if no entry was found within a year of days,
+     *    so that every bucket had to be searched
+     * @return index of the bucket holding the earliest entry
+     */
+    [[nodiscard]] size_t find_earliest_bucket(bool& searched_directly) const noexcept;
+
+    /**
+     * Insert an entry into its bucket, keeping the bucket sorted.
+     *
+     * @param event entry to insert
+     */
+    void insert(ScheduledEvent event) noexcept;
+
+    /**
+     * Rebuild the calendar with the given number of buckets,
+     * re-estimating the bucket width from the pending entries.
+     *
+     * @param new_buckets_count number of buckets of the new calendar
+     */
+    void resize(size_t new_buckets_count) noexcept;
+
+    /**
+     * Estimate the bucket width from the pending entries gathered in resize_buffer,
+     * i.e., three times the average spacing of the earliest entries.
+     *
+     * @return estimated bucket width
+     */
+    [[nodiscard]] EventTime estimate_bucket_width() noexcept;
+};
+
+}  // namespace NetworkAnalytical
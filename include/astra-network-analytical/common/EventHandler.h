@@ -0,0 +1,104 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cassert>
+#include <functional>
+
+namespace NetworkAnalytical {
+
+/**
+ * EventHandlerTraits extracts the object type a typed event handler works on.
+ * A typed handler is either
+ *   - a static function taking the object pointer: "void func(T*)", or
+ *   - a member function of the object: "void T::func()".
+ */
+template <typename HandlerType> struct EventHandlerTraits;
+
+template <typename T> struct EventHandlerTraits<void (*)(T*)> {
+    using Object = T;
+};
+
+template <typename T> struct EventHandlerTraits<void (*)(T*) noexcept> {
+    using Object = T;
+};
+
+template <typename T> struct EventHandlerTraits<void (T::*)()> {
+    using Object = T;
+};
+
+template <typename T> struct EventHandlerTraits<void (T::*)() noexcept> {
+    using Object = T;
+};
+
+/**
+ * EventHandler binds a typed event handler to the C-style Callback interface.
+ *
+ * The address of EventHandler<Handler>::invoke is unique per handler,
+ * so it doubles as the tag of the handler:
+ * an EventDispatcher recognizes the tag and calls the handler directly,
+ * while any other code can still invoke it as a plain Callback.
+ *
+ * @tparam Handler typed event handler
+ */
+template <auto Handler> struct EventHandler {
+    /// object type the handler works on
+    using Object = typename EventHandlerTraits<decltype(Handler)>::Object;
+
+    /**
+     * Invoke the handler with a type-erased object pointer.
+     *
+     * @param object_ptr pointer to the object
+     */
+    static void invoke(const CallbackArg object_ptr) noexcept {
+        assert(object_ptr != nullptr);
+
+        std::invoke(Handler, static_cast<Object*>(object_ptr));
+    }
+
+    /**
+     * Check whether the callback is the tag of this handler.
+     *
+     * @param callback callback to check
+     * @return true if the callback is EventHandler<Handler>::invoke, false otherwise
+     */
+    [[nodiscard]] static bool matches(const Callback callback) noexcept {
+        return callback == &EventHandler::invoke;
+    }
+};
+
+/**
+ * EventDispatcher invokes events, calling the given typed handlers directly
+ * (i.e., without an indirect call, so that the compiler can inline them)
+ * and falling back to the indirect call for any other callback.
+ *
+ * @tparam Handlers typed event handlers to dispatch directly
+ */
+template <auto... Handlers> struct EventDispatcher {
+    /**
+     * Invoke an event.
+     *
+     * @param callback callback of the event
+     * @param callback_arg argument of the callback
+     */
+    static void dispatch(const Callback callback, const CallbackArg callback_arg) noexcept {
+        assert(callback != nullptr);
+
+        // compare the callback against the tag of each handler, in the given order
+        const auto dispatched = (... || (EventHandler<Handlers>::matches(callback) &&
+                                         (std::invoke(Handlers, static_cast<typename EventHandler<Handlers>::Object*>(
+                                                                    callback_arg)),
+                                          true)));
+
+        // not a known handler, invoke the callback as usual
+        if (!dispatched) {
+            (*callback)(callback_arg);
+        }
+    }
+};
+
+}  // namespace NetworkAnalytical
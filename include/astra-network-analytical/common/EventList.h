@@ -5,14 +5,21 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include "common/Event.h"
+#include "common/EventHandler.h"
+#include "common/EventStore.h"
 #include "common/Type.h"
-#include <list>
+#include <cstdint>
+#include <vector>
 
 namespace NetworkAnalytical {
 
 /**
- * EventList encapsulates a number of Events along with its event time.
+ * EventList encapsulates a number of events along with its event time.
+ * Events are referred to by their slots in the EventStore, stored contiguously,
+ * and the storage is kept across reset() so that a reused EventList doesn't allocate.
+ *
+ * The slot of an event is released only when the event is invoked,
+ * so that an event can still be cancelled after being added to the list.
  */
 class EventList {
   public:
@@ -33,22 +40,70 @@ class EventList {
     /**
      * Register an event into the event list.
      *
-     * @param callback callback function pointer
-     * @param callback_arg argument of the callback function
+     * @param slot slot of the event record in the event store
      */
-    void add_event(Callback callback, CallbackArg callback_arg) noexcept;
+    void add_event(EventSlot slot) noexcept;
 
     /**
-     * Invoke all events in the event list.
+     * Invoke all events in the event list in the registered order,
+     * then drop them.
+     *
+     * @param event_store event store holding the event records
+     * @return number of invoked events
+     */
+    uint64_t invoke_events(EventStore& event_store) noexcept;
+
+    /**
+     * Invoke all events in the event list in the registered order,
+     * calling the given typed handlers directly, then drop them.
+     * Events cancelled since registered are dropped without being invoked.
+     *
+     * @tparam Handlers typed event handlers to dispatch directly
+     * @param event_store event store holding the event records
+     * @return number of invoked events
+     */
+    template <auto... Handlers> uint64_t invoke_events(EventStore& event_store) noexcept {
+        auto invoked_events_count = uint64_t{0};
+        for (const auto slot : slots) {
+            // release the slot first, so that the handle of the event goes stale once it's invoked
+            const auto& record = event_store.get(slot);
+            const auto callback = record.callback;
+            const auto callback_arg = record.callback_arg;
+            event_store.release(slot);
+
+            // skip the events cancelled since registered
+            if (callback == nullptr) {
+                continue;
+            }
+            EventDispatcher<Handlers...>::dispatch(callback, callback_arg);
+            invoked_events_count++;
+        }
+
+        // drop invoked events, keeping the storage
+        slots.clear();
+        return invoked_events_count;
+    }
+
+    /**
+     * Drop all events and reuse the event list for a new event time.
+     *
+     * @param new_event_time new event time of the event list
+     */
+    void reset(EventTime new_event_time) noexcept;
+
+    /**
+     * Check whether the event list has no event.
+     *
+     * @return true if no event is registered, false otherwise
      */
-    void invoke_events() noexcept;
+    [[nodiscard]] bool empty() const noexcept;
 
   private:
     /// event time of the event list
     EventTime event_time;
 
-    /// list of registered events
-    std::list<Event> events;
+    /// slots of the registered events
+    std::vector<EventSlot> slots;
 };
 
 }  // namespace NetworkAnalytical
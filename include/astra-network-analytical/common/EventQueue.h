@@ -1,32 +1,320 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
 #pragma once
 
+#include "common/EventHandler.h"
 #include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include "common/EventStore.h"
 #include "common/Type.h"
-#include <queue>
-#include <memory> // For std::shared_ptr
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
 
 namespace NetworkAnalytical {
 
+/**
+ * Counters of an EventQueue.
+ */
+struct EventQueueStats {
+    /// number of events invoked so far
+    uint64_t processed_events_count;
+
+    /// number of events cancelled so far (including the rescheduled ones)
+    uint64_t cancelled_events_count;
+
+    /// number of pending events, excluding the cancelled ones
+    uint64_t pending_events_count;
+
+    /// number of cancelled events still held by the scheduler until they are popped (i.e., tombstones)
+    uint64_t tombstones_count;
+
+    /// ratio of the tombstones to every entry held by the scheduler
+    double tombstone_ratio;
+};
+
+/**
+ * EventQueue manages scheduled events and the simulation time.
+ *
+ * Pending events are kept in an EventScheduler
+ * implementing the selected SchedulingPolicy.
+ * Events are processed in (event time, scheduled order),
+ * so every scheduling policy yields the exact same event order.
+ *
+ * Event records live in a slab (EventStore) and the scheduler only orders small keys,
+ * so scheduling an event takes no heap allocation once the queue reaches its steady state.
+ *
+ * Scheduled events can be cancelled or rescheduled through their EventHandles.
+ * Cancellation is lazy: the record is marked as a tombstone in O(1),
+ * and the scheduler entry is dropped once it reaches the front of the scheduler.
+ */
 class EventQueue {
   public:
-    EventQueue() noexcept;
+    /**
+     * Constructor.
+     *
+     * @param scheduling_policy scheduling policy to order pending events, defaults to BinaryHeap
+     */
+    explicit EventQueue(SchedulingPolicy scheduling_policy = SchedulingPolicy::BinaryHeap) noexcept;
 
+    /**
+     * Get the current simulation time.
+     *
+     * @return current simulation time
+     */
     [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Set the current simulation time,
+     * for an engine invoking the events by itself (e.g., an optimistic simulation, whose time moves back on rollbacks).
+     * No event should be pending. The time may move either forward or backward.
+     *
+     * @param time new current time
+     */
+    void set_current_time(EventTime time) noexcept;
+
+    /**
+     * Check whether all scheduled events are processed.
+     *
+     * @return true if no event is pending, false otherwise
+     */
     [[nodiscard]] bool finished() const noexcept;
 
+    /**
+     * Get the time of the earliest pending event, i.e., the time proceed() would move to.
+     * There should be a pending event.
+     * As cancelled events are dropped lazily, the time of a cancelled event ahead of the current time
+     * may be returned instead, i.e., the time is a lower bound once events are cancelled.
+     *
+     * @return time of the earliest pending event
+     */
+    [[nodiscard]] EventTime peek_next_time() const noexcept;
+
+    /**
+     * Get the number of events invoked so far.
+     *
+     * @return number of invoked events
+     */
+    [[nodiscard]] uint64_t get_processed_events_count() const noexcept;
+
+    /**
+     * Get the scheduling policy of the event queue.
+     *
+     * @return scheduling policy in use
+     */
+    [[nodiscard]] SchedulingPolicy get_scheduling_policy() const noexcept;
+
+    /**
+     * Get the counters of the event queue, e.g., the ratio of the tombstones left by cancelled events.
+     *
+     * @return counters of the event queue
+     */
+    [[nodiscard]] EventQueueStats get_stats() const noexcept;
+
+    /**
+     * Proceed the simulation to the next event time,
+     * and invoke every event scheduled at that time.
+     *
+     * Events sharing the time are gathered into one contiguous batch and invoked in one pass.
+     * Events scheduled at the current time while invoking the batch
+     * are also invoked before returning.
+     */
     void proceed() noexcept;
-    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Proceed the simulation to the next event time,
+     * calling the given typed handlers directly (i.e., without an indirect call).
+     * Events of any other callback are invoked as usual.
+     *
+     * e.g., event_queue.proceed<&Link::link_become_free, &Chunk::chunk_arrived_next_device>();
+     *
+     * @tparam Handlers typed event handlers to dispatch directly
+     */
+    template <auto... Handlers> void proceed() noexcept {
+        // Ensure there are events to process
+        assert(!finished());
+
+        // Update the current time, skipping the cancelled events before the next event
+        drop_cancelled_events(std::numeric_limits<EventTime>::max());
+        assert(scheduler->peek_time() >= current_time);
+        current_time = scheduler->peek_time();
+
+        // Invoke the events of the current time,
+        // including the ones scheduled at the current time by the invoked events
+        while (!scheduler->empty() && scheduler->peek_time() == current_time) {
+            gather_current_events();
+            processed_events_count += current_events.invoke_events<Handlers...>(event_store);
+        }
+    }
+
+    /**
+     * Invoke every event scheduled until the given time (inclusive) in one call,
+     * and move the current time to end_time, e.g., to the end of a co-simulation window.
+     * Events scheduled until end_time by the invoked events are also invoked before returning.
+     *
+     * e.g., event_queue.run_until(window_end);
+     *       event_queue.run_until<&Link::link_become_free, &Chunk::chunk_arrived_next_device>(window_end);
+     *
+     * @tparam Handlers typed event handlers to dispatch directly, as in proceed()
+     * @param end_time time to run until, should not be earlier than the current time
+     */
+    template <auto... Handlers> void run_until(const EventTime end_time) noexcept {
+        assert(end_time >= current_time);
+
+        // invoke the events up to end_time, time by time
+        drop_cancelled_events(end_time);
+        while (!scheduler->empty() && scheduler->peek_time() <= end_time) {
+            proceed<Handlers...>();
+            drop_cancelled_events(end_time);
+        }
+
+        // the window has passed
+        current_time = end_time;
+    }
+
+    /**
+     * Invoke up to the given number of events in one call, in the same order as proceed().
+     * Once the budget runs out, the remaining events of the current time are left to the next call.
+     *
+     * @tparam Handlers typed event handlers to dispatch directly, as in proceed()
+     * @param events_count maximum number of events to invoke
+     * @return number of invoked events, less than events_count only if no event is left
+     */
+    template <auto... Handlers> uint64_t run_events(const uint64_t events_count) noexcept {
+        auto invoked_events_count = uint64_t{0};
+        while (invoked_events_count < events_count && !finished()) {
+            // Update the current time, skipping the cancelled events before the next event
+            drop_cancelled_events(std::numeric_limits<EventTime>::max());
+            assert(scheduler->peek_time() >= current_time);
+            current_time = scheduler->peek_time();
+
+            // Invoke the events of the current time, within the budget
+            gather_current_events(events_count - invoked_events_count);
+            const auto batch_invoked_events_count = current_events.invoke_events<Handlers...>(event_store);
+            processed_events_count += batch_invoked_events_count;
+            invoked_events_count += batch_invoked_events_count;
+        }
+        return invoked_events_count;
+    }
+
+    /**
+     * Schedule an event.
+     *
+     * @param event_time time to invoke the event, should not be earlier than the current time
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     * @return handle of the event, to cancel or reschedule it
+     */
+    EventHandle schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Schedule an event invoking a typed handler.
+     * e.g., event_queue.schedule_event<&Link::link_become_free>(link_free_time, link);
+     *
+     * @tparam Handler typed event handler, either "void func(T*)" or "void T::func()"
+     * @param event_time time to invoke the event, should not be earlier than the current time
+     * @param object object the handler works on
+     * @return handle of the event, to cancel or reschedule it
+     */
+    template <auto Handler>
+    EventHandle schedule_event(const EventTime event_time,
+                               typename EventHandler<Handler>::Object* const object) noexcept {
+        assert(object != nullptr);
+
+        return schedule_event(event_time, &EventHandler<Handler>::invoke, static_cast<CallbackArg>(object));
+    }
+
+    /**
+     * Check whether a scheduled event is still pending, i.e., neither invoked nor cancelled
+     * (including the events of the current time gathered into the batch being invoked).
+     *
+     * @param handle handle of the event
+     * @return true if the event is pending, false otherwise
+     */
+    [[nodiscard]] bool is_pending(EventHandle handle) const noexcept;
+
+    /**
+     * Cancel a pending event in O(1), leaving a tombstone in the scheduler,
+     * or in the batch being invoked if the event has been gathered into it
+     * (e.g., preempted by another event of the same time).
+     * Stale handles (of events invoked or cancelled) are ignored.
+     *
+     * @param handle handle of the event
+     * @return true if the event has been cancelled, false if it wasn't pending
+     */
+    bool cancel(EventHandle handle) noexcept;
+
+    /**
+     * Move a pending event to another time,
+     * ordered as if it was cancelled and scheduled again (i.e., after the events of new_time scheduled so far).
+     * Stale handles are ignored, as in cancel().
+     *
+     * @param handle handle of the event, updated to the new handle once rescheduled
+     * @param new_time time to invoke the event, should not be earlier than the current time
+     * @return true if the event has been rescheduled, false if it wasn't pending
+     */
+    bool reschedule(EventHandle& handle, EventTime new_time) noexcept;
 
   private:
+    /// current simulation time
     EventTime current_time;
 
-    struct EventComparator {
-        bool operator()(const std::shared_ptr<EventList>& a, const std::shared_ptr<EventList>& b) {
-            return a->get_event_time() > b->get_event_time();
+    /// sequence number to be assigned to the next scheduled event
+    uint64_t next_sequence;
+
+    /// number of events invoked so far
+    uint64_t processed_events_count;
+
+    /// number of events cancelled so far
+    uint64_t cancelled_events_count;
+
+    /// number of cancelled events still held by the scheduler
+    uint64_t tombstones_count;
+
+    /// scheduling policy of the event queue
+    SchedulingPolicy scheduling_policy;
+
+    /// pending events, ordered by the scheduler
+    std::unique_ptr<EventScheduler> scheduler;
+
+    /// records of pending events
+    EventStore event_store;
+
+    /// batch of events being invoked at the current time
+    EventList current_events;
+
+    /**
+     * Move the pending events of the current time into current_events,
+     * dropping the tombstones on the way.
+     *
+     * @param max_events_count maximum number of events to move
+     * @return number of moved events
+     */
+    uint64_t gather_current_events(uint64_t max_events_count = std::numeric_limits<uint64_t>::max()) noexcept;
+
+    /**
+     * Drop the cancelled events at the front of the scheduler, up to the given time.
+     * Entries are popped only up to a time the queue is moving to,
+     * as the scheduler takes no entry earlier than the last popped one.
+     *
+     * @param until time up to which the cancelled events are dropped
+     */
+    void drop_cancelled_events(const EventTime until) noexcept {
+        // nothing to drop unless events have been cancelled
+        if (tombstones_count == 0) {
+            return;
         }
-    };
 
-    std::priority_queue<std::shared_ptr<EventList>, std::vector<std::shared_ptr<EventList>>, EventComparator> event_queue;
+        while (!scheduler->empty() && scheduler->peek_time() <= until &&
+               event_store.is_cancelled(scheduler->peek().slot)) {
+            event_store.release(scheduler->pop().slot);
+            tombstones_count--;
+        }
+    }
 };
 
 }  // namespace NetworkAnalytical
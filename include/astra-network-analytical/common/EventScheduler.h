@@ -0,0 +1,144 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventStore.h"
+#include "common/Type.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace NetworkAnalytical {
+
+/**
+ * ScheduledEvent is an entry of the EventScheduler.
+ * Entries are ordered by (event_time, sequence),
+ * so events scheduled at the same time are processed in FIFO order.
+ */
+struct ScheduledEvent {
+    /// time the event should be invoked
+    EventTime event_time;
+
+    /// order in which the event has been scheduled
+    uint64_t sequence;
+
+    /// slot of the EventStore holding the event record
+    EventSlot slot;
+};
+
+/**
+ * Check whether an entry should be processed before another one.
+ *
+ * @param lhs first entry
+ * @param rhs second entry
+ * @return true if lhs should be processed before rhs, false otherwise
+ */
+[[nodiscard]] inline bool precedes(const ScheduledEvent& lhs, const ScheduledEvent& rhs) noexcept {
+    if (lhs.event_time != rhs.event_time) {
+        return lhs.event_time < rhs.event_time;
+    }
+    return lhs.sequence < rhs.sequence;
+}
+
+/**
+ * Check whether an entry should be processed after another one.
+ * std heap algorithms build a max-heap, so this is used as their comparator.
+ *
+ * @param lhs first entry
+ * @param rhs second entry
+ * @return true if lhs should be processed after rhs, false otherwise
+ */
+[[nodiscard]] inline bool follows(const ScheduledEvent& lhs, const ScheduledEvent& rhs) noexcept {
+    return precedes(rhs, lhs);
+}
+
+/**
+ * EventScheduler abstracts the data structure
+ * the EventQueue uses to keep its pending events in order.
+ *
+ * Every implementation must pop entries in the exact (event_time, sequence) order,
+ * so that simulation results do not depend on the selected scheduling policy.
+ */
+class EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    EventScheduler() noexcept;
+
+    /**
+     * Destructor.
+     */
+    virtual ~EventScheduler() noexcept;
+
+    /**
+     * Insert an entry into the scheduler.
+     * The event time should not be smaller than the time of the last popped entry.
+     *
+     * @param event entry to insert
+     */
+    virtual void push(ScheduledEvent event) noexcept = 0;
+
+    /**
+     * Remove and return the earliest entry.
+     * The scheduler should not be empty.
+     *
+     * @return the earliest entry
+     */
+    [[nodiscard]] virtual ScheduledEvent pop() noexcept = 0;
+
+    /**
+     * Get the event time of the earliest entry without removing it.
+     * The scheduler should not be empty.
+     *
+     * @return event time of the earliest entry
+     */
+    [[nodiscard]] virtual EventTime peek_time() const noexcept = 0;
+
+    /**
+     * Get the earliest entry without removing it, i.e., the entry pop() would return.
+     * The scheduler should not be empty.
+     *
+     * @return the earliest entry
+     */
+    [[nodiscard]] virtual const ScheduledEvent& peek() const noexcept = 0;
+
+    /**
+     * Move the time base of an empty scheduler to the given time, either forward or backward,
+     * so that entries can be pushed from that time on (e.g., when the EventQueue is rewound).
+     *
+     * @param time new time base, taken as the time of the last popped entry
+     */
+    virtual void reset(EventTime time) noexcept = 0;
+
+    /**
+     * Check whether the scheduler is empty.
+     *
+     * @return true if no entry is scheduled, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Get the number of scheduled entries.
+     *
+     * @return number of scheduled entries
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * Create a scheduler implementing the given scheduling policy.
+     *
+     * @param scheduling_policy scheduling policy to use
+     * @return pointer to the created scheduler
+     */
+    [[nodiscard]] static std::unique_ptr<EventScheduler> create(SchedulingPolicy scheduling_policy) noexcept;
+
+  protected:
+    /// number of scheduled entries
+    size_t events_count;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,197 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/// Index of an EventRecord slot in the EventStore
+using EventSlot = uint32_t;
+
+/**
+ * EventRecord is a plain record of a scheduled event.
+ */
+struct EventRecord {
+    /// time the event should be invoked
+    EventTime event_time;
+
+    /// order in which the event has been scheduled
+    uint64_t sequence;
+
+    /// pointer to the callback function
+    Callback callback;
+
+    /// argument of the callback function
+    CallbackArg callback_arg;
+
+    /// number of times the slot holding the record has been released,
+    /// telling the handles of the previous records of the slot apart
+    uint32_t generation;
+
+    /// whether the event has left the scheduler for the batch of the current time, to be invoked
+    bool gathered;
+};
+
+/**
+ * EventHandle identifies a scheduled event, to cancel or reschedule it.
+ * A handle goes stale once its event is invoked or cancelled,
+ * as the generation of its slot moves on when the slot is released.
+ */
+struct EventHandle {
+    /// slot holding the event record
+    EventSlot slot;
+
+    /// generation of the slot when the event was scheduled
+    uint32_t generation;
+};
+
+/// handle referring to no event, which is never pending
+constexpr auto invalid_event_handle = EventHandle{std::numeric_limits<EventSlot>::max(), 0};
+
+/**
+ * EventStore is a slab of EventRecords.
+ *
+ * Released slots are recycled through a free list,
+ * so once the slab has grown to the peak number of pending events,
+ * storing an event takes no heap allocation.
+ */
+class EventStore {
+  public:
+    /**
+     * Constructor.
+     */
+    EventStore() noexcept;
+
+    /**
+     * Store an event record.
+     *
+     * @param record record to store
+     * @return slot holding the record
+     */
+    [[nodiscard]] EventSlot allocate(const EventRecord& record) noexcept {
+        // reuse a released slot if one exists, keeping its generation
+        if (!free_slots.empty()) {
+            const auto slot = free_slots.back();
+            free_slots.pop_back();
+            const auto generation = records[slot].generation;
+            records[slot] = record;
+            records[slot].generation = generation;
+            return slot;
+        }
+
+        // otherwise, grow the slab
+        const auto slot = static_cast<EventSlot>(records.size());
+        records.push_back(record);
+        records.back().generation = 0;
+        return slot;
+    }
+
+    /**
+     * Release a slot, so that it can be recycled.
+     * Handles of the released record go stale.
+     *
+     * @param slot slot to release
+     */
+    void release(const EventSlot slot) noexcept {
+        assert(slot < records.size());
+
+        records[slot].generation++;
+        free_slots.push_back(slot);
+    }
+
+    /**
+     * Mark the record of a slot as cancelled (i.e., a tombstone), leaving the slot allocated.
+     *
+     * @param slot slot to cancel
+     */
+    void cancel(const EventSlot slot) noexcept {
+        assert(slot < records.size());
+        assert(records[slot].callback != nullptr);
+
+        records[slot].callback = nullptr;
+    }
+
+    /**
+     * Mark the record of a slot as gathered into the batch of the current time.
+     *
+     * @param slot slot to mark
+     */
+    void gather(const EventSlot slot) noexcept {
+        assert(slot < records.size());
+        assert(!records[slot].gathered);
+
+        records[slot].gathered = true;
+    }
+
+    /**
+     * Check whether the record of a slot is cancelled.
+     *
+     * @param slot slot to check
+     * @return true if the record is a tombstone, false otherwise
+     */
+    [[nodiscard]] bool is_cancelled(const EventSlot slot) const noexcept {
+        assert(slot < records.size());
+
+        return records[slot].callback == nullptr;
+    }
+
+    /**
+     * Check whether a handle refers to an event which is neither invoked nor cancelled yet.
+     *
+     * @param handle handle to check
+     * @return true if the event is pending, false otherwise
+     */
+    [[nodiscard]] bool is_pending(const EventHandle handle) const noexcept {
+        return handle.slot < records.size() && records[handle.slot].generation == handle.generation &&
+               records[handle.slot].callback != nullptr;
+    }
+
+    /**
+     * Get the handle of the record stored in a slot.
+     *
+     * @param slot slot holding the record
+     * @return handle of the record
+     */
+    [[nodiscard]] EventHandle get_handle(const EventSlot slot) const noexcept {
+        assert(slot < records.size());
+
+        return {slot, records[slot].generation};
+    }
+
+    /**
+     * Get the record stored in a slot.
+     *
+     * @param slot slot to read
+     * @return record stored in the slot
+     */
+    [[nodiscard]] const EventRecord& get(const EventSlot slot) const noexcept {
+        assert(slot < records.size());
+
+        return records[slot];
+    }
+
+    /**
+     * Get the number of slots the slab has grown to.
+     *
+     * @return number of slots
+     */
+    [[nodiscard]] size_t get_capacity() const noexcept;
+
+  private:
+    /// slab of event records
+    std::vector<EventRecord> records;
+
+    /// released slots to be recycled
+    std::vector<EventSlot> free_slots;
+};
+
+}  // namespace NetworkAnalytical
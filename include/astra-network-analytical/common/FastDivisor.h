@@ -0,0 +1,78 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+namespace NetworkAnalytical {
+
+/**
+ * FastDivisor divides non-negative 31-bit integers (e.g., device ids) by a fixed divisor
+ * with a multiplication and a shift, using a precomputed magic reciprocal instead of an integer division.
+ *
+ * With shift = 31 + ceil(log2(divisor)) and magic = ceil(2^shift / divisor),
+ * floor(n / divisor) = (n * magic) >> shift holds for every n < 2^31.
+ * The magic fits in 32 bits, so the product is a 32x32->64 bit multiplication,
+ * which vectorizes (e.g., into pmuludq) when dividing an array of numbers.
+ */
+class FastDivisor {
+  public:
+    /**
+     * Constructor, dividing by 1.
+     */
+    FastDivisor() noexcept : FastDivisor(1) {}
+
+    /**
+     * Constructor.
+     *
+     * @param divisor divisor, positive
+     */
+    explicit FastDivisor(const int divisor) noexcept : divisor(static_cast<uint32_t>(divisor)), shift(31) {
+        assert(divisor > 0);
+
+        // shift = 31 + ceil(log2(divisor))
+        while ((uint64_t{1} << (shift - 31)) < this->divisor) {
+            shift++;
+        }
+        const auto magic = ((uint64_t{1} << shift) + this->divisor - 1) / this->divisor;
+        assert(magic <= UINT32_MAX);
+        this->magic = static_cast<uint32_t>(magic);
+    }
+
+    /**
+     * Divide a number by the divisor.
+     *
+     * @param dividend number to divide, in [0, 2^31)
+     * @return quotient
+     */
+    [[nodiscard]] int divide(const int dividend) const noexcept {
+        assert(dividend >= 0);
+
+        return static_cast<int>((static_cast<uint64_t>(static_cast<uint32_t>(dividend)) * magic) >> shift);
+    }
+
+    /**
+     * Get the divisor.
+     *
+     * @return divisor
+     */
+    [[nodiscard]] int get_divisor() const noexcept {
+        return static_cast<int>(divisor);
+    }
+
+  private:
+    /// divisor
+    uint32_t divisor;
+
+    /// shift applied after the multiplication
+    uint32_t shift;
+
+    /// magic reciprocal of the divisor
+    uint32_t magic;
+};
+
+}  // namespace NetworkAnalytical
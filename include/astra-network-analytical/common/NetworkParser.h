@@ -60,6 +60,14 @@ class NetworkParser {
      */
     [[nodiscard]] std::vector<TopologyBuildingBlock> get_topologies_per_dim() const noexcept;
 
+    /**
+     * Read the optional "scheduling_policy" value
+     * and translate it into SchedulingPolicy enum.
+     *
+     * @return scheduling policy of the event queue, BinaryHeap if not specified
+     */
+    [[nodiscard]] SchedulingPolicy get_scheduling_policy() const noexcept;
+
   private:
     /// number of network dimensions
     int dims_count;
@@ -76,6 +84,9 @@ class NetworkParser {
     /// topology building block per each dimension
     std::vector<TopologyBuildingBlock> topology_per_dim;
 
+    /// scheduling policy of the event queue
+    SchedulingPolicy scheduling_policy;
+
     /**
      * Parse topology name (in string) into TopologyBuildingBlock enum
      *
@@ -85,6 +96,16 @@ class NetworkParser {
      */
     [[nodiscard]] static TopologyBuildingBlock parse_topology_name(const std::string& topology_name) noexcept;
 
+    /**
+     * Parse scheduling policy name (in string) into SchedulingPolicy enum
+     *
+     * @param scheduling_policy_name scheduling policy name in string
+     *    which can be "BinaryHeap", "CalendarQueue", or "TimingWheel"
+     * @return parsed SchedulingPolicy enum class value
+     */
+    [[nodiscard]] static SchedulingPolicy parse_scheduling_policy_name(
+        const std::string& scheduling_policy_name) noexcept;
+
     /**
      * Parse the given YAML node and retrieve network configuration values
      *
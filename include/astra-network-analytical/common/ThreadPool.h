@@ -0,0 +1,104 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * ThreadPool runs independent tasks in parallel on a fixed set of worker threads.
+ *
+ * Tasks are indexed from 0, and idle workers grab the next index dynamically,
+ * so that tasks of uneven cost are balanced.
+ * The calling thread takes part as worker 0, so a pool of a single worker spawns no thread.
+ */
+class ThreadPool {
+  public:
+    /// task to run: void task(task index, worker id)
+    using Task = std::function<void(size_t, int)>;
+
+    /**
+     * Constructor.
+     *
+     * @param workers_count number of workers including the calling thread,
+     *                      or 0 to use every hardware thread
+     */
+    explicit ThreadPool(int workers_count = 0) noexcept;
+
+    /**
+     * Destructor, joining the worker threads.
+     */
+    ~ThreadPool() noexcept;
+
+    /**
+     * Run task(i, worker id) for every i in [0, tasks_count), returning once every task has finished.
+     *
+     * @param tasks_count number of tasks
+     * @param task task to run
+     */
+    void parallel_for(size_t tasks_count, const Task& task) noexcept;
+
+    /**
+     * Get the number of workers, including the calling thread.
+     *
+     * @return number of workers
+     */
+    [[nodiscard]] int get_workers_count() const noexcept;
+
+  private:
+    /// worker threads, except the calling thread
+    std::vector<std::thread> threads;
+
+    /// lock protecting the job state below
+    std::mutex mutex;
+
+    /// notifies workers of a new job or stopping
+    std::condition_variable job_started;
+
+    /// notifies the calling thread that every worker is done with the job
+    std::condition_variable job_finished;
+
+    /// task of the current job
+    const Task* task;
+
+    /// number of tasks of the current job
+    size_t tasks_count;
+
+    /// index of the next task to run
+    std::atomic<size_t> next_task;
+
+    /// incremented per job, so that workers run each job once
+    size_t job_id;
+
+    /// number of worker threads still running the current job
+    int running_threads_count;
+
+    /// whether the pool is being destroyed
+    bool stopping;
+
+    /**
+     * Loop of each worker thread.
+     *
+     * @param worker_id id of the worker
+     */
+    void work(int worker_id) noexcept;
+
+    /**
+     * Run tasks of the current job until none remains.
+     *
+     * @param worker_id id of the worker
+     */
+    void run_tasks(int worker_id) noexcept;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,148 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventScheduler.h"
+#include "common/Type.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * TimingWheelScheduler implements a hierarchical timing wheel with 1 ns ticks.
+ *
+ * The wheel has 4 levels of 256 slots each.
+ * A slot of level L spans 256^L ns, so the wheel covers 2^32 ns (~4.3 s) ahead of its cursor,
+ * which comfortably holds the ns-granularity link delays of the simulator.
+ * Entries further in the future wait in an overflow heap until the cursor gets close.
+ *
+ * An entry is placed at the lowest level whose slot window contains both the entry and the cursor.
+ * As the cursor moves into a new slot of a higher level, that slot is cascaded down to the lower levels.
+ * Therefore, each entry is moved at most (levels - 1) times,
+ * and both push and pop take O(1) amortized.
+ *
+ * Level 0 slots only hold entries of a single event time,
+ * appended in the order they are scheduled, which preserves the FIFO order of same-time entries.
+ */
+class TimingWheelScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    TimingWheelScheduler() noexcept;
+
+    /**
+     * Implementation of push method of EventScheduler.
+     */
+    void push(ScheduledEvent event) noexcept override;
+
+    /**
+     * Implementation of pop method of EventScheduler.
+     */
+    [[nodiscard]] ScheduledEvent pop() noexcept override;
+
+    /**
+     * Implementation of peek_time method of EventScheduler.
+     */
+    [[nodiscard]] EventTime peek_time() const noexcept override;
+
+    /**
+     * Implementation of peek method of EventScheduler.
+     */
+    [[nodiscard]] const ScheduledEvent& peek() const noexcept override;
+
+    /**
+     * Implementation of reset method of EventScheduler.
+     */
+    void reset(EventTime time) noexcept override;
+
+  private:
+    /// number of levels of the wheel
+    static constexpr int levels_count = 4;
+
+    /// number of bits addressing the slots of a level
+    static constexpr int slot_bits = 8;
+
+    /// number of slots per level
+    static constexpr int slots_count = 1 << slot_bits;
+
+    /// number of 64-bit words of the slot occupancy bitmap
+    static constexpr int occupancy_words = slots_count / 64;
+
+    /// entries of a slot
+    using Slot = std::vector<ScheduledEvent>;
+
+    /// slots per each level
+    std::array<std::array<Slot, slots_count>, levels_count> slots;
+
+    /// bitmap of non-empty slots per each level
+    std::array<std::array<uint64_t, occupancy_words>, levels_count> occupancy;
+
+    /// cursor of the wheel: no entry is earlier than this time
+    EventTime wheel_time;
+
+    /// number of entries already popped from the level 0 slot under the cursor
+    size_t drained_count;
+
+    /// min-heap of entries beyond the range of the wheel
+    std::vector<ScheduledEvent> overflow;
+
+    /// buffer used while cascading a slot to the lower levels
+    Slot cascade_buffer;
+
+    /**
+     * Place an entry into the wheel (or the overflow heap)
+     * relative to the current cursor.
+     *
+     * @param event entry to place
+     */
+    void place(ScheduledEvent event) noexcept;
+
+    /**
+     * Move the cursor to the earliest entry,
+     * cascading higher-level slots and the overflow heap as needed.
+     * The scheduler should not be empty.
+     */
+    void advance() noexcept;
+
+    /**
+     * Find the first non-empty slot of a level, starting from the given slot.
+     *
+     * @param level level to search
+     * @param from first slot index to check
+     * @return index of the first non-empty slot, or slots_count if there's none
+     */
+    [[nodiscard]] int find_occupied_slot(int level, int from) const noexcept;
+
+    /**
+     * Get the slot index of the given time at the given level.
+     *
+     * @param event_time time to compute the slot index
+     * @param level level of the wheel
+     * @return slot index of the time at the level
+     */
+    [[nodiscard]] static int slot_index(EventTime event_time, int level) noexcept;
+
+    /**
+     * Mark a slot as non-empty.
+     *
+     * @param level level of the slot
+     * @param index index of the slot
+     */
+    void set_occupied(int level, int index) noexcept;
+
+    /**
+     * Mark a slot as empty.
+     *
+     * @param level level of the slot
+     * @param index index of the slot
+     */
+    void clear_occupied(int level, int index) noexcept;
+};
+
+}  // namespace NetworkAnalytical
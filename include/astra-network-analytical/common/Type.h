@@ -33,4 +33,7 @@ using EventTime = uint64_t;
 /// Basic multi-dimensional topology building blocks
 enum class TopologyBuildingBlock { Undefined, Ring, FullyConnected, Switch };
 
+/// Scheduling policies the EventQueue can use to order pending events
+enum class SchedulingPolicy { BinaryHeap, CalendarQueue, TimingWheel };
+
 }  // namespace NetworkAnalytical
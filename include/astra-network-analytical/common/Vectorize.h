@@ -0,0 +1,25 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+/**
+ * NETWORK_ANALYTICAL_VECTORIZE marks a function whose loops should be vectorized for the running CPU.
+ *
+ * On x86-64 Linux with GCC 12 or later, the function is compiled into AVX-512 (x86-64-v4),
+ * AVX2 (x86-64-v3), and baseline clones, and the best one is picked when the program is loaded.
+ * Elsewhere, the function is compiled for the target the build selects (e.g., with -march).
+ * Sanitizer builds (ThreadSanitizer, AddressSanitizer) skip the clones, as their runtimes can't resolve the ifuncs.
+ * Define NETWORK_ANALYTICAL_VECTORIZE as empty to disable the clones.
+ */
+#ifndef NETWORK_ANALYTICAL_VECTORIZE
+    #if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 12) && \
+        !defined(__SANITIZE_THREAD__) && !defined(__SANITIZE_ADDRESS__)
+        #define NETWORK_ANALYTICAL_VECTORIZE \
+            __attribute__((target_clones("arch=x86-64-v4", "arch=x86-64-v3", "default")))
+    #else
+        #define NETWORK_ANALYTICAL_VECTORIZE
+    #endif
+#endif
@@ -42,6 +42,13 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] TopologyBuildingBlock get_basic_topology_type() const noexcept;
 
+    /**
+     * Get the latency of each link.
+     *
+     * @return latency of each link
+     */
+    [[nodiscard]] Latency get_latency() const noexcept;
+
   protected:
     /// bandwidth of each link
     Bandwidth bandwidth;
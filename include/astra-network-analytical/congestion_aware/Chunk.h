@@ -6,16 +6,43 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_aware/Route.h"
 #include "congestion_aware/Type.h"
+#include <cassert>
+#include <cstddef>
 #include <memory>
 
 using namespace NetworkAnalytical;
 
 namespace NetworkAnalyticalCongestionAware {
 
+/**
+ * Position of a chunk along its way to the destination,
+ * saved so that the chunk can be moved back (e.g., when an optimistic simulation rolls back its arrival).
+ */
+struct ChunkCursor {
+    /// id of the current device
+    DeviceId current_id;
+
+    /// id of the next device, -1 if unknown yet or arrived dest
+    DeviceId next_id;
+
+    /// index of the current device in the route of a routed chunk, 0 if routeless
+    size_t route_cursor;
+};
+
 /**
  * Chunk class represents a chunk.
  * Chunk is a basic unit of transmission.
+ *
+ * Chunks are either allocated from the ChunkPool of a topology (see Topology::make_chunk),
+ * or from the heap (e.g., std::make_unique<Chunk>).
+ * Either way, deleting a chunk releases its storage to where it came from.
+ *
+ * A chunk is routed in either of the two modes:
+ *   - routed: the chunk carries its whole route inline, computed upfront (e.g., by Topology::route).
+ *   - routeless: the chunk only carries its current, next, and dest devices,
+ *     and asks the topology for the next hop (Topology::next_hop) whenever it arrives at a device.
  */
 class Chunk {
   public:
@@ -24,12 +51,31 @@ class Chunk {
      *   - if the chunk arrived at its destination, the final callback is invoked
      *   - if not, the chunk is sent to the next device as designated by the route
      *
+     * Typed event handler, taking over the ownership of the chunk.
+     *
      * @param chunk_ptr: pointer to the chunk that's arrived at the next device
      */
-    static void chunk_arrived_next_device(void* chunk_ptr) noexcept;
+    static void chunk_arrived_next_device(Chunk* chunk_ptr) noexcept;
+
+    /**
+     * Allocate the storage of a chunk from the heap,
+     * prefixed with a ChunkHeader telling it's not pooled.
+     *
+     * @param size size of the chunk
+     * @return pointer to the storage
+     */
+    static void* operator new(size_t size);
+
+    /**
+     * Release the storage of a chunk,
+     * to its ChunkPool if pooled, or to the heap otherwise.
+     *
+     * @param ptr pointer to the storage
+     */
+    static void operator delete(void* ptr) noexcept;
 
     /**
-     * Constructor.
+     * Constructor of a routed chunk.
      *
      * @param chunk_size: size of the chunk
      * @param route: route of the chunk from its source to destination
@@ -38,33 +84,107 @@ class Chunk {
      */
     Chunk(ChunkSize chunk_size, Route route, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Constructor of a routeless chunk.
+     * The next hop is known once the topology is set.
+     *
+     * @param chunk_size: size of the chunk
+     * @param src: id of the source device
+     * @param dest: id of the destination device
+     * @param callback: callback to be invoked when the chunk arrives destination
+     * @param callback_arg: argument of the callback
+     */
+    Chunk(ChunkSize chunk_size, DeviceId src, DeviceId dest, Callback callback, CallbackArg callback_arg) noexcept;
+
     /**
      * Get the current sitting device of the chunk
      *
-     * @return current device of the chunk
+     * @return id of the current device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> current_device() const noexcept;
+    [[nodiscard]] DeviceId current_device() const noexcept {
+        return current_id;
+    }
 
     /**
      * Get the next destined device of the chunk
      *
-     * @return next device of the chunk
+     * @return id of the next device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> next_device() const noexcept;
+    [[nodiscard]] DeviceId next_device() const noexcept {
+        // assert the chunk has next dest
+        assert(!arrived_dest());
+        assert(next_id >= 0);
+
+        return next_id;
+    }
+
+    /**
+     * Get the destination device of the chunk
+     *
+     * @return id of the destination device of the chunk
+     */
+    [[nodiscard]] DeviceId dest_device() const noexcept {
+        return dest_id;
+    }
+
+    /**
+     * Set the topology the chunk is transmitted through.
+     *
+     * @param topology_ptr pointer to the topology
+     */
+    void set_topology(Topology* topology_ptr) noexcept;
+
+    /**
+     * Get the topology the chunk is transmitted through.
+     *
+     * @return pointer to the topology
+     */
+    [[nodiscard]] Topology* get_topology() const noexcept;
+
+    /**
+     * Check if the chunk carries its whole route.
+     *
+     * @return true if the chunk is routed, false if routeless
+     */
+    [[nodiscard]] bool is_routed() const noexcept;
+
+    /**
+     * Get the remaining route of a routed chunk,
+     * starting from the current device.
+     *
+     * @return remaining route of the chunk
+     */
+    [[nodiscard]] const Route& get_route() const noexcept;
+
+    /**
+     * Get the position of the chunk along its way to the destination.
+     *
+     * @return current position of the chunk
+     */
+    [[nodiscard]] ChunkCursor get_cursor() const noexcept;
+
+    /**
+     * Move the chunk to a position it has been at before.
+     *
+     * @param cursor position of the chunk, taken by get_cursor()
+     */
+    void set_cursor(const ChunkCursor& cursor) noexcept;
 
     /**
      * Mark the chunk arrived at its next device
-     * i.e., drop the current device from the route
+     * i.e., the next device becomes the current device
      */
     void mark_arrived_next_device() noexcept;
 
     /**
      * Check if the chunk arrived at its destination
-     * i.e., if the route length is 1 (only destination device left)
+     * i.e., if the current device is the dest device
      *
      * @return true if the chunk arrived at its destination, false otherwise
      */
-    [[nodiscard]] bool arrived_dest() const noexcept;
+    [[nodiscard]] bool arrived_dest() const noexcept {
+        return current_id == dest_id;
+    }
 
     /**
      * Get the size of the chunk
@@ -85,17 +205,37 @@ class Chunk {
     /// size of the chunk
     ChunkSize chunk_size;
 
-    /// route of the chunk to its destination.
+    /// route of a routed chunk to its destination, stored inline; empty if routeless.
     /// Route has the structure of [current device, next device, ..., dest device]
     /// e.g., if a chunk starts from device 5, then reaches destination 3,
     /// the route would be e.g., [5, 1, 6, 2, 3]
     Route route;
 
+    /// whether the chunk carries its route
+    bool routed;
+
+    /// topology the chunk is transmitted through
+    Topology* topology;
+
     /// callback to be invoked when the chunk arrives at its destination
     Callback callback;
 
     /// argument of the callback
     CallbackArg callback_arg;
+
+    /// id of the current device
+    DeviceId current_id;
+
+    /// id of the next device, -1 if unknown yet or arrived dest
+    DeviceId next_id;
+
+    /// id of the dest device
+    DeviceId dest_id;
+
+    /**
+     * Find the next device of the chunk, from the route or the topology.
+     */
+    void update_next_device() noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
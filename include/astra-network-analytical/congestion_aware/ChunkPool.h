@@ -0,0 +1,106 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "congestion_aware/Type.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Header placed right before the storage of every chunk,
+ * telling which ChunkPool (if any) the storage should be released to.
+ */
+struct alignas(std::max_align_t) ChunkHeader {
+    /// pool owning the storage, nullptr if allocated from the heap
+    ChunkPool* pool;
+};
+
+/**
+ * Allocation counters of a ChunkPool.
+ */
+struct ChunkPoolStats {
+    /// number of chunks allocated from the pool so far
+    size_t chunks_allocated;
+
+    /// number of chunks alive at the moment
+    size_t chunks_alive;
+
+    /// maximum number of chunks alive at once
+    size_t peak_chunks_alive;
+
+    /// number of heap allocations the pool made, i.e., number of blocks
+    size_t heap_allocations;
+};
+
+/**
+ * ChunkPool is a free list of chunk storages, carved out of fixed-size blocks.
+ *
+ * Released storages are recycled,
+ * so once the pool has grown to the peak number of chunks alive,
+ * allocating a chunk takes no heap allocation.
+ * Blocks are never moved or freed until the pool is destroyed,
+ * hence chunks allocated from a pool shouldn't outlive the pool.
+ */
+class ChunkPool {
+  public:
+    /// number of chunks each block holds
+    static constexpr size_t chunks_per_block = 1'024;
+
+    /**
+     * Constructor.
+     */
+    ChunkPool() noexcept;
+
+    /**
+     * Destructor.
+     */
+    ~ChunkPool() noexcept;
+
+    /**
+     * Allocate the storage of a chunk.
+     * The header right before the storage points to this pool.
+     *
+     * @return pointer to the uninitialized storage of a chunk
+     */
+    [[nodiscard]] void* allocate() noexcept;
+
+    /**
+     * Release the storage of a destroyed chunk, so that it can be recycled.
+     *
+     * @param storage storage allocated from this pool
+     */
+    void release(void* storage) noexcept;
+
+    /**
+     * Get the allocation counters of the pool.
+     *
+     * @return allocation counters
+     */
+    [[nodiscard]] ChunkPoolStats get_stats() const noexcept;
+
+  private:
+    /// storage of a single chunk, prefixed with its header
+    struct ChunkSlot;
+
+    /// blocks of chunk slots
+    std::vector<std::unique_ptr<ChunkSlot[]>> blocks;
+
+    /// head of the released storages, linked through their first bytes
+    void* free_list;
+
+    /// allocation counters
+    ChunkPoolStats stats;
+
+    /**
+     * Allocate a new block, pushing its storages to the free list.
+     */
+    void grow() noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
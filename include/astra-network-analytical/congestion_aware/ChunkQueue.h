@@ -0,0 +1,153 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "congestion_aware/Chunk.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * ChunkQueue is a FIFO queue of chunks, stored in a growable ring buffer.
+ *
+ * The buffer doubles when full and never shrinks,
+ * so once a queue has grown to its peak length, enqueueing a chunk takes no heap allocation.
+ * An empty queue which has never been used holds no buffer.
+ */
+class ChunkQueue {
+  public:
+    /**
+     * Constructor, creating an empty queue.
+     */
+    ChunkQueue() noexcept;
+
+    /**
+     * Destructor, destroying the chunks left in the queue.
+     */
+    ~ChunkQueue() noexcept;
+
+    /**
+     * Move constructor.
+     *
+     * @param other queue to take over
+     */
+    ChunkQueue(ChunkQueue&& other) noexcept;
+
+    ChunkQueue(const ChunkQueue&) = delete;
+    ChunkQueue& operator=(const ChunkQueue&) = delete;
+    ChunkQueue& operator=(ChunkQueue&&) = delete;
+
+    /**
+     * Enqueue a chunk at the back of the queue.
+     *
+     * @param chunk chunk to enqueue
+     */
+    void push_back(std::unique_ptr<Chunk> chunk) noexcept {
+        assert(chunk != nullptr);
+
+        if (count == capacity) {
+            grow();
+        }
+        buffer[(head + count) & (capacity - 1)] = chunk.release();
+        count++;
+    }
+
+    /**
+     * Dequeue the chunk at the front of the queue.
+     *
+     * @return the dequeued chunk
+     */
+    [[nodiscard]] std::unique_ptr<Chunk> pop_front() noexcept {
+        assert(!empty());
+
+        auto chunk = std::unique_ptr<Chunk>(buffer[head]);
+        head = (head + 1) & (capacity - 1);
+        count--;
+        return chunk;
+    }
+
+    /**
+     * Enqueue a chunk at the front of the queue,
+     * e.g., to put back a dequeued chunk when an optimistic simulation rolls back.
+     *
+     * @param chunk chunk to enqueue
+     */
+    void push_front(std::unique_ptr<Chunk> chunk) noexcept {
+        assert(chunk != nullptr);
+
+        if (count == capacity) {
+            grow();
+        }
+        head = (head - 1) & (capacity - 1);
+        buffer[head] = chunk.release();
+        count++;
+    }
+
+    /**
+     * Dequeue the chunk at the back of the queue,
+     * e.g., to take back an enqueued chunk when an optimistic simulation rolls back.
+     *
+     * @return the dequeued chunk
+     */
+    [[nodiscard]] std::unique_ptr<Chunk> pop_back() noexcept {
+        assert(!empty());
+
+        count--;
+        return std::unique_ptr<Chunk>(buffer[(head + count) & (capacity - 1)]);
+    }
+
+    /**
+     * Get the chunk at the front of the queue, keeping it in the queue.
+     *
+     * @return pointer to the front chunk
+     */
+    [[nodiscard]] Chunk* front() const noexcept {
+        assert(!empty());
+
+        return buffer[head];
+    }
+
+    /**
+     * Get the number of chunks in the queue.
+     *
+     * @return number of chunks in the queue
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return count;
+    }
+
+    /**
+     * Check whether the queue is empty.
+     *
+     * @return true if the queue is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return count == 0;
+    }
+
+  private:
+    /// ring buffer of chunks, owned by the queue
+    std::unique_ptr<Chunk*[]> buffer;
+
+    /// capacity of the buffer, zero or a power of two
+    uint32_t capacity;
+
+    /// index of the front chunk
+    uint32_t head;
+
+    /// number of chunks in the queue
+    uint32_t count;
+
+    /**
+     * Double the buffer (or allocate the initial one), unwrapping the queued chunks.
+     */
+    void grow() noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
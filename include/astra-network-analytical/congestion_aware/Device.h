@@ -6,9 +6,11 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_aware/Link.h"
 #include "congestion_aware/Type.h"
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -17,6 +19,15 @@ namespace NetworkAnalyticalCongestionAware {
 /**
  * Device class represents a single device in the network.
  * Device is usually an NPU or a switch.
+ *
+ * Links are owned by the topology, which stores them in a flat table grouped by their src device
+ * (the links themselves being views of the link store, see Link).
+ * Device only views its own range of the table, sorted by the dest device id.
+ *
+ * Alternatively, a device can be connected to a whole group of devices implicitly
+ * (e.g., fully-connected topologies, whose link count grows quadratically).
+ * Then each link is instantiated on its first use and owned by the device,
+ * so that only the links actually used take memory.
  */
 class Device {
   public:
@@ -24,8 +35,9 @@ class Device {
      * Constructor.
      *
      * @param id id of the device
+     * @param context simulation context the device belongs to
      */
-    explicit Device(DeviceId id) noexcept;
+    Device(DeviceId id, SimulationContext* context) noexcept;
 
     /**
      * Get id of the device.
@@ -43,21 +55,99 @@ class Device {
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
     /**
-     * Connect a device to another device.
+     * Set the outgoing links of the device.
      *
-     * @param id id of the device to connect this device to
-     * @param bandwidth bandwidth of the link
-     * @param latency latency of the link
+     * @param links pointer to the first outgoing link
+     * @param dests dest device id of each link, sorted in increasing order
+     * @param links_count number of outgoing links
      */
-    void connect(DeviceId id, Bandwidth bandwidth, Latency latency) noexcept;
+    void set_links(Link* links, const DeviceId* dests, int links_count) noexcept;
+
+    /**
+     * Connect the device to every device in [first_dest, last_dest] except itself,
+     * with links instantiated on their first use.
+     * The device shouldn't have any link in the table.
+     *
+     * @param first_dest id of the first device to connect to
+     * @param last_dest id of the last device to connect to
+     * @param parameters bandwidth and latency of the links, which should outlive the device
+     */
+    void set_implicit_links(DeviceId first_dest, DeviceId last_dest, const LinkParameters* parameters) noexcept;
+
+    /**
+     * Get the link from this device to another device.
+     * The devices should be connected.
+     *
+     * @param dest id of the device the link goes to
+     * @return pointer to the link
+     */
+    [[nodiscard]] Link* get_link(DeviceId dest) noexcept;
+
+    /**
+     * Find the link from this device to another device, without instantiating it.
+     * The devices should be connected.
+     *
+     * @param dest id of the device the link goes to
+     * @return pointer to the link, or nullptr if the link hasn't been instantiated yet
+     */
+    [[nodiscard]] const Link* find_link(DeviceId dest) const noexcept;
+
+    /**
+     * Get the bandwidth and latency of the link from this device to another device,
+     * without instantiating the link.
+     * The devices should be connected.
+     *
+     * @param dest id of the device the link goes to
+     * @return parameters of the link
+     */
+    [[nodiscard]] const LinkParameters& get_link_parameters(DeviceId dest) const noexcept;
+
+    /**
+     * Get the dest device ids of every outgoing link, including the links not instantiated yet.
+     *
+     * @return dest device ids, sorted in increasing order
+     */
+    [[nodiscard]] std::vector<DeviceId> get_links_dests() const noexcept;
 
   private:
     /// device Id
     DeviceId device_id;
 
-    /// links to other nodes
-    /// map[dest node node_id] -> link
-    std::map<DeviceId, std::shared_ptr<Link>> links;
+    /// simulation context the device belongs to
+    SimulationContext* context;
+
+    /// outgoing links, owned by the topology
+    Link* links;
+
+    /// dest device id of each outgoing link, sorted in increasing order
+    const DeviceId* links_dests;
+
+    /// number of outgoing links
+    int links_count;
+
+    /// true if the dests are every device in [links_dests[0], links_dests[links_count - 1]] except this one,
+    /// so that the link to a dest is found by its offset (e.g., fully-connected topologies)
+    bool dense_links;
+
+    /// bandwidth and latency of the implicit links, or nullptr if the device has none
+    const LinkParameters* implicit_links_parameters;
+
+    /// implicit links go to every device in [implicit_first_dest, implicit_last_dest] except this one
+    DeviceId implicit_first_dest;
+
+    /// implicit links go to every device in [implicit_first_dest, implicit_last_dest] except this one
+    DeviceId implicit_last_dest;
+
+    /// implicit links instantiated so far, indexed by their dest device id
+    std::unordered_map<DeviceId, Link> implicit_links;
+
+    /**
+     * Find the index of the link to another device.
+     *
+     * @param dest id of the device the link goes to
+     * @return index of the link, or links_count if not connected
+     */
+    [[nodiscard]] int link_index(DeviceId dest) const noexcept;
 
     /**
      * Check if this device is connected to another device.
@@ -39,6 +39,11 @@ class FullyConnected final : public BasicTopology {
      * Implementation of route function in Topology.
      */
     [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implementation of next_hop function in Topology.
+     */
+    [[nodiscard]] DeviceId next_hop(DeviceId current, DeviceId dest) const noexcept override;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,99 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * FusedTransmission sends a chunk over its whole multi-hop route with a single event.
+ *
+ * If every link of the remaining route is available when the chunk would reach it,
+ * the links are reserved up front and only the final arrival is scheduled.
+ * When another chunk would use a reserved link before the reservation ends
+ * (i.e., hop-by-hop simulation would have delayed the fused chunk),
+ * the fused transmission falls back to hop-by-hop simulation from the hop it is on.
+ *
+ * A hop-by-hop chunk reaching a link exactly when a reservation starts
+ * is served after the reserved chunk.
+ * A chunk queued on a reserved link (i.e., to be served before the reserved chunk)
+ * makes the fused transmission fall back as well.
+ * Route fusion is disabled by default (see SimulationContext::set_route_fusion).
+ */
+class FusedTransmission {
+  public:
+    /**
+     * Try to send a chunk over its whole remaining route.
+     * The chunk is taken only if the route has multiple hops and every link on the route is available.
+     * Route fusion should be enabled in the simulation context of the chunk.
+     *
+     * @param chunk chunk to send, sitting on its current device
+     * @return true if the chunk is taken, false otherwise
+     */
+    [[nodiscard]] static bool try_send(std::unique_ptr<Chunk>& chunk) noexcept;
+
+    /**
+     * Callback to be invoked when a fused chunk arrives at its destination.
+     *
+     * @param transmission fused transmission of the chunk
+     */
+    static void chunk_arrived_dest(FusedTransmission* transmission) noexcept;
+
+    /**
+     * Fall back to hop-by-hop simulation:
+     * cancel the reservations which haven't started yet and the final arrival,
+     * schedule the chunk arrival of the hop the chunk is on, and free the transmission.
+     */
+    void fall_back() noexcept;
+
+  private:
+    /**
+     * Hop of a fused transmission.
+     */
+    struct Hop {
+        /// link of the hop
+        Link* link;
+
+        /// time the link starts serializing the chunk
+        EventTime start;
+
+        /// time the link finishes serializing the chunk
+        EventTime end;
+
+        /// time the chunk arrives at the next device
+        EventTime arrival;
+    };
+
+    /// simulation context of the chunk, providing the event queue
+    SimulationContext* context;
+
+    /// chunk in transmission
+    std::unique_ptr<Chunk> chunk;
+
+    /// hops of the remaining route
+    std::vector<Hop> hops;
+
+    /// final arrival event of the chunk
+    EventHandle arrival_event;
+
+    /**
+     * Constructor.
+     *
+     * @param context simulation context of the chunk
+     * @param chunk chunk to transmit
+     * @param hops hops of the remaining route
+     */
+    FusedTransmission(SimulationContext* context, std::unique_ptr<Chunk> chunk, std::vector<Hop> hops) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -15,6 +15,7 @@ namespace NetworkAnalyticalCongestionAware {
 
 /**
  * Construct a topology from a NetworkParser.
+ * The topology simulates with an event queue of the configured scheduling policy.
  *
  * @param network_parser NetworkParser to parse the network input file
  * @return pointer to the constructed topology
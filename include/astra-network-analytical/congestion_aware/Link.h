@@ -7,46 +7,83 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/EventQueue.h"
 #include "common/Type.h"
+#include "congestion_aware/LinkStore.h"
 #include "congestion_aware/Type.h"
+#include <cassert>
+#include <cstdint>
 #include <memory>
 
 using namespace NetworkAnalytical;
 
 namespace NetworkAnalyticalCongestionAware {
 
+/**
+ * Queueing statistics of a Link, covering the simulation so far.
+ */
+struct LinkStats {
+    /// maximum number of chunks pending at once
+    size_t peak_pending_chunks;
+
+    /// number of chunks which had to wait in the pending queue
+    uint64_t queued_chunks_count;
+
+    /// sum of the time every chunk spent in the pending queue, in ns
+    EventTime total_queued_time;
+
+    /// time-weighted average number of pending chunks,
+    /// i.e., total_queued_time / (current time)
+    double average_pending_chunks;
+};
+
 /**
  * Link models physical links between two devices.
+ *
+ * Link itself is a thin view:
+ * the state of the link is held by the LinkStore of the simulation context, indexed by the link id.
  */
 class Link {
   public:
     /**
-     * Callback to be called when a link becomes free.
-     *  - If the link has pending chunks, process the first one.
-     *  - If the link has no pending chunks, set the link as free.
+     * Callback to be called when a link becomes free while chunks are pending.
+     * The first pending chunk gets processed.
+     *
+     * The event is only scheduled if the link has pending chunks:
+     * otherwise, the link simply becomes free at busy_until.
+     *
+     * Typed event handler, defined here so that event dispatchers can inline it.
      *
-     * @param link_ptr pointer to the link that becomes free
+     * @param link link that becomes free
      */
-    static void link_become_free(void* link_ptr) noexcept;
+    static void link_become_free(Link* const link) noexcept {
+        assert(link != nullptr);
+        assert(link->pending_chunk_exists());
+
+        // process the first pending chunk
+        link->process_pending_transmission();
+    }
 
     /**
-     * Set the event queue to be used by the link.
+     * Constructor.
      *
-     * @param event_queue_ptr pointer to the event queue
+     * @param context simulation context the link belongs to
+     * @param id id of the link in the link store of the context
      */
-    static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
+    Link(SimulationContext* context, LinkId id) noexcept;
 
     /**
-     * Constructor.
+     * Get id of the link.
      *
-     * @param bandwidth bandwidth of the link
-     * @param latency latency of the link
+     * @return id of the link
      */
-    Link(Bandwidth bandwidth, Latency latency) noexcept;
+    [[nodiscard]] LinkId get_id() const noexcept;
 
     /**
      * Try to send a chunk through the link.
-     * - If the link is free, service the chunk immediately.
-     * - If the link is busy, add the chunk to the pending chunks list.
+     * - If the link is free and no chunk is pending, service the chunk immediately.
+     * - Otherwise, add the chunk to the pending chunks list.
+     *   The first pending chunk schedules the link-free event.
+     *   Fused transmissions reserving the link fall back to hop-by-hop simulation,
+     *   as the pending chunks are served first.
      *
      * @param chunk the chunk to be served by the link
      */
@@ -55,6 +92,8 @@ class Link {
     /**
      * Dequeue and try to send the first pending chunk
      * in the pending chunks list.
+     * If a started reservation keeps the link busy, the link-free event is scheduled again instead.
+     * If more chunks are pending, the next link-free event is scheduled.
      */
     void process_pending_transmission() noexcept;
 
@@ -66,33 +105,53 @@ class Link {
     [[nodiscard]] bool pending_chunk_exists() const noexcept;
 
     /**
-     * Set the link as busy.
+     * Get the queueing statistics of the link so far.
+     *
+     * @return queueing statistics of the link
      */
-    void set_busy() noexcept;
+    [[nodiscard]] LinkStats get_stats() const noexcept;
 
     /**
-     * Set the link as free.
+     * Check if the link is transmitting a chunk at the current time.
+     *
+     * @return true if the link is busy, false otherwise
      */
-    void set_free() noexcept;
-
-  private:
-    /// event queue Link uses to schedule events
-    static std::shared_ptr<EventQueue> event_queue;
+    [[nodiscard]] bool busy() const noexcept;
 
-    /// bandwidth of the link in GB/s
-    Bandwidth bandwidth;
-
-    /// bandwidth of the link in B/ns, used in actual computation
-    Bandwidth bandwidth_Bpns;
+    /**
+     * Check if the link can serve a chunk during the given time window
+     * without delaying or being delayed by any other chunk,
+     * i.e., no chunk is pending, the link is free by the start time,
+     * and no reservation overlaps the window.
+     *
+     * @param start start time of the window
+     * @param end end time (exclusive) of the window
+     * @return true if the link is available during the window, false otherwise
+     */
+    [[nodiscard]] bool available(EventTime start, EventTime end) const noexcept;
 
-    /// latency of the link in ns
-    Latency latency;
+    /**
+     * Reserve the link for a fused transmission.
+     * The link should be available during the reserved window.
+     *
+     * @param start start time of the reservation
+     * @param end end time (exclusive) of the reservation
+     * @param owner fused transmission holding the reservation
+     */
+    void reserve(EventTime start, EventTime end, FusedTransmission* owner) noexcept;
 
-    /// queue of pending chunks
-    std::list<std::unique_ptr<Chunk>> pending_chunks;
+    /**
+     * Cancel the reservations of a fused transmission which haven't started yet.
+     *
+     * @param owner fused transmission holding the reservations
+     */
+    void cancel_reservations(const FusedTransmission* owner) noexcept;
 
-    /// flag to indicate if the link is busy
-    bool busy;
+    /**
+     * Make the started reservations part of the link's busy time,
+     * i.e., update busy_until with every reservation starting at or before the current time.
+     */
+    void update_reservations() noexcept;
 
     /**
      * Compute the serialization delay of a chunk on the link.
@@ -112,15 +171,44 @@ class Link {
      */
     [[nodiscard]] EventTime communication_delay(ChunkSize chunk_size) const noexcept;
 
+  private:
+    /// simulation context the link belongs to, providing the event queue and the link store
+    SimulationContext* context;
+
+    /// id of the link in the link store
+    LinkId id;
+
     /**
      * Schedule the transmission of a chunk.
-     * - Set the link as busy.
-     * - Link becomes free after the serialization delay.
+     * - Link becomes busy until the serialization delay passes.
      * - Chunk arrives next node after the communication delay.
      *
      * @param chunk chunk to be transmitted
      */
     void schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Fall back the fused transmissions whose reservations
+     * would be delayed by the link being occupied until the given time to hop-by-hop simulation.
+     *
+     * @param end end time of the transmission starting at the current time,
+     *            or the maximum time for chunks queued on the link
+     */
+    void resolve_conflicts(EventTime end) noexcept;
+
+    /**
+     * Schedule the link-free event at busy_until,
+     * to process the first pending chunk.
+     */
+    void schedule_link_free() noexcept;
+
+    /**
+     * Accumulate the time the pending chunks have waited since the last update,
+     * to be called right before the pending queue changes its length.
+     *
+     * @param current_time current time
+     */
+    void update_queued_time(EventTime current_time) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,160 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/NetworkParser.h"
+#include "common/ThreadPool.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Topology.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * LinkDisjointSimulation simulates traffic which splits into independent parts on multiple threads,
+ * e.g., a phase of a collective using the links of a single dimension, or of a single ring segment.
+ *
+ * On run(), the routes of the chunks sent so far are analyzed,
+ * and the chunks are grouped into components, where the chunks of different components share no link
+ * (i.e., the connected components of the link-sharing graph, found by union-find over the links).
+ * The links of both directions between two devices are taken as one, so that a chunk can be sent back the way it came.
+ * As the components don't interact, each is simulated by itself on a replica of the topology of a worker thread,
+ * with the event queue of the replica, the largest components first.
+ * The simulation then ends at the latest finish time of the components.
+ *
+ * Results are exactly the same as the sequential simulation of the same chunks,
+ * as the events of a component are invoked in the same order either way.
+ * No lookahead or synchronization is needed, but traffic sharing links ends up in a single component.
+ *
+ * Chunks are sent before run(), e.g., a phase of a collective per run(),
+ * or from the callbacks of arrived chunks, as long as the chunk uses the links of the same component only.
+ * Chunks should be allocated by themselves (e.g., std::make_unique<Chunk>), not from the chunk pool of a topology.
+ * Route fusion isn't supported.
+ */
+class LinkDisjointSimulation {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param network_parser NetworkParser to parse the network input file
+     * @param threads_count number of worker threads including the calling thread,
+     *                      or 0 to use every hardware thread
+     */
+    explicit LinkDisjointSimulation(const NetworkParser& network_parser, int threads_count = 0) noexcept;
+
+    /**
+     * Initiate a transmission of a chunk.
+     * Should be called before run(), or from the callback of a chunk arrived,
+     * with the chunk using the links of the same component only.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Simulate the chunks sent since the last run, starting from the current time,
+     * until every event of every component is processed.
+     */
+    void run() noexcept;
+
+    /**
+     * Get the current simulation time.
+     * In a callback, the time the chunk arrived; otherwise, the time the last run finished.
+     *
+     * @return current simulation time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Get the number of components the last run has split the chunks into.
+     *
+     * @return number of components
+     */
+    [[nodiscard]] int get_components_count() const noexcept;
+
+    /**
+     * Get the time each component of the last run finished, in the order of their first chunks sent.
+     *
+     * @return finish time of each component
+     */
+    [[nodiscard]] const std::vector<EventTime>& get_component_finish_times() const noexcept;
+
+    /**
+     * Get the number of events invoked so far, by every component.
+     *
+     * @return number of invoked events
+     */
+    [[nodiscard]] uint64_t get_processed_events_count() const noexcept;
+
+    /**
+     * Get the number of NPUs in the topology.
+     *
+     * @return number of NPUs
+     */
+    [[nodiscard]] int get_npus_count() const noexcept;
+
+  private:
+    /**
+     * Component of the traffic, sharing no link with the other components.
+     */
+    struct Component {
+        /// chunks of the component, in the order sent
+        std::vector<std::unique_ptr<Chunk>> chunks;
+
+        /// number of hops of the chunks, estimating the cost to simulate the component
+        uint64_t hops_count;
+    };
+
+    /// worker threads, simulating a component per task
+    ThreadPool thread_pool;
+
+    /// replica of the topology per worker
+    std::vector<std::shared_ptr<Topology>> topologies;
+
+    /// number of devices in the topology
+    int devices_count;
+
+    /// chunks sent since the last run
+    std::vector<std::unique_ptr<Chunk>> pending_chunks;
+
+    /// component of each link used in the last run, keyed by link_key()
+    std::unordered_map<uint64_t, int> component_per_link;
+
+    /// finish time of each component of the last run
+    std::vector<EventTime> component_finish_times;
+
+    /// time the last run finished
+    EventTime current_time;
+
+    /// whether a run is in progress
+    bool running;
+
+    /**
+     * Get the key identifying the link src -> dest, the same as the link dest -> src.
+     *
+     * @param src src device id of the link
+     * @param dest dest device id of the link
+     * @return key of the link
+     */
+    [[nodiscard]] uint64_t link_key(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Get the keys of the links a chunk traverses from its current device.
+     *
+     * @param topology topology routing the chunk
+     * @param chunk chunk to route
+     * @param keys keys of the links, to be filled
+     */
+    void route_links(const Topology& topology, const Chunk& chunk, std::vector<uint64_t>& keys) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,195 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/ChunkQueue.h"
+#include "congestion_aware/Type.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/// Link ID which starts from 0, indexing the link state of a LinkStore
+using LinkId = uint32_t;
+
+/**
+ * Immutable parameters of a Link, shared by every link of the same kind (e.g., of a network dimension)
+ * instead of being copied into each link.
+ */
+struct LinkParameters {
+    /// inverse bandwidth of the link in ns/B, so that serialization delays take a multiplication
+    Bandwidth inverse_bandwidth_nspB;
+
+    /// latency of the link in ns
+    Latency latency;
+};
+
+/**
+ * Reservation of a link made by a fused transmission.
+ */
+struct LinkReservation {
+    /// start time of the reservation
+    EventTime start;
+
+    /// end time (exclusive) of the reservation
+    EventTime end;
+
+    /// fused transmission holding the reservation
+    FusedTransmission* owner;
+};
+
+/**
+ * Running counters of the pending queue of a link.
+ */
+struct LinkQueueCounters {
+    /// maximum number of chunks pending at once
+    uint32_t peak_pending_chunks;
+
+    /// number of chunks which had to wait in the pending queue
+    uint64_t queued_chunks_count;
+
+    /// integral of the number of pending chunks over time, up to last_queue_update
+    EventTime queued_time;
+
+    /// time the pending queue last changed its length
+    EventTime last_queue_update;
+};
+
+/**
+ * LinkStore holds the state of every link of a simulation in structure-of-arrays layout, indexed by link id.
+ * Link objects are thin views of their entries.
+ *
+ * The state a link touches whenever it serves a chunk (busy time, pending queue, parameters)
+ * is held in separate contiguous arrays,
+ * apart from the state touched only by fused transmissions or under contention (reservations, queue counters).
+ */
+class LinkStore {
+  public:
+    /**
+     * Constructor, creating an empty store.
+     */
+    LinkStore() noexcept;
+
+    /**
+     * Reserve the storage for the given number of links.
+     *
+     * @param links_count number of links the store will hold
+     */
+    void reserve(size_t links_count) noexcept;
+
+    /**
+     * Add the state of a new, idle link.
+     *
+     * @param parameters bandwidth and latency of the link, which should outlive the store
+     * @return id of the link
+     */
+    [[nodiscard]] LinkId add_link(const LinkParameters* parameters) noexcept;
+
+    /**
+     * Get the number of links in the store.
+     *
+     * @return number of links
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return busy_until_per_link.size();
+    }
+
+    /**
+     * Get the time a link finishes serializing the last scheduled chunk.
+     *
+     * @param id id of the link
+     * @return busy-until time of the link
+     */
+    [[nodiscard]] EventTime& busy_until(const LinkId id) noexcept {
+        assert(id < size());
+
+        return busy_until_per_link[id];
+    }
+
+    /**
+     * Get the pending chunks of a link.
+     *
+     * @param id id of the link
+     * @return pending chunks of the link
+     */
+    [[nodiscard]] ChunkQueue& pending_chunks(const LinkId id) noexcept {
+        assert(id < size());
+
+        return pending_chunks_per_link[id];
+    }
+
+    /**
+     * Get the bandwidth and latency of a link.
+     *
+     * @param id id of the link
+     * @return parameters of the link
+     */
+    [[nodiscard]] const LinkParameters& parameters(const LinkId id) const noexcept {
+        assert(id < size());
+
+        return *parameters_per_link[id];
+    }
+
+    /**
+     * Get the reservations of a link not merged into its busy time yet.
+     *
+     * @param id id of the link
+     * @return reservations of the link, sorted by start time
+     */
+    [[nodiscard]] std::vector<LinkReservation>& reservations(const LinkId id) noexcept {
+        assert(id < size());
+
+        return reservations_per_link[id];
+    }
+
+    /**
+     * Get the number of reservations of every link in total,
+     * so that links skip their reservations unless fused transmissions are in flight.
+     *
+     * @return number of reservations in total
+     */
+    [[nodiscard]] size_t& reservations_count() noexcept {
+        return total_reservations_count;
+    }
+
+    /**
+     * Get the counters of the pending queue of a link.
+     *
+     * @param id id of the link
+     * @return queue counters of the link
+     */
+    [[nodiscard]] LinkQueueCounters& queue_counters(const LinkId id) noexcept {
+        assert(id < size());
+
+        return queue_counters_per_link[id];
+    }
+
+  private:
+    /// time each link finishes serializing the last scheduled chunk
+    std::vector<EventTime> busy_until_per_link;
+
+    /// pending chunks of each link
+    std::vector<ChunkQueue> pending_chunks_per_link;
+
+    /// bandwidth and latency of each link, shared among links
+    std::vector<const LinkParameters*> parameters_per_link;
+
+    /// reservations of each link made by fused transmissions
+    std::vector<std::vector<LinkReservation>> reservations_per_link;
+
+    /// counters of the pending queue of each link
+    std::vector<LinkQueueCounters> queue_counters_per_link;
+
+    /// number of reservations of every link in total
+    size_t total_reservations_count;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,115 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/BasicTopology.h"
+#include "congestion_aware/Topology.h"
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * MultiDimTopology implements multi-dimensional network topologies
+ * which can be constructed by stacking up multiple BasicTopology instances.
+ *
+ * Every NPU belongs to one instance of each dimension's BasicTopology,
+ * together with the NPUs whose address only differs in that dimension.
+ * NPUs are devices [0, npus_count), and non-NPU devices (e.g., switches) of each dimension's instances follow.
+ * e.g., for [Ring(2), Switch(4)], NPUs are 0-7,
+ * and the switches of {0, 2, 4, 6} and {1, 3, 5, 7} are 8 and 9.
+ *
+ * Chunks are routed in dimension order, i.e., from the lowest dimension whose address differs to the highest one,
+ * and contend for the links of every hop.
+ */
+class MultiDimTopology : public Topology {
+  public:
+    /**
+     * Constructor.
+     */
+    MultiDimTopology() noexcept;
+
+    /**
+     * Add a dimension to the multi-dimensional topology.
+     *
+     * @param basic_topology BasicTopology instance to be added,
+     *                       describing the shape of the dimension.
+     */
+    void append_dimension(std::unique_ptr<BasicTopology> basic_topology) noexcept;
+
+    /**
+     * Instantiate the devices and links of every dimension.
+     * Should be called once, after every dimension is appended.
+     */
+    void build() noexcept;
+
+    /**
+     * Implement the route method of Topology.
+     */
+    [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
+
+    /**
+     * Implement the next_hop method of Topology.
+     */
+    [[nodiscard]] DeviceId next_hop(DeviceId current, DeviceId dest) const noexcept override;
+
+  private:
+    /// Each NPU ID can be broken down into multiple dimensions.
+    /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
+    /// then the NPU ID can be broken down into [1, 7, 1].
+    using MultiDimAddress = std::vector<DeviceId>;
+
+    /// BasicTopology instances per dimension.
+    std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
+
+    /// difference of the NPU IDs of adjacent NPUs per dimension,
+    /// e.g., [1, 2, 16] for [2, 8, 4]
+    std::vector<int> stride_per_dim;
+
+    /// id of the first non-NPU device per dimension
+    std::vector<DeviceId> non_npus_offset_per_dim;
+
+    /**
+     * Translate the NPU ID into a multi-dimensional address.
+     *
+     * @param npu_id id of the NPU
+     * @return the same NPU in multi-dimensional address representation
+     */
+    [[nodiscard]] MultiDimAddress translate_address(DeviceId npu_id) const noexcept;
+
+    /**
+     * Get the address of an NPU in the given dimension.
+     *
+     * @param dim dimension
+     * @param npu_id id of the NPU
+     * @return address of the NPU in the dimension
+     */
+    [[nodiscard]] DeviceId get_address(int dim, DeviceId npu_id) const noexcept;
+
+    /**
+     * Get the index of the dimension's instance an NPU belongs to.
+     *
+     * @param dim dimension
+     * @param npu_id id of the NPU
+     * @return index of the instance
+     */
+    [[nodiscard]] int get_instance(int dim, DeviceId npu_id) const noexcept;
+
+    /**
+     * Translate the id of a device local to a dimension's instance into the global device id.
+     *
+     * @param dim dimension
+     * @param instance index of the instance
+     * @param local_id id of the device within the instance
+     * @return global id of the device
+     */
+    [[nodiscard]] DeviceId translate_device(int dim, int instance, DeviceId local_id) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,181 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/NetworkParser.h"
+#include "common/ThreadPool.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/SimulationPartition.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * ParallelSimulation simulates a topology on multiple threads,
+ * by conservative parallel discrete-event simulation.
+ *
+ * The devices are split into partitions (contiguous ranges of NPUs and of the other devices),
+ * each simulated by a SimulationPartition on its own replica of the topology and its own event queue.
+ * The partitions proceed together in windows of the lookahead (YAWNS):
+ * a chunk takes at least the lookahead, i.e., the minimum latency of the links crossing partitions,
+ * to reach another partition, so every partition can process the events of
+ * [earliest event time, earliest event time + lookahead) independently.
+ *
+ * Results are exactly the same as the sequential simulation (i.e., Topology::proceed() on a single event queue),
+ * including the order of the events of the same time:
+ * at the end of each window, the processed events are ranked in the order the sequential simulation invokes them,
+ * and the events handed over to another partition are scheduled there in the order of their parents' ranks.
+ *
+ * Chunks are sent before run(), or from the callbacks of arrived chunks from the device the chunk arrived at
+ * (e.g., to forward data to the next NPU of a collective).
+ * Callbacks are invoked on the worker threads, concurrently for the chunks arriving at different partitions.
+ * Chunks should be allocated by themselves (e.g., std::make_unique<Chunk>), not from the chunk pool of a topology.
+ * Route fusion isn't supported, as a fused transmission reserves the links of multiple partitions.
+ */
+class ParallelSimulation {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param network_parser NetworkParser to parse the network input file
+     * @param threads_count number of worker threads (i.e., partitions) including the calling thread,
+     *                      or 0 to use every hardware thread
+     */
+    explicit ParallelSimulation(const NetworkParser& network_parser, int threads_count = 0) noexcept;
+
+    /**
+     * Initiate a transmission of a chunk.
+     * Should be called before run(), or from the callback of a chunk arrived at the src device of the chunk.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Run the simulation until every event is processed.
+     */
+    void run() noexcept;
+
+    /**
+     * Get the current simulation time.
+     * In a callback, the time the chunk arrived; otherwise, the time of the last processed event.
+     *
+     * @return current simulation time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Get the number of partitions.
+     *
+     * @return number of partitions
+     */
+    [[nodiscard]] int get_partitions_count() const noexcept;
+
+    /**
+     * Get the partition simulating a device.
+     *
+     * @param device id of the device
+     * @return id of the partition
+     */
+    [[nodiscard]] int get_partition(DeviceId device) const noexcept;
+
+    /**
+     * Get the lookahead, i.e., the minimum latency of the links crossing partitions.
+     *
+     * @return lookahead in ns, or the maximum event time if no link crosses partitions
+     */
+    [[nodiscard]] EventTime get_lookahead() const noexcept;
+
+    /**
+     * Get the number of windows processed so far.
+     *
+     * @return number of windows
+     */
+    [[nodiscard]] uint64_t get_windows_count() const noexcept;
+
+    /**
+     * Get the number of events invoked so far, by every partition.
+     *
+     * @return number of invoked events
+     */
+    [[nodiscard]] uint64_t get_processed_events_count() const noexcept;
+
+    /**
+     * Get the queueing statistics of the link src -> dest.
+     *
+     * @param src src device id of the link
+     * @param dest dest device id of the link
+     * @return queueing statistics of the link
+     */
+    [[nodiscard]] LinkStats get_link_stats(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Get the number of NPUs in the topology.
+     *
+     * @return number of NPUs
+     */
+    [[nodiscard]] int get_npus_count() const noexcept;
+
+  private:
+    /// worker threads, processing a partition per task
+    ThreadPool thread_pool;
+
+    /// id of the partition simulating each device
+    std::vector<int> partition_per_device;
+
+    /// partitions of the simulation
+    std::vector<std::unique_ptr<SimulationPartition>> partitions;
+
+    /// minimum latency of the links crossing partitions
+    EventTime lookahead;
+
+    /// number of events scheduled before the simulation runs
+    uint64_t roots_count;
+
+    /// rank to be given to the next processed event, in the order the sequential simulation invokes the events
+    uint64_t next_rank;
+
+    /// number of windows processed so far
+    uint64_t windows_count;
+
+    /// parity of the last processed window
+    int parity;
+
+    /// whether the simulation is running or has run
+    bool started;
+
+    /**
+     * Compute the lookahead, i.e., the minimum latency of the links crossing partitions.
+     *
+     * @return lookahead in ns
+     */
+    [[nodiscard]] EventTime compute_lookahead() const noexcept;
+
+    /**
+     * Rank the events processed in the last window by every partition,
+     * in the order the sequential simulation would have invoked them.
+     */
+    void rank_processed_events() noexcept;
+
+    /**
+     * Check whether a processed event precedes another one of a different partition in the sequential simulation.
+     *
+     * @param lhs_partition partition of the first event
+     * @param lhs index of the first event among the processed events of its partition
+     * @param rhs_partition partition of the second event
+     * @param rhs index of the second event among the processed events of its partition
+     * @return true if the first event precedes the second one, false otherwise
+     */
+    [[nodiscard]] bool precedes(int lhs_partition, uint64_t lhs, int rhs_partition, uint64_t rhs) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
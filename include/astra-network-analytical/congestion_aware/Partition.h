@@ -0,0 +1,51 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Partition is a part of a parallel simulation,
+ * simulating a subset of the devices of a topology on its own replica of the topology.
+ *
+ * The simulation context of the replica schedules the events of the network through the partition
+ * (see SimulationContext::set_partition), which decides when and where each event is invoked,
+ * e.g., SimulationPartition (conservative) or TimeWarpPartition (optimistic).
+ */
+class Partition {
+  public:
+    /**
+     * Split the devices of a topology into partitions:
+     * the NPUs into contiguous ranges, then the other devices (e.g., switches) into contiguous ranges.
+     *
+     * @param topology topology to split
+     * @param partitions_count number of partitions
+     * @return id of the partition simulating each device
+     */
+    [[nodiscard]] static std::vector<int> split_devices(const Topology& topology, int partitions_count) noexcept;
+
+    /**
+     * Destructor.
+     */
+    virtual ~Partition() noexcept = default;
+
+    /**
+     * Schedule an event of the network.
+     *
+     * @param event_time time to invoke the event
+     * @param callback callback of the event
+     * @param callback_arg argument of the callback
+     */
+    virtual void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept = 0;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
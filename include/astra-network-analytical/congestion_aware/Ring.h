@@ -46,6 +46,11 @@ class Ring final : public BasicTopology {
      */
     [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
 
+    /**
+     * Implementation of next_hop function in Topology.
+     */
+    [[nodiscard]] DeviceId next_hop(DeviceId current, DeviceId dest) const noexcept override;
+
   private:
     /// true if the ring is bidirectional, false otherwise
     bool bidirectional;
@@ -0,0 +1,190 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * Route is a sequence of device ids a chunk traverses,
+ * including the src and dest devices themselves,
+ * e.g., [5, 1, 6, 2, 3] for a chunk from device 5 to device 3.
+ *
+ * Short routes are stored inline, so constructing or copying them takes no heap allocation.
+ * Routes longer than inline_capacity spill into a heap buffer.
+ * A cursor marks the current device, so dropping it (pop_front) is O(1).
+ */
+class Route {
+  public:
+    /// number of devices stored without a heap allocation
+    static constexpr size_t inline_capacity = 8;
+
+    /**
+     * Constructor, creating an empty route.
+     */
+    Route() noexcept;
+
+    /**
+     * Reserve the storage for the given number of devices.
+     *
+     * @param devices_count number of devices the route will hold
+     */
+    void reserve(size_t devices_count) noexcept;
+
+    /**
+     * Append a device at the end of the route.
+     *
+     * @param device id of the device
+     */
+    void push_back(DeviceId device) noexcept {
+        assert(device >= 0);
+
+        if (devices_count < inline_capacity) {
+            inline_devices[devices_count] = device;
+        } else {
+            spill(device);
+        }
+        devices_count++;
+    }
+
+    /**
+     * Drop the current (i.e., first remaining) device of the route.
+     */
+    void pop_front() noexcept {
+        assert(!empty());
+
+        cursor++;
+    }
+
+    /**
+     * Get the position of the current device among every device of the route.
+     *
+     * @return index of the current device
+     */
+    [[nodiscard]] size_t get_cursor() const noexcept {
+        return cursor;
+    }
+
+    /**
+     * Move the current device, e.g., back to a device dropped before.
+     *
+     * @param new_cursor index of the new current device
+     */
+    void set_cursor(const size_t new_cursor) noexcept {
+        assert(new_cursor <= devices_count);
+
+        cursor = new_cursor;
+    }
+
+    /**
+     * Get the number of remaining devices.
+     *
+     * @return number of remaining devices
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return devices_count - cursor;
+    }
+
+    /**
+     * Check whether no device remains.
+     *
+     * @return true if no device remains, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return cursor == devices_count;
+    }
+
+    /**
+     * Get the current (i.e., first remaining) device.
+     *
+     * @return id of the current device
+     */
+    [[nodiscard]] DeviceId front() const noexcept {
+        assert(!empty());
+
+        return begin()[0];
+    }
+
+    /**
+     * Get the last device, i.e., the destination.
+     *
+     * @return id of the last device
+     */
+    [[nodiscard]] DeviceId back() const noexcept {
+        assert(!empty());
+
+        return end()[-1];
+    }
+
+    /**
+     * Get a remaining device.
+     *
+     * @param index index of the device, counted from the current device
+     * @return id of the device
+     */
+    [[nodiscard]] DeviceId operator[](const size_t index) const noexcept {
+        assert(index < size());
+
+        return begin()[index];
+    }
+
+    /**
+     * Get the beginning of the remaining devices.
+     *
+     * @return pointer to the current device
+     */
+    [[nodiscard]] const DeviceId* begin() const noexcept {
+        return storage() + cursor;
+    }
+
+    /**
+     * Get the end of the remaining devices.
+     *
+     * @return pointer past the last device
+     */
+    [[nodiscard]] const DeviceId* end() const noexcept {
+        return storage() + devices_count;
+    }
+
+  private:
+    /// devices of a short route
+    std::array<DeviceId, inline_capacity> inline_devices;
+
+    /// devices of a long route, used once the route outgrows inline_devices
+    std::vector<DeviceId> spilled_devices;
+
+    /// number of devices, including the dropped ones
+    size_t devices_count;
+
+    /// index of the current device
+    size_t cursor;
+
+    /**
+     * Get the storage holding the devices.
+     *
+     * @return pointer to the first (including dropped) device
+     */
+    [[nodiscard]] const DeviceId* storage() const noexcept {
+        return (devices_count > inline_capacity) ? spilled_devices.data() : inline_devices.data();
+    }
+
+    /**
+     * Append a device beyond the inline capacity,
+     * moving the devices into spilled_devices if not done yet.
+     *
+     * @param device id of the device
+     */
+    void spill(DeviceId device) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,151 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "congestion_aware/ChunkPool.h"
+#include "congestion_aware/LinkStore.h"
+#include "congestion_aware/Type.h"
+#include <cassert>
+#include <memory>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * SimulationContext holds the state of a single simulation:
+ * the event queue, the chunk pool, the link store, and the simulation options.
+ *
+ * Each topology owns its context and passes it down to its devices and links,
+ * so that independent simulations don't share any state
+ * and can run in the same process (e.g., on different threads).
+ */
+class SimulationContext {
+  public:
+    /**
+     * Constructor, creating an event queue of its own.
+     */
+    SimulationContext() noexcept;
+
+    /**
+     * Set the event queue of the simulation,
+     * e.g., to use another scheduling policy or to share an event queue among topologies.
+     * Should be called before any chunk is sent.
+     *
+     * @param event_queue_ptr pointer to the event queue
+     */
+    void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
+
+    /**
+     * Get the event queue of the simulation.
+     *
+     * @return pointer to the event queue
+     */
+    [[nodiscard]] const std::shared_ptr<EventQueue>& get_event_queue() const noexcept {
+        assert(event_queue != nullptr);
+
+        return event_queue;
+    }
+
+    /**
+     * Get the chunk pool of the simulation.
+     *
+     * @return chunk pool
+     */
+    [[nodiscard]] ChunkPool& get_chunk_pool() noexcept;
+
+    /**
+     * Get the link store of the simulation, holding the state of every link.
+     *
+     * @return link store
+     */
+    [[nodiscard]] LinkStore& get_link_store() noexcept {
+        return link_store;
+    }
+
+    /**
+     * Enable or disable route fusion, disabled by default.
+     *
+     * @param enabled true to enable route fusion, false to disable it
+     */
+    void set_route_fusion(bool enabled) noexcept;
+
+    /**
+     * Check whether route fusion is enabled.
+     *
+     * @return true if route fusion is enabled, false otherwise
+     */
+    [[nodiscard]] bool is_route_fusion_enabled() const noexcept {
+        return route_fusion;
+    }
+
+    /**
+     * Set the partition of a parallel simulation the context simulates.
+     * Events of the network are then scheduled through the partition instead of the event queue.
+     *
+     * @param partition_ptr pointer to the partition
+     */
+    void set_partition(Partition* partition_ptr) noexcept;
+
+    /**
+     * Get the partition of a parallel simulation the context simulates.
+     *
+     * @return pointer to the partition, nullptr if simulated sequentially
+     */
+    [[nodiscard]] Partition* get_partition() const noexcept {
+        return partition;
+    }
+
+    /**
+     * Schedule an event of the network (e.g., a chunk arrival or a link becoming free).
+     * The event goes to the event queue, or to the partition if the context simulates one.
+     *
+     * @tparam Handler typed event handler
+     * @param event_time time to invoke the event
+     * @param object object the handler works on
+     * @return handle of the event to cancel it, or invalid_event_handle if scheduled through the partition
+     */
+    template <auto Handler>
+    EventHandle schedule_event(const EventTime event_time,
+                               typename EventHandler<Handler>::Object* const object) noexcept {
+        assert(object != nullptr);
+
+        if (partition != nullptr) {
+            schedule_partitioned_event(event_time, &EventHandler<Handler>::invoke, static_cast<CallbackArg>(object));
+            return invalid_event_handle;
+        }
+        return event_queue->schedule_event<Handler>(event_time, object);
+    }
+
+  private:
+    /// event queue of the simulation
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// pool of the chunks of the simulation
+    ChunkPool chunk_pool;
+
+    /// state of the links of the simulation,
+    /// declared after the chunk pool so that pending chunks are destroyed first
+    LinkStore link_store;
+
+    /// whether route fusion is enabled
+    bool route_fusion;
+
+    /// partition of a parallel simulation the context simulates, nullptr if simulated sequentially
+    Partition* partition;
+
+    /**
+     * Schedule an event through the partition.
+     *
+     * @param event_time time to invoke the event
+     * @param callback callback of the event
+     * @param callback_arg argument of the callback
+     */
+    void schedule_partitioned_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,260 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Partition.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+class SimulationPartition;
+
+/**
+ * EventOrigin identifies where an event comes from,
+ * so that events of the same time are ordered by their origins across partitions.
+ */
+struct EventOrigin {
+    /// rank of the event which scheduled the event (0 if scheduled before the simulation runs),
+    /// or SimulationPartition::local_parent_flag | index of the scheduling event
+    /// among the processed events of the current window
+    uint64_t parent;
+
+    /// order of the event among the events its parent scheduled
+    uint64_t child_index;
+};
+
+/**
+ * PendingEvent is an event pending in the event queue of a partition.
+ */
+struct PendingEvent {
+    /// partition the event belongs to
+    SimulationPartition* partition;
+
+    /// origin of the event
+    EventOrigin origin;
+
+    /// callback of the event
+    Callback callback;
+
+    /// argument of the callback
+    CallbackArg callback_arg;
+};
+
+/**
+ * ProcessedEvent records an event processed by a partition in the current window.
+ */
+struct ProcessedEvent {
+    /// time the event has been invoked
+    EventTime event_time;
+
+    /// origin of the event
+    EventOrigin origin;
+};
+
+/**
+ * BoundaryEvent is an event scheduled beyond the current window,
+ * handed over to the partition simulating it once the window ends.
+ */
+struct BoundaryEvent {
+    /// time to invoke the event
+    EventTime event_time;
+
+    /// origin of the event
+    EventOrigin origin;
+
+    /// callback of the event
+    Callback callback;
+
+    /// argument of the callback
+    CallbackArg callback_arg;
+};
+
+/**
+ * SimulationPartition simulates a subset of the devices of a topology, as a part of a ParallelSimulation.
+ *
+ * Each partition simulates on a replica of the topology with its own event queue,
+ * touching the state of its own devices (and their outgoing links) only.
+ * Events beyond the current window (e.g., chunks arriving at the devices of another partition)
+ * are kept as BoundaryEvents, and handed over to their partitions in the order of their origins,
+ * so that events of the same time are invoked in the same order as the sequential simulation.
+ *
+ * Processed events, ranks, and boundary events are double-buffered by the parity of the window,
+ * so that a partition receives the events of the previous window while the others process the current one.
+ */
+class SimulationPartition : public Partition {
+  public:
+    /// time of no event, i.e., later than any event
+    static constexpr EventTime no_event_time = std::numeric_limits<EventTime>::max();
+
+    /// flag of the parent of an event origin, marking the parent as a processed event of the current window
+    static constexpr uint64_t local_parent_flag = uint64_t{1} << 63;
+
+    /**
+     * Get the partition being processed by the calling thread.
+     *
+     * @return pointer to the partition, nullptr if the calling thread isn't processing any
+     */
+    [[nodiscard]] static SimulationPartition* get_current() noexcept;
+
+    /**
+     * Invoke an event pending in a partition, recording it as processed.
+     *
+     * @param event event to invoke
+     */
+    static void invoke_event(PendingEvent* event) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param id id of the partition
+     * @param topology replica of the topology to simulate on
+     * @param partition_per_device id of the partition simulating each device
+     * @param partitions_count number of partitions
+     * @param roots_count number of events scheduled before the simulation runs, shared by the partitions
+     */
+    SimulationPartition(int id,
+                        std::shared_ptr<Topology> topology,
+                        const std::vector<int>& partition_per_device,
+                        int partitions_count,
+                        uint64_t* roots_count) noexcept;
+
+    /**
+     * Get the replica of the topology the partition simulates on.
+     *
+     * @return pointer to the topology
+     */
+    [[nodiscard]] Topology* get_topology() const noexcept;
+
+    /**
+     * Initiate a transmission of a chunk from a device of the partition.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Schedule an event of the network, either into the event queue or as a boundary event.
+     *
+     * @param event_time time to invoke the event
+     * @param callback callback of the event
+     * @param callback_arg argument of the callback
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Receive the boundary events of the previous window sent to this partition,
+     * ordered by their time and origin.
+     *
+     * @param partitions every partition of the simulation
+     * @param parity parity of the previous window
+     */
+    void receive(const std::vector<std::unique_ptr<SimulationPartition>>& partitions, int parity) noexcept;
+
+    /**
+     * Process the events earlier than the end of the window.
+     *
+     * @param window_end end (exclusive) of the window
+     * @param parity parity of the window
+     */
+    void process(EventTime window_end, int parity) noexcept;
+
+    /**
+     * Get the time of the earliest event of the partition, including the boundary events not handed over yet.
+     *
+     * @return time of the earliest event, no_event_time if none
+     */
+    [[nodiscard]] EventTime get_next_event_time() const noexcept;
+
+    /**
+     * Get the events processed in a window, in the order processed.
+     *
+     * @param parity parity of the window
+     * @return processed events
+     */
+    [[nodiscard]] const std::vector<ProcessedEvent>& get_processed_events(int parity) const noexcept;
+
+    /**
+     * Get the ranks of the events processed in a window, to be filled once every partition has processed it.
+     *
+     * @param parity parity of the window
+     * @return rank of each processed event
+     */
+    [[nodiscard]] std::vector<uint64_t>& get_ranks(int parity) noexcept;
+
+  private:
+    /// id of the partition
+    int id;
+
+    /// replica of the topology the partition simulates on
+    std::shared_ptr<Topology> topology;
+
+    /// event queue of the partition
+    EventQueue* event_queue;
+
+    /// id of the partition simulating each device
+    const std::vector<int>& partition_per_device;
+
+    /// number of events scheduled before the simulation runs, shared by the partitions
+    uint64_t* roots_count;
+
+    /// storage of pending events, recycled through free_pending_events
+    std::deque<PendingEvent> pending_events;
+
+    /// released pending events to be recycled
+    std::vector<PendingEvent*> free_pending_events;
+
+    /// events processed in the window of each parity
+    std::vector<ProcessedEvent> processed_events[2];
+
+    /// ranks of the processed events of each parity
+    std::vector<uint64_t> ranks[2];
+
+    /// boundary events scheduled in the window of each parity, per destination partition
+    std::vector<std::vector<BoundaryEvent>> boundary_events[2];
+
+    /// time of the earliest boundary event scheduled in the window of each parity
+    EventTime boundary_events_time[2];
+
+    /// boundary events received, being sorted
+    std::vector<BoundaryEvent> received_events;
+
+    /// end (exclusive) of the current window
+    EventTime window_end;
+
+    /// parity of the current window, or of the window before the first one until the simulation runs
+    int parity;
+
+    /// whether the partition is processing a window
+    bool processing;
+
+    /// index of the event being invoked among the processed events of the current window
+    uint64_t current_event;
+
+    /// number of events the event being invoked has scheduled so far
+    uint64_t children_count;
+
+    /**
+     * Schedule an event into the event queue of the partition.
+     *
+     * @param event_time time to invoke the event
+     * @param origin origin of the event
+     * @param callback callback of the event
+     * @param callback_arg argument of the callback
+     */
+    void enqueue_event(EventTime event_time, EventOrigin origin, Callback callback, CallbackArg callback_arg) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,440 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/LinkStore.h"
+#include "congestion_aware/Partition.h"
+#include "congestion_aware/Topology.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * EventKey orders the events of an optimistic simulation.
+ *
+ * Events are ordered by time, then by depth, so that an event always comes after the event scheduling it,
+ * then by the link scheduling them and the order the link has scheduled them.
+ * Keys are unique, and don't depend on how the devices are partitioned.
+ */
+struct EventKey {
+    /// time to invoke the event
+    EventTime time;
+
+    /// number of ancestors of the same time (i.e., 0 if the parent is of an earlier time)
+    uint32_t depth;
+
+    /// src device of the link scheduling the event
+    DeviceId link_src;
+
+    /// dest device of the link scheduling the event
+    DeviceId link_dest;
+
+    /// order of the event among the events the link has scheduled
+    uint64_t sequence;
+
+    /**
+     * Compare the order of two events.
+     *
+     * @param other key of the other event
+     * @return true if this event comes first, false otherwise
+     */
+    [[nodiscard]] bool operator<(const EventKey& other) const noexcept {
+        return std::tie(time, depth, link_src, link_dest, sequence) <
+               std::tie(other.time, other.depth, other.link_src, other.link_dest, other.sequence);
+    }
+};
+
+/**
+ * Statistics of an optimistic simulation.
+ */
+struct TimeWarpStats {
+    /// number of events invoked, including the ones invoked again after rollbacks
+    uint64_t processed_events_count;
+
+    /// number of events committed, i.e., which can't be rolled back anymore
+    uint64_t committed_events_count;
+
+    /// number of events undone by rollbacks
+    uint64_t rolled_back_events_count;
+
+    /// number of rollbacks, i.e., of stragglers and anti-messages cancelling processed events
+    uint64_t rollbacks_count;
+
+    /// number of anti-messages sent, cancelling events sent to other partitions
+    uint64_t anti_messages_count;
+
+    /// number of rounds, each computing the GVT and processing events
+    uint64_t rounds_count;
+
+    /// maximum number of processed but uncommitted events at once, i.e., of saved states
+    uint64_t peak_uncommitted_events_count;
+
+    /// wall-clock time of the simulation in seconds
+    double wall_time_s;
+
+    /// committed events per wall-clock second
+    double event_rate;
+
+    /// rolled back events / processed events
+    double rollback_ratio;
+};
+
+/**
+ * TimeWarpEvent is an event of an optimistic simulation.
+ */
+struct TimeWarpEvent {
+    /// key ordering the event
+    EventKey key;
+
+    /// callback of the event
+    Callback callback;
+
+    /// argument of the callback
+    CallbackArg callback_arg;
+
+    /// position of the chunk when sent, if the event is a chunk arrival
+    ChunkCursor cursor;
+};
+
+/**
+ * TimeWarpMessage carries an event to the partition simulating it,
+ * or cancels an event sent before (i.e., an anti-message).
+ */
+struct TimeWarpMessage {
+    /// event to schedule, or whose key identifies the event to cancel
+    TimeWarpEvent event;
+
+    /// true if the message cancels the event, false if it schedules the event
+    bool anti;
+};
+
+/**
+ * TimeWarpLog is the incremental state saved by a processed event, to roll it back.
+ * An event works on a single link, except the chunk arrivals at their destinations, which are never rolled back.
+ */
+struct TimeWarpLog {
+    /// processed event
+    TimeWarpEvent* event;
+
+    /// link the event worked on, nullptr if none
+    Link* link;
+
+    /// busy-until time of the link before the event
+    EventTime busy_until;
+
+    /// queue counters of the link before the event
+    LinkQueueCounters queue_counters;
+
+    /// number of pending chunks of the link before the event
+    size_t pending_chunks_count;
+
+    /// first pending chunk of the link before the event, nullptr if none
+    Chunk* front_chunk;
+
+    /// position of the first pending chunk before the event
+    ChunkCursor front_cursor;
+
+    /// number of events the link had scheduled before the event
+    uint64_t link_sequence;
+
+    /// number of events the event has scheduled
+    uint32_t children_count;
+};
+
+/**
+ * TimeWarpPartition simulates a subset of the devices of a topology, as a part of a TimeWarpSimulation.
+ *
+ * Each partition simulates on a replica of the topology, processing its events speculatively in key order.
+ * Before processing an event, the partition saves the state the event may change (the link it works on),
+ * so that the event can be rolled back once a message of an earlier event (a straggler) arrives:
+ * the events processed after the straggler are undone in the reverse order,
+ * and the events they sent to other partitions are cancelled by anti-messages.
+ *
+ * Chunk arrivals at their destinations invoke the callbacks, which can't be undone.
+ * They are processed only once no earlier event can arrive, i.e., once they are committed.
+ */
+class TimeWarpPartition : public Partition {
+  public:
+    /// key later than any event
+    static constexpr EventKey no_event_key = {std::numeric_limits<EventTime>::max(), 0, 0, 0, 0};
+
+    /**
+     * Get the partition being processed by the calling thread.
+     *
+     * @return pointer to the partition, nullptr if the calling thread isn't processing any
+     */
+    [[nodiscard]] static TimeWarpPartition* get_current() noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param id id of the partition
+     * @param topology replica of the topology to simulate on
+     * @param partition_per_device id of the partition simulating each device
+     * @param partitions_count number of partitions
+     */
+    TimeWarpPartition(int id,
+                      std::shared_ptr<Topology> topology,
+                      const std::vector<int>& partition_per_device,
+                      int partitions_count) noexcept;
+
+    /**
+     * Destructor, releasing the records of the events.
+     */
+    ~TimeWarpPartition() noexcept override;
+
+    /**
+     * Get the replica of the topology the partition simulates on.
+     *
+     * @return pointer to the topology
+     */
+    [[nodiscard]] Topology* get_topology() const noexcept;
+
+    /**
+     * Initiate a transmission of a chunk from a device of the partition.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Schedule an event of the network, either locally or by sending it to another partition.
+     *
+     * @param event_time time to invoke the event
+     * @param callback callback of the event
+     * @param callback_arg argument of the callback
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    /**
+     * Receive the messages sent to this partition in the previous step, rolling back on stragglers.
+     * Messages sent from now on belong to the given parity.
+     *
+     * @param partitions every partition of the simulation
+     * @param parity parity of the current step
+     */
+    void receive(const std::vector<std::unique_ptr<TimeWarpPartition>>& partitions, int parity) noexcept;
+
+    /**
+     * Commit the processed events earlier than the GVT, dropping their saved states (i.e., fossil collection).
+     *
+     * @param gvt global virtual time, i.e., the key of the earliest unprocessed event of every partition
+     */
+    void commit(const EventKey& gvt) noexcept;
+
+    /**
+     * Process the events speculatively, in key order.
+     *
+     * @param safe_key events earlier than this key can't be rolled back by the other partitions,
+     *                 i.e., the key of the earliest unprocessed event of the other partitions
+     * @param end_time events of this time or later aren't processed
+     * @param batch_size maximum number of events to process
+     */
+    void process(const EventKey& safe_key, EventTime end_time, uint64_t batch_size) noexcept;
+
+    /**
+     * Get the key of the earliest unprocessed event of the partition.
+     *
+     * @return key of the earliest unprocessed event, no_event_key if none
+     */
+    [[nodiscard]] EventKey get_next_event_key() const noexcept;
+
+    /**
+     * Check whether messages were sent in a step.
+     *
+     * @param parity parity of the step
+     * @return true if any message was sent, false otherwise
+     */
+    [[nodiscard]] bool sent_messages(int parity) const noexcept;
+
+    /**
+     * Get the number of processed events not committed yet.
+     *
+     * @return number of uncommitted events
+     */
+    [[nodiscard]] uint64_t get_uncommitted_events_count() const noexcept;
+
+    /**
+     * Get the time of the last committed event.
+     *
+     * @return time of the last committed event
+     */
+    [[nodiscard]] EventTime get_last_committed_time() const noexcept;
+
+    /**
+     * Get the statistics of the partition.
+     *
+     * @return statistics of the partition, the counters only
+     */
+    [[nodiscard]] const TimeWarpStats& get_stats() const noexcept;
+
+  private:
+    /**
+     * Comparator ordering the events by their keys, finding an event by its key as well.
+     */
+    struct EventOrder {
+        using is_transparent = void;
+
+        [[nodiscard]] bool operator()(const TimeWarpEvent* lhs, const TimeWarpEvent* rhs) const noexcept {
+            return lhs->key < rhs->key;
+        }
+
+        [[nodiscard]] bool operator()(const TimeWarpEvent* lhs, const EventKey& rhs) const noexcept {
+            return lhs->key < rhs;
+        }
+
+        [[nodiscard]] bool operator()(const EventKey& lhs, const TimeWarpEvent* rhs) const noexcept {
+            return lhs < rhs->key;
+        }
+    };
+
+    /**
+     * Event sent by a processed event, to be cancelled if the event is rolled back.
+     */
+    struct SentEvent {
+        /// key of the event
+        EventKey key;
+
+        /// partition the event was sent to
+        int partition;
+    };
+
+    /// id of the partition
+    int id;
+
+    /// replica of the topology the partition simulates on
+    std::shared_ptr<Topology> topology;
+
+    /// event queue of the replica, keeping the current time only
+    EventQueue* event_queue;
+
+    /// link store of the replica
+    LinkStore* link_store;
+
+    /// id of the partition simulating each device
+    const std::vector<int>& partition_per_device;
+
+    /// storage of event records, recycled through free_events
+    std::deque<TimeWarpEvent> events;
+
+    /// released event records to be recycled
+    std::vector<TimeWarpEvent*> free_events;
+
+    /// unprocessed events, ordered by their keys
+    std::set<TimeWarpEvent*, EventOrder> pending_events;
+
+    /// saved states of the processed events not committed yet, in the processed order
+    std::deque<TimeWarpLog> logs;
+
+    /// events sent by the processed events not committed yet, in the sent order
+    std::deque<SentEvent> sent_events;
+
+    /// messages sent in the step of each parity, per destination partition
+    std::vector<std::vector<TimeWarpMessage>> outgoing_messages[2];
+
+    /// messages received, being sorted
+    std::vector<TimeWarpMessage> received_messages;
+
+    /// number of events each link has scheduled, indexed by the link id of the replica
+    std::vector<uint64_t> link_sequences;
+
+    /// positions of the pending chunks put back by rollbacks,
+    /// restored once the chunks are dequeued again (as other partitions may have moved them meanwhile)
+    std::unordered_map<Chunk*, ChunkCursor> requeued_cursors;
+
+    /// parity of the current step
+    int parity;
+
+    /// whether the partition is processing events
+    bool processing;
+
+    /// key of the event being processed
+    EventKey current_key;
+
+    /// earliest key of the events sent to other partitions in the current step
+    EventKey min_sent_key;
+
+    /// time of the last committed event
+    EventTime last_committed_time;
+
+    /// statistics of the partition
+    TimeWarpStats stats;
+
+    /**
+     * Invoke an event, saving the state it changes.
+     *
+     * @param event event to invoke
+     */
+    void execute(TimeWarpEvent* event) noexcept;
+
+    /**
+     * Save the state of a link an event works on.
+     *
+     * @param log saved state of the event
+     * @param link link the event works on
+     */
+    void save_link_state(TimeWarpLog& log, Link* link) noexcept;
+
+    /**
+     * Roll back the processed events later than the given key (or also of the key, if inclusive).
+     *
+     * @param key key of the straggler or of the cancelled event
+     * @param inclusive whether to roll back the event of the key as well
+     */
+    void rollback(const EventKey& key, bool inclusive) noexcept;
+
+    /**
+     * Undo the last processed event, putting it back to the unprocessed events.
+     */
+    void undo() noexcept;
+
+    /**
+     * Check whether an event can't be undone, i.e., a chunk arrival at its destination invoking the callback.
+     *
+     * @param event event to check
+     * @return true if the event can't be undone, false otherwise
+     */
+    [[nodiscard]] static bool irreversible(const TimeWarpEvent* event) noexcept;
+
+    /**
+     * Get the current position of a pending chunk.
+     *
+     * @param chunk pending chunk
+     * @return position of the chunk
+     */
+    [[nodiscard]] ChunkCursor pending_chunk_cursor(Chunk* chunk) const noexcept;
+
+    /**
+     * Allocate a record of an unprocessed event.
+     *
+     * @param event event to copy into the record
+     * @return pointer to the record
+     */
+    [[nodiscard]] TimeWarpEvent* allocate_event(const TimeWarpEvent& event) noexcept;
+
+    /**
+     * Get the number of events a link has scheduled.
+     *
+     * @param link link scheduling events
+     * @return number of events scheduled by the link
+     */
+    [[nodiscard]] uint64_t& link_sequence(const Link* link) noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,162 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/NetworkParser.h"
+#include "common/ThreadPool.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/TimeWarpPartition.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * TimeWarpSimulation simulates a topology on multiple threads,
+ * by optimistic (Time Warp) parallel discrete-event simulation.
+ *
+ * The devices are split into partitions as ParallelSimulation does,
+ * each simulated by a TimeWarpPartition on its own replica of the topology.
+ * Unlike ParallelSimulation, partitions don't wait for each other:
+ * they process their events speculatively, and roll back once an earlier event (a straggler) arrives.
+ * So it needs no lookahead, e.g., for links with zero latency.
+ *
+ * The simulation proceeds in rounds. Each round,
+ *   - partitions exchange the events sent to each other (and the anti-messages of rollbacks) until none is left,
+ *   - the GVT (global virtual time), the earliest unprocessed event of every partition, is computed,
+ *   - partitions commit the events earlier than the GVT, dropping their saved states (fossil collection),
+ *   - partitions process up to batch_size events earlier than GVT + optimism_window.
+ * The optimism window bounds how far partitions run ahead of the GVT, and so the saved states.
+ *
+ * Events of the same time are ordered by their EventKeys, deterministically and regardless of the number of threads,
+ * which may differ from the sequential simulation (i.e., in the scheduled order) for the events of the same time.
+ *
+ * Chunks are sent before run(), or from the callbacks of arrived chunks from a device of the same partition
+ * (e.g., the device the chunk arrived at).
+ * Callbacks are invoked once committed, so they are never rolled back.
+ * Chunks should be allocated by themselves (e.g., std::make_unique<Chunk>), not from the chunk pool of a topology.
+ * Route fusion isn't supported.
+ */
+class TimeWarpSimulation {
+  public:
+    /// default optimism window in ns
+    static constexpr EventTime default_optimism_window = 2'000;
+
+    /// default maximum number of events a partition processes per round
+    static constexpr uint64_t default_batch_size = 1'024;
+
+    /**
+     * Constructor.
+     *
+     * @param network_parser NetworkParser to parse the network input file
+     * @param threads_count number of worker threads (i.e., partitions) including the calling thread,
+     *                      or 0 to use every hardware thread
+     * @param optimism_window how far (in ns) partitions may process beyond the GVT, at least 1
+     * @param batch_size maximum number of events a partition processes per round, at least 1
+     */
+    explicit TimeWarpSimulation(const NetworkParser& network_parser,
+                                int threads_count = 0,
+                                EventTime optimism_window = default_optimism_window,
+                                uint64_t batch_size = default_batch_size) noexcept;
+
+    /**
+     * Initiate a transmission of a chunk.
+     * Should be called before run(), or from the callback of a chunk arrived at a device of the same partition.
+     *
+     * @param chunk chunk to be transmitted
+     */
+    void send(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Run the simulation until every event is committed.
+     */
+    void run() noexcept;
+
+    /**
+     * Get the current simulation time.
+     * In a callback, the time the chunk arrived; otherwise, the time of the last committed event.
+     *
+     * @return current simulation time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Get the number of partitions.
+     *
+     * @return number of partitions
+     */
+    [[nodiscard]] int get_partitions_count() const noexcept;
+
+    /**
+     * Get the partition simulating a device.
+     *
+     * @param device id of the device
+     * @return id of the partition
+     */
+    [[nodiscard]] int get_partition(DeviceId device) const noexcept;
+
+    /**
+     * Get the statistics of the simulation so far,
+     * e.g., the committed event rate and the ratio of the rolled back events.
+     *
+     * @return statistics of the simulation
+     */
+    [[nodiscard]] TimeWarpStats get_stats() const noexcept;
+
+    /**
+     * Get the queueing statistics of the link src -> dest.
+     *
+     * @param src src device id of the link
+     * @param dest dest device id of the link
+     * @return queueing statistics of the link
+     */
+    [[nodiscard]] LinkStats get_link_stats(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Get the number of NPUs in the topology.
+     *
+     * @return number of NPUs
+     */
+    [[nodiscard]] int get_npus_count() const noexcept;
+
+  private:
+    /// worker threads, processing a partition per task
+    ThreadPool thread_pool;
+
+    /// id of the partition simulating each device
+    std::vector<int> partition_per_device;
+
+    /// partitions of the simulation
+    std::vector<std::unique_ptr<TimeWarpPartition>> partitions;
+
+    /// how far partitions may process beyond the GVT
+    EventTime optimism_window;
+
+    /// maximum number of events a partition processes per round
+    uint64_t batch_size;
+
+    /// parity of the last step
+    int parity;
+
+    /// number of rounds so far
+    uint64_t rounds_count;
+
+    /// maximum number of uncommitted events at once
+    uint64_t peak_uncommitted_events_count;
+
+    /// wall-clock time of the simulation in seconds
+    double wall_time_s;
+
+    /// whether the simulation is running or has run
+    bool started;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
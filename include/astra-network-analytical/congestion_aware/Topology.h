@@ -7,8 +7,16 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/EventQueue.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/ChunkPool.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/Route.h"
+#include "congestion_aware/SimulationContext.h"
+#include <cassert>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -17,24 +25,80 @@ namespace NetworkAnalyticalCongestionAware {
 
 /**
  * Topology abstracts a network topology.
+ * Each topology simulates within its own SimulationContext.
  */
 class Topology {
   public:
     /**
-     * Set the event queue to be used by the topology.
+     * Proceed the event queue to the next event time.
+     * Link-free and chunk-arrival events (including fused ones) are dispatched to their handlers directly
+     * (i.e., without an indirect call), while other events are invoked as usual.
      *
-     * @param event_queue pointer to the event queue
+     * @param event_queue event queue to proceed
+     */
+    static void proceed(EventQueue& event_queue) noexcept;
+
+    /**
+     * Invoke every event of the event queue until the given time (inclusive),
+     * dispatching the events of the network directly as proceed() does (see EventQueue::run_until).
+     *
+     * @param event_queue event queue to run
+     * @param end_time time to run until, should not be earlier than the current time
      */
-    static void set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept;
+    static void run_until(EventQueue& event_queue, EventTime end_time) noexcept;
+
+    /**
+     * Invoke up to the given number of events of the event queue,
+     * dispatching the events of the network directly as proceed() does (see EventQueue::run_events).
+     *
+     * @param event_queue event queue to run
+     * @param events_count maximum number of events to invoke
+     * @return number of invoked events, less than events_count only if no event is left
+     */
+    static uint64_t run_events(EventQueue& event_queue, uint64_t events_count) noexcept;
 
     /**
      * Constructor.
      */
     Topology() noexcept;
 
+    /**
+     * Set the event queue to be used by the topology.
+     * A topology creates an event queue of its own unless set.
+     * Should be called before any chunk is sent.
+     *
+     * @param event_queue pointer to the event queue
+     */
+    void set_event_queue(std::shared_ptr<EventQueue> event_queue) noexcept;
+
+    /**
+     * Get the event queue used by the topology.
+     *
+     * @return pointer to the event queue
+     */
+    [[nodiscard]] std::shared_ptr<EventQueue> get_event_queue() const noexcept;
+
+    /**
+     * Enable or disable route fusion, disabled by default.
+     * When enabled, a chunk whose whole multi-hop route is free of other traffic
+     * is transmitted with a single arrival event (see FusedTransmission).
+     *
+     * @param enabled true to enable route fusion, false to disable it
+     */
+    void set_route_fusion(bool enabled) noexcept;
+
+    /**
+     * Get the simulation context of the topology.
+     *
+     * @return pointer to the simulation context
+     */
+    [[nodiscard]] SimulationContext* get_context() const noexcept {
+        return context.get();
+    }
+
     /**
      * Construct the route from src to dest.
-     * Route is a list of devices (pointers) that the chunk should traverse,
+     * Route is a sequence of device ids that the chunk should traverse,
      * including the src and dest devices themselves.
      *
      * e.g., route(0, 3) = [0, 5, 7, 2, 3]
@@ -46,6 +110,69 @@ class Topology {
      */
     [[nodiscard]] virtual Route route(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Get the next device a chunk at the current device should move to, to reach dest.
+     * Following next_hop from src yields the same devices as route(src, dest),
+     * so that routeless chunks don't have to carry their routes.
+     *
+     * e.g., if route(0, 3) = [0, 5, 7, 2, 3], then next_hop(5, 3) = 7
+     *
+     * @param current current device id, either an NPU or a non-NPU device on the route
+     * @param dest dest NPU id, different from current
+     *
+     * @return next device id
+     */
+    [[nodiscard]] virtual DeviceId next_hop(DeviceId current, DeviceId dest) const noexcept = 0;
+
+    /**
+     * Create a routeless chunk from src to dest, routed through this topology by next_hop.
+     * The chunk is allocated from the chunk pool of the topology,
+     * so it shouldn't outlive the topology.
+     *
+     * @param chunk_size size of the chunk
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param callback callback to be invoked when the chunk arrives dest
+     * @param callback_arg argument of the callback
+     * @return the created chunk
+     */
+    [[nodiscard]] std::unique_ptr<Chunk> make_chunk(
+        ChunkSize chunk_size, DeviceId src, DeviceId dest, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Create a routed chunk carrying the given route (e.g., by route()).
+     * The chunk is allocated from the chunk pool of the topology,
+     * so it shouldn't outlive the topology.
+     *
+     * @param chunk_size size of the chunk
+     * @param route route of the chunk through this topology, from its src to dest
+     * @param callback callback to be invoked when the chunk arrives dest
+     * @param callback_arg argument of the callback
+     * @return the created chunk
+     */
+    [[nodiscard]] std::unique_ptr<Chunk> make_chunk(ChunkSize chunk_size,
+                                                    Route route,
+                                                    Callback callback,
+                                                    CallbackArg callback_arg) noexcept;
+
+    /**
+     * Get the allocation counters of the chunk pool of the topology.
+     *
+     * @return allocation counters of the chunk pool
+     */
+    [[nodiscard]] ChunkPoolStats get_chunk_pool_stats() const noexcept;
+
+    /**
+     * Get the queueing statistics of the link src -> dest,
+     * e.g., to find the bottleneck links of a collective.
+     * Every link can be visited through get_connections().
+     *
+     * @param src src device id of the link
+     * @param dest dest device id of the link
+     * @return queueing statistics of the link
+     */
+    [[nodiscard]] LinkStats get_link_stats(DeviceId src, DeviceId dest) const noexcept;
+
     /**
      * Initiate a transmission of a chunk.
      *
@@ -53,6 +180,25 @@ class Topology {
      */
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
+    /**
+     * Get a device of the topology.
+     *
+     * @param id id of the device
+     * @return pointer to the device
+     */
+    [[nodiscard]] Device* get_device(DeviceId id) const noexcept {
+        assert(0 <= id && id < devices_count);
+
+        return devices[id].get();
+    }
+
+    /**
+     * Get the connections of the topology.
+     *
+     * @return (src, dest) device ids of every link, sorted
+     */
+    [[nodiscard]] std::vector<std::pair<DeviceId, DeviceId>> get_connections() const noexcept;
+
     /**
      * Get the number of NPUs in the topology.
      * NPU excludes non-NPU devices such as switches.
@@ -111,14 +257,53 @@ class Topology {
     /// bandwidth per each network dimension
     std::vector<Bandwidth> bandwidth_per_dim;
 
+    /// simulation context of the topology,
+    /// held by pointer so that devices, links, and pooled chunks can find it even if the topology is moved
+    std::unique_ptr<SimulationContext> context;
+
+    /// holds the entire link instances (i.e., views of the link store) in the topology contiguously,
+    /// grouped by their src device and sorted by their dest device
+    std::vector<Link> links;
+
+    /// dest device id of each link
+    std::vector<DeviceId> links_dests;
+
+    /// src device id of each link, only kept until the links are built
+    std::vector<DeviceId> links_srcs;
+
+    /// parameters of each link, only kept until the links are built
+    std::vector<const LinkParameters*> links_staged_parameters;
+
+    /// links of device i are links[links_offsets[i]] to links[links_offsets[i + 1] - 1]
+    std::vector<size_t> links_offsets;
+
+    /// distinct bandwidth and latency pairs of the links, shared by the links
+    /// (held in a deque so that links can point to them)
+    std::deque<LinkParameters> links_parameters;
+
     /**
      * Instantiate Device objects in the topology.
      */
     void instantiate_devices() noexcept;
 
+    /**
+     * Reserve the link table for the given number of links.
+     *
+     * @param links_count number of links the topology will hold
+     */
+    void reserve_links(size_t links_count) noexcept;
+
+    /**
+     * Build the link table out of the connections made so far,
+     * and hand each device its range of links.
+     * Should be called once, after every connect() call.
+     */
+    void build_links() noexcept;
+
     /**
      * Connect src -> dest with the given bandwidth and latency.
      * (i.e., a `Link` gets constructed between the two npus)
+     * The connection takes effect once build_links() is called.
      *
      * if bidirectional=true, dest -> src connection is also established.
      *
@@ -129,6 +314,29 @@ class Topology {
      * @param bidirectional true if connection is bidirectional, false otherwise
      */
     void connect(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
+
+    /**
+     * Connect every pair of devices in [first, last] in both directions, with the given bandwidth and latency.
+     * Unlike connect(), links are instantiated lazily on their first use (see Device::set_implicit_links),
+     * so that large fully-connected topologies take memory only for the links actually used.
+     * The devices shouldn't have any other link.
+     *
+     * @param first id of the first device
+     * @param last id of the last device
+     * @param bandwidth bandwidth of link
+     * @param latency latency of link
+     */
+    void connect_fully(DeviceId first, DeviceId last, Bandwidth bandwidth, Latency latency) noexcept;
+
+    /**
+     * Get the shared parameters of links with the given bandwidth and latency,
+     * creating them on the first request.
+     *
+     * @param bandwidth bandwidth of link
+     * @param latency latency of link
+     * @return pointer to the link parameters, valid as long as the topology
+     */
+    [[nodiscard]] const LinkParameters* get_link_parameters(Bandwidth bandwidth, Latency latency) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
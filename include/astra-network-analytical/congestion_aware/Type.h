@@ -5,17 +5,17 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include <list>
-#include <memory>
-
 namespace NetworkAnalyticalCongestionAware {
 
 /// Forward declarations of network components
 class Chunk;
+class ChunkPool;
+class SimulationContext;
 class Link;
 class Device;
-
-/// Route is a list of devices
-using Route = std::list<std::shared_ptr<Device>>;
+class FusedTransmission;
+class Partition;
+class Route;
+class Topology;
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -7,6 +7,11 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/Topology.h"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -38,6 +43,115 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_batch method of Topology,
+     * computing hops counts and then delays over blocks of chunks with vectorized loops.
+     * Hops counts are computed even in the precomputed mode, as it's cheaper than looking them up.
+     * Delays are the same as send(), except they may differ by rounding (i.e., by 1 ns at most)
+     * when the hardware fuses the latency multiplication and the addition.
+     */
+    void send_batch(const DeviceId* srcs,
+                    const DeviceId* dests,
+                    const ChunkSize* chunk_sizes,
+                    EventTime* delays,
+                    size_t count) const noexcept override;
+
+    /**
+     * Compute the number of hops of each (src, dest) pair with a vectorized loop.
+     * Pairs whose src and dest are the same get an arbitrary hops count.
+     *
+     * @param srcs src NPU ID of each pair
+     * @param dests dest NPU ID of each pair
+     * @param hops_counts (out) number of hops of each pair
+     * @param count number of pairs
+     */
+    virtual void compute_hops_counts(const DeviceId* srcs,
+                                     const DeviceId* dests,
+                                     int* hops_counts,
+                                     size_t count) const noexcept = 0;
+
+    /**
+     * Get the latency of each link.
+     *
+     * @return latency of each link in ns
+     */
+    [[nodiscard]] Latency get_latency() const noexcept {
+        return latency;
+    }
+
+    /**
+     * Get the bandwidth of each link in B/ns.
+     *
+     * @return bandwidth of each link in B/ns
+     */
+    [[nodiscard]] Bandwidth get_bandwidth_Bpns() const noexcept {
+        return bandwidth_Bpns;
+    }
+
+    /**
+     * Implement the precompute_delays method of Topology.
+     */
+    size_t precompute_delays(size_t max_tables_bytes) noexcept override;
+
+    /**
+     * Check whether the topology is in the precomputed mode.
+     *
+     * @return true if precompute_delays has been called, false otherwise
+     */
+    [[nodiscard]] bool delays_precomputed() const noexcept {
+        return precomputed;
+    }
+
+    /**
+     * Estimate the communication delay in the precomputed mode,
+     * i.e., (hops count) * latency + (chunk size) * (inverse bandwidth) in a single FMA,
+     * with the hops count looked up from the table if built.
+     * Defined here so that MultiDimTopology can inline it.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk to send
+     * @return time to send the chunk from src to dest
+     */
+    [[nodiscard]] EventTime send_precomputed(const DeviceId src,
+                                             const DeviceId dest,
+                                             const ChunkSize chunk_size) const noexcept {
+        assert(precomputed);
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        const auto hops_count =
+            hops_table.empty() ? compute_hops_count(src, dest) : hops_table[(src * npus_count) + dest];
+        const auto delay = std::fma(static_cast<double>(hops_count), latency,
+                                    static_cast<double>(chunk_size) * inverse_bandwidth_nspB);
+        return static_cast<EventTime>(delay);
+    }
+
+    /**
+     * Analytically compute the communication delay.
+     * Defined here so that StaticMultiDimTopology can inline it.
+     *
+     * @param hops_count number of hops between src and dest
+     * @param chunk_size size of the chunk
+     * @return communication delay to send a chunk between src and dest
+     */
+    [[nodiscard]] EventTime compute_communication_delay(const int hops_count,
+                                                        const ChunkSize chunk_size) const noexcept {
+        assert(hops_count > 0);
+        assert(chunk_size > 0);
+
+        // compute link delay and serialization delay
+        const auto link_delay = hops_count * latency;
+        const auto serialization_delay = static_cast<double>(chunk_size) / bandwidth_Bpns;
+
+        // comms_delay is the summation of the two
+        const auto comms_delay = link_delay + serialization_delay;
+
+        // return EventTime type of comms_delay
+        return static_cast<EventTime>(comms_delay);
+    }
+
     /**
      * Return the type of the basic topology
      * as a TopologyBuildingBlock enum class element.
@@ -46,7 +160,6 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] TopologyBuildingBlock get_basic_topology_type() const noexcept;
 
-  protected:
     /**
      * Compute the number of hops between src and dest.
      *
@@ -56,18 +169,11 @@ class BasicTopology : public Topology {
      */
     [[nodiscard]] virtual int compute_hops_count(DeviceId src, DeviceId dest) const noexcept = 0;
 
+  protected:
     /// type of the basic topology
     TopologyBuildingBlock basic_topology_type;
 
   private:
-    /**
-     * Analytically compute the communication delay.
-     *
-     * @param hops_count number of hops between src and dest
-     * @param chunk_size size of the chunk
-     * @return communication delay to send a chunk between src and dest
-     */
-    [[nodiscard]] EventTime compute_communication_delay(int hops_count, ChunkSize chunk_size) const noexcept;
 
     /// bandwidth of each link in GB/s
     Bandwidth bandwidth;
@@ -77,6 +183,16 @@ class BasicTopology : public Topology {
 
     /// latency of each link in ns
     Latency latency;
+
+    /// whether the topology is in the precomputed mode
+    bool precomputed;
+
+    /// inverse bandwidth of each link in ns/B, used in the precomputed mode
+    double inverse_bandwidth_nspB;
+
+    /// hops count of every (src, dest) pair, indexed by src * npus_count + dest,
+    /// or empty if the table doesn't fit
+    std::vector<uint8_t> hops_table;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
+#include <cassert>
 
 using namespace NetworkAnalytical;
 
@@ -35,11 +36,26 @@ class FullyConnected final : public BasicTopology {
      */
     FullyConnected(int npus_count, Bandwidth bandwidth, Latency latency) noexcept;
 
-  private:
+    /**
+     * Implements the compute_hops_counts method of BasicTopology.
+     */
+    void compute_hops_counts(const DeviceId* srcs,
+                             const DeviceId* dests,
+                             int* hops_counts,
+                             size_t count) const noexcept override;
+
     /**
      * Implements the compute_hops_count method of BasicTopology.
+     * Defined here so that StaticMultiDimTopology can inline it.
      */
-    [[nodiscard]] int compute_hops_count(DeviceId src, DeviceId dest) const noexcept override;
+    [[nodiscard]] int compute_hops_count(const DeviceId src, const DeviceId dest) const noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+        assert(src != dest);
+
+        // for FullyConnected, hops_count is always 1 (src -> dest)
+        return 1;
+    }
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
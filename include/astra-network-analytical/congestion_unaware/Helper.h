@@ -6,6 +6,8 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
 #include "congestion_unaware/Topology.h"
 #include <memory>
 
@@ -13,6 +15,20 @@ using namespace NetworkAnalytical;
 
 namespace NetworkAnalyticalCongestionUnaware {
 
+/**
+ * Construct a basic topology of the given building block.
+ *
+ * @param topology_type building block of the topology
+ * @param npus_count number of NPUs in the topology
+ * @param bandwidth bandwidth of each link in the topology
+ * @param latency latency of each link in the topology
+ * @return pointer to the constructed basic topology
+ */
+[[nodiscard]] std::unique_ptr<BasicTopology> construct_basic_topology(TopologyBuildingBlock topology_type,
+                                                                      int npus_count,
+                                                                      Bandwidth bandwidth,
+                                                                      Latency latency) noexcept;
+
 /**
  * Construct a topology from a NetworkParser.
  *
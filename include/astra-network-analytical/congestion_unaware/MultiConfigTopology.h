@@ -0,0 +1,127 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/FastDivisor.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * MultiConfigTopology evaluates multiple configurations of the same topology shape at once,
+ * e.g., for design-space exploration over bandwidth and latency variants.
+ *
+ * The shape (i.e., the building block and number of NPUs of each dimension) is shared,
+ * while each configuration has its own bandwidth and latency per dimension.
+ * Each send decodes the src and dest addresses once (i.e., the dimension to transfer and its hops count),
+ * then computes the delay of every configuration in a vectorized loop, a configuration per SIMD lane.
+ * The delay of each configuration is the same as send() of the topology constructed with that configuration,
+ * except it may differ by rounding (i.e., by 1 ns at most)
+ * when the hardware fuses the latency multiplication and the addition.
+ */
+class MultiConfigTopology {
+  public:
+    /**
+     * Constructor, taking the shape and the first configuration from a NetworkParser.
+     *
+     * @param network_parser NetworkParser to parse the network input file
+     */
+    explicit MultiConfigTopology(const NetworkParser& network_parser) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param topologies_per_dim building block of each dimension
+     * @param npus_counts_per_dim number of NPUs of each dimension
+     * @param bandwidths_per_dim bandwidth (GB/s) of each dimension in the first configuration
+     * @param latencies_per_dim latency (ns) of each dimension in the first configuration
+     */
+    MultiConfigTopology(const std::vector<TopologyBuildingBlock>& topologies_per_dim,
+                        const std::vector<int>& npus_counts_per_dim,
+                        const std::vector<Bandwidth>& bandwidths_per_dim,
+                        const std::vector<Latency>& latencies_per_dim) noexcept;
+
+    /**
+     * Add a configuration of the topology.
+     *
+     * @param bandwidths_per_dim bandwidth (GB/s) of each dimension
+     * @param latencies_per_dim latency (ns) of each dimension
+     * @return id of the added configuration
+     */
+    int add_config(const std::vector<Bandwidth>& bandwidths_per_dim,
+                   const std::vector<Latency>& latencies_per_dim) noexcept;
+
+    /**
+     * Estimate the time to be taken to transmit a chunk from src NPU to dest NPU, in every configuration.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @param chunk_size size of the chunk to send
+     * @param delays (out) time to send the chunk in each configuration, indexed by the configuration id
+     */
+    void send(DeviceId src, DeviceId dest, ChunkSize chunk_size, EventTime* delays) const noexcept;
+
+    /**
+     * Estimate the time to be taken to transmit each of the given chunks, in every configuration.
+     *
+     * @param srcs src NPU ID of each chunk
+     * @param dests dest NPU ID of each chunk
+     * @param chunk_sizes size of each chunk
+     * @param delays (out) time to send each chunk in each configuration,
+     *               i.e., delays[i * (number of configurations) + config] for chunk i
+     * @param count number of chunks
+     */
+    void send_batch(const DeviceId* srcs,
+                    const DeviceId* dests,
+                    const ChunkSize* chunk_sizes,
+                    EventTime* delays,
+                    size_t count) const noexcept;
+
+    /**
+     * Get the number of configurations.
+     *
+     * @return number of configurations
+     */
+    [[nodiscard]] int get_configs_count() const noexcept;
+
+    /**
+     * Get the number of NPUs in the topology.
+     *
+     * @return number of NPUs
+     */
+    [[nodiscard]] int get_npus_count() const noexcept;
+
+  private:
+    /// number of NPUs in the topology
+    int npus_count;
+
+    /// number of network dimensions of the topology
+    int dims_count;
+
+    /// number of configurations
+    int configs_count;
+
+    /// BasicTopology instances per dimension, used for hops counts only
+    std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
+
+    /// number of NPUs per each dimension, as divisors of NPU IDs
+    std::vector<FastDivisor> npus_count_divisor_per_dim;
+
+    /// latency (ns) of each configuration, per each dimension
+    std::vector<std::vector<Latency>> latencies_per_dim;
+
+    /// bandwidth (B/ns) of each configuration, per each dimension
+    std::vector<std::vector<Bandwidth>> bandwidths_Bpns_per_dim;
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
@@ -5,6 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
+#include "common/FastDivisor.h"
 #include "common/Type.h"
 #include "congestion_unaware/BasicTopology.h"
 #include "congestion_unaware/Topology.h"
@@ -27,9 +28,41 @@ class MultiDimTopology : public Topology {
 
     /**
      * Implement the send method of Topology.
+     * The chunk is transferred within the lowest dimension where the src and dest addresses differ.
+     * Takes no heap allocation.
      */
     [[nodiscard]] EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept override;
 
+    /**
+     * Implement the send_batch method of Topology.
+     * Each block of chunks goes through the dimensions one by one with vectorized loops:
+     * addresses are peeled off, hops counts are computed by the dimension,
+     * and the lowest dimension where the src and dest addresses differ is selected without branches.
+     * Delays are then computed at once with the hops count, latency, and bandwidth of the selected dimension.
+     * Delays are the same as send(), except they may differ by rounding (i.e., by 1 ns at most)
+     * when the hardware fuses the latency multiplication and the addition.
+     */
+    void send_batch(const DeviceId* srcs,
+                    const DeviceId* dests,
+                    const ChunkSize* chunk_sizes,
+                    EventTime* delays,
+                    size_t count) const noexcept override;
+
+    /**
+     * Implement the compute_delay_row method of Topology, exploiting the block structure of the matrix:
+     * a row is the row of the highest dimension, expanded dimension by dimension down to the lowest one.
+     * In each dimension, dests whose address differs from src take the delay of the dimension,
+     * which is the same for every block of the higher dimensions,
+     * so only a row per dimension is computed and the rest is copied.
+     */
+    void compute_delay_row(DeviceId src, ChunkSize chunk_size, EventTime* delays) const noexcept override;
+
+    /**
+     * Implement the precompute_delays method of Topology,
+     * tabulating each dimension within the remaining bound.
+     */
+    size_t precompute_delays(size_t max_tables_bytes) noexcept override;
+
     /**
      * Add a dimension to the multi-dimensional topology.
      *
@@ -38,33 +71,17 @@ class MultiDimTopology : public Topology {
     void append_dimension(std::unique_ptr<BasicTopology> basic_topology) noexcept;
 
   private:
-    /// Each NPU ID can be broken down into multiple dimensions.
-    /// for example, if the topology size is [2, 8, 4] and the NPU ID is 31,
-    /// then the NPU ID can be broken down into [1, 7, 1].
-    using MultiDimAddress = std::vector<DeviceId>;
-
     /// BasicTopology instances per dimension.
     std::vector<std::unique_ptr<BasicTopology>> topology_per_dim;
 
-    /**
-     * Translate the NPU ID into a multi-dimensional address.
-     *
-     * @param npu_id id of the NPU
-     * @return the same NPU in multi-dimensional address representation
-     */
-    [[nodiscard]] MultiDimAddress translate_address(DeviceId npu_id) const noexcept;
+    /// number of NPUs per each dimension, as divisors of NPU IDs.
+    /// Each NPU ID can be broken down into multiple dimensions,
+    /// e.g., if the topology size is [2, 8, 4] and the NPU ID is 31,
+    /// then the NPU ID can be broken down into [1, 7, 1].
+    std::vector<FastDivisor> npus_count_divisor_per_dim;
 
-    /**
-     * Given src and dest address in multi-dimensional form,
-     * return the dimension where the transfer should happen.
-     * i.e., the dimension where the src and dest addresses differ.
-     *
-     * @param src_address src NPU ID in multi-dimensional form
-     * @param dest_address dest NPU ID in multi-dimensional form
-     * @return the dimension where the transfer should happen
-     */
-    [[nodiscard]] int get_dim_to_transfer(const MultiDimAddress& src_address,
-                                          const MultiDimAddress& dest_address) const noexcept;
+    /// whether the topology is in the precomputed mode
+    bool precomputed;
 };
 
 }  // namespace NetworkAnalyticalCongestionUnaware
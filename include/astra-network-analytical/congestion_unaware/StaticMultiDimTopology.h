@@ -0,0 +1,167 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/FastDivisor.h"
+#include "common/Type.h"
+#include "congestion_unaware/BasicTopology.h"
+#include "congestion_unaware/Topology.h"
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionUnaware {
+
+/**
+ * StaticMultiDimTopology implements a multi-dimensional topology whose shape is fixed at compile time,
+ * e.g., StaticMultiDimTopology<Ring, FullyConnected, Switch>.
+ *
+ * Each dimension is held by value as its final building block type,
+ * so that send() is unrolled over the dimensions and the hop computation of each dimension gets inlined,
+ * instead of going through virtual calls and a loop over dims_count as MultiDimTopology does.
+ * Delays are exactly the same as those of the equivalent MultiDimTopology.
+ *
+ * @tparam Dims building blocks of each dimension, from the lowest one
+ */
+template <typename... Dims> class StaticMultiDimTopology final : public Topology {
+    static_assert(sizeof...(Dims) > 0, "at least a dimension is required");
+    static_assert((std::is_base_of_v<BasicTopology, Dims> && ...), "dimensions should be basic topologies");
+    static_assert((std::is_final_v<Dims> && ...), "dimensions should be final, so that their hops are inlined");
+
+  public:
+    /// number of network dimensions
+    static constexpr int static_dims_count = sizeof...(Dims);
+
+    /**
+     * Constructor.
+     *
+     * @param dims basic topology of each dimension, from the lowest one
+     */
+    explicit StaticMultiDimTopology(Dims... dims) noexcept
+        : Topology(),
+          dims(std::move(dims)...),
+          npus_count_divisor_per_dim(),
+          precomputed(false) {
+        // initialize topology shape
+        npus_count = 1;
+        dims_count = 0;
+        std::apply([this](const auto&... dim) { (append_dimension_shape(dim), ...); }, this->dims);
+        assert(dims_count == static_dims_count);
+    }
+
+    /**
+     * Implement the send method of Topology.
+     * The chunk is transferred within the lowest dimension where the src and dest addresses differ,
+     * as MultiDimTopology does.
+     */
+    [[nodiscard]] EventTime send(const DeviceId src, const DeviceId dest, const ChunkSize chunk_size) const
+        noexcept override {
+        assert(0 <= src && src < npus_count);
+        assert(0 <= dest && dest < npus_count);
+
+        return send_from_dim<0>(src, dest, chunk_size);
+    }
+
+    /**
+     * Implement the precompute_delays method of Topology,
+     * tabulating each dimension within the remaining bound.
+     */
+    size_t precompute_delays(const size_t max_tables_bytes) noexcept override {
+        // tabulate lower dimensions first, within the remaining bound
+        auto tables_bytes = size_t{0};
+        std::apply(
+            [&](auto&... dim) { ((tables_bytes += dim.precompute_delays(max_tables_bytes - tables_bytes)), ...); },
+            dims);
+        assert(tables_bytes <= max_tables_bytes);
+
+        precomputed = true;
+        return tables_bytes;
+    }
+
+    /**
+     * Get the basic topology of a dimension.
+     *
+     * @tparam Dim index of the dimension
+     * @return basic topology of the dimension
+     */
+    template <int Dim> [[nodiscard]] const auto& get_dim() const noexcept {
+        return std::get<Dim>(dims);
+    }
+
+  private:
+    /// basic topology of each dimension
+    std::tuple<Dims...> dims;
+
+    /// number of NPUs per each dimension, as divisors of NPU IDs
+    std::array<FastDivisor, sizeof...(Dims)> npus_count_divisor_per_dim;
+
+    /// whether the topology is in the precomputed mode
+    bool precomputed;
+
+    /**
+     * Append the shape of a dimension to the topology shape.
+     *
+     * @param dim basic topology of the dimension
+     */
+    void append_dimension_shape(const BasicTopology& dim) noexcept {
+        const auto dim_npus_count = dim.get_npus_count();
+        npus_count_divisor_per_dim[dims_count] = FastDivisor(dim_npus_count);
+        npus_count *= dim_npus_count;
+        npus_count_per_dim.push_back(dim_npus_count);
+        bandwidth_per_dim.push_back(dim.get_bandwidth_per_dim()[0]);
+        dims_count++;
+    }
+
+    /**
+     * Peel off the address of src and dest in a dimension,
+     * sending the chunk within the dimension if they differ, or moving on to the next dimension otherwise.
+     *
+     * @tparam Dim index of the dimension
+     * @param src_leftover src NPU ID with the lower dimensions peeled off
+     * @param dest_leftover dest NPU ID with the lower dimensions peeled off
+     * @param chunk_size size of the chunk to send
+     * @return time to send the chunk from src to dest
+     */
+    template <int Dim>
+    [[nodiscard]] EventTime send_from_dim(const DeviceId src_leftover,
+                                          const DeviceId dest_leftover,
+                                          const ChunkSize chunk_size) const noexcept {
+        if constexpr (Dim == static_dims_count) {
+            // shouldn't reach here
+            std::cerr << "[Error] (network/analytical/congestion_unaware): " << "src and dest have the same address"
+                      << std::endl;
+            std::exit(-1);
+        } else {
+            // get the address in this dimension
+            const auto& npus_count_divisor = std::get<Dim>(npus_count_divisor_per_dim);
+            const auto src_quotient = npus_count_divisor.divide(src_leftover);
+            const auto dest_quotient = npus_count_divisor.divide(dest_leftover);
+            const auto src_local_id = src_leftover - (src_quotient * npus_count_divisor.get_divisor());
+            const auto dest_local_id = dest_leftover - (dest_quotient * npus_count_divisor.get_divisor());
+
+            // the first dim that has different address is the dim to transfer
+            if (src_local_id != dest_local_id) {
+                const auto& dim = std::get<Dim>(dims);
+                if (precomputed) {
+                    return dim.send_precomputed(src_local_id, dest_local_id, chunk_size);
+                }
+                const auto hops_count = dim.compute_hops_count(src_local_id, dest_local_id);
+                return dim.compute_communication_delay(hops_count, chunk_size);
+            }
+
+            // move on to the next dimension
+            return send_from_dim<Dim + 1>(src_quotient, dest_quotient, chunk_size);
+        }
+    }
+};
+
+}  // namespace NetworkAnalyticalCongestionUnaware
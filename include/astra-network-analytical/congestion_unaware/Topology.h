@@ -6,6 +6,8 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include <cstddef>
+#include <string>
 #include <vector>
 
 using namespace NetworkAnalytical;
@@ -33,6 +35,66 @@ class Topology {
      */
     [[nodiscard]] virtual EventTime send(DeviceId src, DeviceId dest, ChunkSize chunk_size) const noexcept = 0;
 
+    /**
+     * Estimate the time to be taken to transmit each of the given chunks,
+     * i.e., delays[i] = send(srcs[i], dests[i], chunk_sizes[i]) for every i < count.
+     * Topologies override this to process the chunks with vectorized loops,
+     * so that a whole collective phase is answered at once.
+     *
+     * @param srcs src NPU ID of each chunk
+     * @param dests dest NPU ID of each chunk
+     * @param chunk_sizes size of each chunk
+     * @param delays (out) time to send each chunk from its src to dest
+     * @param count number of chunks
+     */
+    virtual void send_batch(const DeviceId* srcs,
+                            const DeviceId* dests,
+                            const ChunkSize* chunk_sizes,
+                            EventTime* delays,
+                            size_t count) const noexcept;
+
+    /**
+     * Switch to the precomputed mode:
+     * hop counts are looked up from a table per dimension, and delays take a single FMA
+     * with the latency and inverse bandwidth of the dimension.
+     * Delays may differ from the default mode by rounding (i.e., by 1 ns at most).
+     *
+     * Tables take (number of NPUs)^2 bytes per dimension and are built within the given bound,
+     * lower dimensions first.
+     * Dimensions whose tables don't fit (or whose hop counts exceed 255) compute hop counts as usual.
+     *
+     * @param max_tables_bytes maximum number of bytes the tables may take in total
+     * @return number of bytes the tables take
+     */
+    virtual size_t precompute_delays(size_t max_tables_bytes) noexcept = 0;
+
+    /**
+     * Compute the delay of every (src, dest) NPU pair for each chunk size,
+     * streaming the matrices into a memory-mapped binary file so that they don't have to fit in memory.
+     * Rows are computed in parallel by a thread pool.
+     *
+     * The file holds a row-major (number of NPUs) x (number of NPUs) matrix of EventTime per chunk size,
+     * in the order of chunk_sizes, i.e., the delay from src to dest of chunk_sizes[i] is at index
+     * (i * npus_count + src) * npus_count + dest. Diagonal entries are 0.
+     *
+     * @param chunk_sizes chunk sizes to compute the matrix of
+     * @param path path of the file to write
+     * @param threads_count number of threads to use, or 0 to use every hardware thread
+     */
+    void compute_delay_matrix(const std::vector<ChunkSize>& chunk_sizes,
+                              const std::string& path,
+                              int threads_count = 0) const noexcept;
+
+    /**
+     * Compute the delay from src to every dest NPU, i.e., a row of the delay matrix.
+     * Topologies override this to exploit their structure.
+     *
+     * @param src src NPU ID
+     * @param chunk_size size of the chunk to send
+     * @param delays (out) time to send the chunk from src to each dest, 0 for src itself
+     */
+    virtual void compute_delay_row(DeviceId src, ChunkSize chunk_size, EventTime* delays) const noexcept;
+
     /**
      * Get the number of NPUs in the topology.
      *
@@ -62,6 +124,10 @@ class Topology {
     [[nodiscard]] std::vector<Bandwidth> get_bandwidth_per_dim() const noexcept;
 
   protected:
+    /// number of chunks send_batch processes at once,
+    /// small enough for the intermediate arrays to stay in the L1 cache
+    static constexpr size_t batch_block_size = 256;
+
     /// number of NPUs in the topology
     int npus_count;
 
@@ -7,8 +7,26 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkParser.h"
 #include "common/Type.h"
 #include "congestion_aware/Chunk.h"
+#include "congestion_aware/FullyConnected.h"
 #include "congestion_aware/Helper.h"
+#include "congestion_aware/LinkDisjointSimulation.h"
+#include "congestion_aware/MultiDimTopology.h"
+#include "congestion_aware/ParallelSimulation.h"
+#include "congestion_aware/TimeWarpSimulation.h"
+#include "congestion_aware/Ring.h"
+#include "congestion_aware/Switch.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
@@ -16,9 +34,8 @@ using namespace NetworkAnalyticalCongestionAware;
 class TestNetworkAnalyticalCongestionAware : public ::testing::Test {
   protected:
     void SetUp() override {
-        // set event queue
+        // create the event queue the topologies of the test simulate with
         event_queue = std::make_shared<EventQueue>();
-        Topology::set_event_queue(event_queue);
 
         // set chunk size
         chunk_size = 1'048'576;  // 1 MB
@@ -29,12 +46,196 @@ class TestNetworkAnalyticalCongestionAware : public ::testing::Test {
     static void callback(void* const arg) {}
 
     ChunkSize chunk_size;
+
+    /// traces the order in which randomly scheduled events are invoked
+    struct EventOrderTracer {
+        struct TracedEvent {
+            EventOrderTracer* tracer;
+            int id;
+        };
+
+        explicit EventOrderTracer(EventQueue* const event_queue) : event_queue(event_queue), rng(2024) {}
+
+        static void invoke(void* const arg) {
+            const auto* const traced_event = static_cast<TracedEvent*>(arg);
+            auto* const tracer = traced_event->tracer;
+            tracer->trace.emplace_back(tracer->event_queue->get_current_time(), traced_event->id);
+
+            // randomly schedule a follow-up event, possibly at the current time
+            if (tracer->rng() % 4 != 0) {
+                tracer->schedule(tracer->event_queue->get_current_time() + tracer->random_delay());
+            }
+        }
+
+        void schedule(const EventTime event_time) {
+            traced_events.push_back({this, static_cast<int>(traced_events.size())});
+            event_queue->schedule_event(event_time, invoke, &traced_events.back());
+        }
+
+        EventTime random_delay() {
+            // mix same-time, short, long, and beyond-wheel-range delays
+            switch (rng() % 4) {
+            case 0:
+                return rng() % 2;
+            case 1:
+                return rng() % 1'000;
+            case 2:
+                return rng() % 100'000'000;
+            default:
+                return rng() % (EventTime{1} << 36);
+            }
+        }
+
+        EventQueue* event_queue;
+        std::mt19937_64 rng;
+        std::deque<TracedEvent> traced_events;
+        std::vector<std::pair<EventTime, int>> trace;
+    };
+
+    static std::vector<std::pair<EventTime, int>> trace_event_order(const SchedulingPolicy scheduling_policy) {
+        auto event_queue = EventQueue(scheduling_policy);
+        auto tracer = EventOrderTracer(&event_queue);
+
+        // schedule initial events
+        for (auto i = 0; i < 5'000; i++) {
+            tracer.schedule(tracer.random_delay());
+        }
+
+        // run simulation
+        while (!event_queue.finished()) {
+            event_queue.proceed();
+        }
+
+        return tracer.trace;
+    }
+
+    /// flows of chunks, each bouncing between its two NPUs for the given rounds
+    /// (src, dest, chunk size, rounds)
+    using Traffic = std::vector<std::tuple<DeviceId, DeviceId, ChunkSize, int>>;
+
+    /// replays a traffic through the given send function, recording the arrival times of each flow
+    struct TrafficReplay {
+        struct Flow {
+            TrafficReplay* replay;
+            ChunkSize chunk_size;
+            DeviceId src;
+            DeviceId dest;
+            int rounds_left;
+            std::vector<EventTime> arrival_times;
+        };
+
+        TrafficReplay(const Traffic& traffic,
+                      std::function<void(std::unique_ptr<Chunk>)> send,
+                      std::function<EventTime()> get_current_time)
+            : send(std::move(send)),
+              get_current_time(std::move(get_current_time)) {
+            for (const auto& [src, dest, size, rounds] : traffic) {
+                flows.push_back({this, size, src, dest, rounds, {}});
+            }
+        }
+
+        static void chunk_arrived(void* const arg) {
+            // the chunk arrived at dest, which sends it back for the next round
+            auto* const flow = static_cast<Flow*>(arg);
+            flow->arrival_times.push_back(flow->replay->get_current_time());
+            flow->rounds_left--;
+            if (flow->rounds_left > 0) {
+                std::swap(flow->src, flow->dest);
+                flow->replay->send_chunk(*flow);
+            }
+        }
+
+        void start() {
+            for (auto& flow : flows) {
+                send_chunk(flow);
+            }
+        }
+
+        void send_chunk(Flow& flow) {
+            send(std::make_unique<Chunk>(flow.chunk_size, flow.src, flow.dest, chunk_arrived, &flow));
+        }
+
+        [[nodiscard]] std::vector<std::vector<EventTime>> get_arrival_times() const {
+            auto arrival_times = std::vector<std::vector<EventTime>>();
+            for (const auto& flow : flows) {
+                arrival_times.push_back(flow.arrival_times);
+            }
+            return arrival_times;
+        }
+
+        std::function<void(std::unique_ptr<Chunk>)> send;
+        std::function<EventTime()> get_current_time;
+        std::deque<Flow> flows;
+    };
+
+    static std::vector<std::vector<EventTime>> replay_sequentially(Topology& topology, const Traffic& traffic) {
+        const auto topology_event_queue = topology.get_event_queue();
+        auto replay = TrafficReplay(
+            traffic, [&](std::unique_ptr<Chunk> chunk) { topology.send(std::move(chunk)); },
+            [&] { return topology_event_queue->get_current_time(); });
+        replay.start();
+        while (!topology_event_queue->finished()) {
+            Topology::proceed(*topology_event_queue);
+        }
+        return replay.get_arrival_times();
+    }
+
+    static std::vector<std::vector<EventTime>> replay_sequentially(const char* const input_path,
+                                                                   const Traffic& traffic) {
+        const auto topology = construct_topology(NetworkParser(input_path));
+        return replay_sequentially(*topology, traffic);
+    }
+
+    /// replays a traffic on a simulation engine (e.g., ParallelSimulation), continuing from its current time
+    template <typename Simulation>
+    static std::vector<std::vector<EventTime>> replay_with(Simulation& simulation, const Traffic& traffic) {
+        auto replay = TrafficReplay(
+            traffic, [&](std::unique_ptr<Chunk> chunk) { simulation.send(std::move(chunk)); },
+            [&] { return simulation.get_current_time(); });
+        replay.start();
+        simulation.run();
+        return replay.get_arrival_times();
+    }
+
+    /// replays a traffic on a new simulation engine, returned to read its stats
+    template <typename Simulation>
+    static std::pair<std::unique_ptr<Simulation>, std::vector<std::vector<EventTime>>> replay_with(
+        const char* const input_path, const Traffic& traffic, const int threads_count) {
+        auto simulation = std::make_unique<Simulation>(NetworkParser(input_path), threads_count);
+        auto arrival_times = replay_with(*simulation, traffic);
+        return {std::move(simulation), std::move(arrival_times)};
+    }
+
+    /// all-to-all between the NPUs of each instance of a dimension, bounced back once
+    [[nodiscard]] Traffic all_to_all_per_dim(const std::vector<int>& npus_count_per_dim, const int dim) const {
+        auto stride = 1;
+        for (auto i = 0; i < dim; i++) {
+            stride *= npus_count_per_dim[i];
+        }
+        const auto dim_size = npus_count_per_dim[dim];
+        auto npus_count = 1;
+        for (const auto count : npus_count_per_dim) {
+            npus_count *= count;
+        }
+
+        auto traffic = Traffic();
+        for (auto src = 0; src < npus_count; src++) {
+            const auto coordinate = (src / stride) % dim_size;
+            for (auto peer = 0; peer < dim_size; peer++) {
+                if (peer != coordinate) {
+                    traffic.emplace_back(src, src + (peer - coordinate) * stride, chunk_size, 2);
+                }
+            }
+        }
+        return traffic;
+    }
 };
 
 TEST_F(TestNetworkAnalyticalCongestionAware, Ring) {
     /// setup
     const auto network_parser = NetworkParser("../../input/Ring.yml");
     const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
 
     /// message settings
     auto route = topology->route(1, 4);
@@ -57,6 +258,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, FullyConnected) {
     /// setup
     const auto network_parser = NetworkParser("../../input/FullyConnected.yml");
     const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
 
     /// message settings
     auto route = topology->route(1, 4);
@@ -79,6 +281,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, Switch) {
     /// setup
     const auto network_parser = NetworkParser("../../input/Switch.yml");
     const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
 
     /// message settings
     auto route = topology->route(1, 4);
@@ -101,6 +304,7 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     /// setup
     const auto network_parser = NetworkParser("../../input/Ring.yml");
     const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
     const auto npus_count = topology->get_npus_count();
 
     /// message settings
@@ -132,3 +336,1012 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     const auto simulation_time = event_queue->get_current_time();
     EXPECT_EQ(simulation_time, 704'116);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionAware, SchedulingPoliciesEventOrder) {
+    /// reference order: (event time, scheduled order)
+    const auto reference_trace = trace_event_order(SchedulingPolicy::BinaryHeap);
+    ASSERT_GT(reference_trace.size(), 5'000);
+    for (auto i = size_t{1}; i < reference_trace.size(); i++) {
+        EXPECT_LE(reference_trace[i - 1].first, reference_trace[i].first);
+        if (reference_trace[i - 1].first == reference_trace[i].first) {
+            EXPECT_LT(reference_trace[i - 1].second, reference_trace[i].second);
+        }
+    }
+
+    /// test: every scheduling policy yields the same event order
+    EXPECT_EQ(trace_event_order(SchedulingPolicy::CalendarQueue), reference_trace);
+    EXPECT_EQ(trace_event_order(SchedulingPolicy::TimingWheel), reference_trace);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RunUntilAndRunEvents) {
+    const auto reference_trace = trace_event_order(SchedulingPolicy::BinaryHeap);
+    for (const auto scheduling_policy :
+         {SchedulingPolicy::BinaryHeap, SchedulingPolicy::CalendarQueue, SchedulingPolicy::TimingWheel}) {
+        // run window by window
+        auto windowed_event_queue = EventQueue(scheduling_policy);
+        auto windowed_tracer = EventOrderTracer(&windowed_event_queue);
+        for (auto i = 0; i < 5'000; i++) {
+            windowed_tracer.schedule(windowed_tracer.random_delay());
+        }
+        constexpr auto window = EventTime{1} << 28;
+        auto window_end = EventTime{0};
+        while (!windowed_event_queue.finished()) {
+            window_end += window;
+            windowed_event_queue.run_until(window_end);
+
+            /// test: the current time moves to the end of the window, with no earlier event left
+            EXPECT_EQ(windowed_event_queue.get_current_time(), window_end);
+            EXPECT_TRUE(windowed_event_queue.finished() || windowed_event_queue.peek_next_time() > window_end);
+        }
+
+        /// test: windows don't change the event order
+        EXPECT_EQ(windowed_tracer.trace, reference_trace);
+
+        // run a few events at a time, splitting the events of the same time
+        auto budgeted_event_queue = EventQueue(scheduling_policy);
+        auto budgeted_tracer = EventOrderTracer(&budgeted_event_queue);
+        for (auto i = 0; i < 5'000; i++) {
+            budgeted_tracer.schedule(budgeted_tracer.random_delay());
+        }
+        while (!budgeted_event_queue.finished()) {
+            const auto invoked_events_count = budgeted_event_queue.run_events(7);
+
+            /// test: every call invokes the given number of events, unless no event is left
+            EXPECT_TRUE(invoked_events_count == 7 || budgeted_event_queue.finished());
+        }
+
+        /// test: the budget doesn't change the event order
+        EXPECT_EQ(budgeted_tracer.trace, reference_trace);
+        EXPECT_EQ(budgeted_event_queue.get_processed_events_count(), reference_trace.size());
+    }
+
+    // network events, dispatched directly window by window
+    const auto* const input_path = "../../input/Ring.yml";
+    auto all_to_all = Traffic();
+    for (auto src = 0; src < 16; src++) {
+        for (auto dest = 0; dest < 16; dest++) {
+            if (src != dest) {
+                all_to_all.emplace_back(src, dest, chunk_size, 2);
+            }
+        }
+    }
+    const auto topology = construct_topology(NetworkParser(input_path));
+    const auto topology_event_queue = topology->get_event_queue();
+    auto replay = TrafficReplay(
+        all_to_all, [&](std::unique_ptr<Chunk> chunk) { topology->send(std::move(chunk)); },
+        [&] { return topology_event_queue->get_current_time(); });
+    replay.start();
+    auto window_end = EventTime{0};
+    while (!topology_event_queue->finished()) {
+        window_end += 10'000;
+        Topology::run_until(*topology_event_queue, window_end);
+    }
+
+    /// test: every chunk arrives at the same time as proceeding event by event
+    EXPECT_EQ(replay.get_arrival_times(), replay_sequentially(input_path, all_to_all));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, EventCancellation) {
+    struct TracedEvent {
+        std::vector<int>* trace;
+        int id;
+    };
+    const auto record = [](void* const arg) {
+        const auto* const event = static_cast<TracedEvent*>(arg);
+        event->trace->push_back(event->id);
+    };
+
+    for (const auto scheduling_policy :
+         {SchedulingPolicy::BinaryHeap, SchedulingPolicy::CalendarQueue, SchedulingPolicy::TimingWheel}) {
+        // schedule random events, then cancel or reschedule some of them
+        auto trace = std::vector<int>();
+        auto events = std::deque<TracedEvent>();
+        auto event_queue = EventQueue(scheduling_policy);
+        auto reference_trace = std::vector<int>();
+        auto reference_events = std::deque<TracedEvent>();
+        auto reference_event_queue = EventQueue(scheduling_policy);
+
+        auto rng = std::mt19937_64(25);
+        auto times = std::vector<EventTime>();
+        auto handles = std::vector<EventHandle>();
+        for (auto id = 0; id < 5'000; id++) {
+            times.push_back(rng() % 2 == 0 ? rng() % 100 : rng() % (EventTime{1} << 36));
+            events.push_back({&trace, id});
+            handles.push_back(event_queue.schedule_event(times.back(), record, &events.back()));
+        }
+        auto actions = std::vector<int>();
+        auto new_times = std::vector<EventTime>();
+        for (auto id = 0; id < 5'000; id++) {
+            // 0: kept, 1: cancelled, 2: rescheduled
+            actions.push_back(static_cast<int>(rng() % 3));
+            new_times.push_back(rng() % (EventTime{1} << 36));
+            if (actions.back() == 1) {
+                EXPECT_TRUE(event_queue.cancel(handles[id]));
+            } else if (actions.back() == 2) {
+                EXPECT_TRUE(event_queue.reschedule(handles[id], new_times.back()));
+            }
+        }
+
+        /// test: a cancelled event can't be cancelled again
+        for (auto id = 0; id < 5'000; id++) {
+            EXPECT_EQ(event_queue.is_pending(handles[id]), actions[id] != 1);
+            if (actions[id] == 1) {
+                EXPECT_FALSE(event_queue.cancel(handles[id]));
+            }
+        }
+
+        /// test: tombstones are reported
+        const auto cancelled_count = static_cast<uint64_t>(std::count(actions.begin(), actions.end(), 1));
+        const auto rescheduled_count = static_cast<uint64_t>(std::count(actions.begin(), actions.end(), 2));
+        const auto stats = event_queue.get_stats();
+        EXPECT_EQ(stats.pending_events_count, 5'000 - cancelled_count);
+        EXPECT_EQ(stats.cancelled_events_count, cancelled_count + rescheduled_count);
+        EXPECT_GT(stats.tombstones_count, 0);
+        EXPECT_LE(stats.tombstones_count, stats.cancelled_events_count);
+        EXPECT_GT(stats.tombstone_ratio, 0.0);
+
+        // the reference schedules the kept events, then the rescheduled ones in their rescheduled order
+        for (auto id = 0; id < 5'000; id++) {
+            reference_events.push_back({&reference_trace, id});
+            if (actions[id] == 0) {
+                reference_event_queue.schedule_event(times[id], record, &reference_events.back());
+            }
+        }
+        for (auto id = 0; id < 5'000; id++) {
+            if (actions[id] == 2) {
+                reference_event_queue.schedule_event(new_times[id], record, &reference_events[id]);
+            }
+        }
+
+        auto last_time = EventTime{0};
+        auto reference_last_time = EventTime{0};
+        while (!event_queue.finished()) {
+            event_queue.proceed();
+            last_time = event_queue.get_current_time();
+        }
+        while (!reference_event_queue.finished()) {
+            reference_event_queue.proceed();
+            reference_last_time = reference_event_queue.get_current_time();
+        }
+
+        /// test: cancelled events are never invoked, and rescheduled ones are invoked at their new time
+        EXPECT_EQ(trace, reference_trace);
+        EXPECT_EQ(last_time, reference_last_time);
+
+        /// test: invoked events can't be cancelled or rescheduled
+        for (auto id = 0; id < 5'000; id++) {
+            EXPECT_FALSE(event_queue.is_pending(handles[id]));
+            EXPECT_FALSE(event_queue.cancel(handles[id]));
+            EXPECT_FALSE(event_queue.reschedule(handles[id], event_queue.get_current_time()));
+        }
+        EXPECT_TRUE(event_queue.finished());
+
+        /// test: every tombstone is dropped
+        EXPECT_EQ(event_queue.get_stats().tombstones_count, 0);
+        EXPECT_EQ(event_queue.get_stats().tombstone_ratio, 0.0);
+    }
+
+    // cancelling the only pending event finishes the queue without moving the time
+    auto event_queue = EventQueue();
+    const auto handle = event_queue.schedule_event(1'000, callback, nullptr);
+    EXPECT_TRUE(event_queue.cancel(handle));
+    EXPECT_TRUE(event_queue.finished());
+    EXPECT_EQ(event_queue.get_current_time(), 0);
+
+    /// test: a stale handle doesn't cancel the event reusing its slot
+    event_queue.run_until(1'500);
+    const auto next_handle = event_queue.schedule_event(2'000, callback, nullptr);
+    EXPECT_EQ(next_handle.slot, handle.slot);
+    EXPECT_FALSE(event_queue.cancel(handle));
+    EXPECT_TRUE(event_queue.is_pending(next_handle));
+    event_queue.run_until(2'000);
+    EXPECT_FALSE(event_queue.is_pending(next_handle));
+    EXPECT_EQ(event_queue.get_processed_events_count(), 1);
+
+    /// test: rescheduling a fired or cancelled event schedules nothing, leaving the handle as is
+    auto fired_handle = next_handle;
+    EXPECT_FALSE(event_queue.reschedule(fired_handle, 3'000));
+    EXPECT_EQ(fired_handle.slot, next_handle.slot);
+    EXPECT_EQ(fired_handle.generation, next_handle.generation);
+    auto cancelled_handle = handle;
+    EXPECT_FALSE(event_queue.reschedule(cancelled_handle, 3'000));
+    EXPECT_TRUE(event_queue.finished());
+    EXPECT_EQ(event_queue.get_stats().tombstones_count, 0);
+    EXPECT_EQ(event_queue.get_processed_events_count(), 1);
+
+    // an event preempting the events of the same time, already gathered into its batch
+    struct Preemption {
+        EventQueue* event_queue;
+        EventHandle self;
+        EventHandle preempted;
+        EventHandle delayed;
+        std::vector<int> trace;
+    };
+    const auto preempt = [](void* const arg) {
+        auto* const preemption = static_cast<Preemption*>(arg);
+        preemption->trace.push_back(0);
+        EXPECT_FALSE(preemption->event_queue->is_pending(preemption->self));
+        EXPECT_TRUE(preemption->event_queue->is_pending(preemption->preempted));
+        EXPECT_TRUE(preemption->event_queue->cancel(preemption->preempted));
+        EXPECT_TRUE(preemption->event_queue->reschedule(preemption->delayed, 4'000));
+    };
+    const auto record_preempted = [](void* const arg) { static_cast<Preemption*>(arg)->trace.push_back(1); };
+    const auto record_delayed = [](void* const arg) { static_cast<Preemption*>(arg)->trace.push_back(2); };
+
+    for (const auto scheduling_policy :
+         {SchedulingPolicy::BinaryHeap, SchedulingPolicy::CalendarQueue, SchedulingPolicy::TimingWheel}) {
+        auto queue = EventQueue(scheduling_policy);
+        auto preemption = Preemption{&queue, {}, {}, {}, {}};
+        preemption.self = queue.schedule_event(3'000, preempt, &preemption);
+        preemption.preempted = queue.schedule_event(3'000, record_preempted, &preemption);
+        preemption.delayed = queue.schedule_event(3'000, record_delayed, &preemption);
+        while (!queue.finished()) {
+            queue.proceed();
+        }
+
+        /// test: the preempted event is never invoked, and the delayed one is invoked at its new time
+        EXPECT_EQ(preemption.trace, (std::vector<int>{0, 2}));
+        EXPECT_EQ(queue.get_current_time(), 4'000);
+        EXPECT_EQ(queue.get_processed_events_count(), 2);
+        EXPECT_EQ(queue.get_stats().cancelled_events_count, 2);
+        EXPECT_EQ(queue.get_stats().tombstones_count, 0);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, SetCurrentTimeRewindsScheduler) {
+    for (const auto scheduling_policy :
+         {SchedulingPolicy::BinaryHeap, SchedulingPolicy::CalendarQueue, SchedulingPolicy::TimingWheel}) {
+        auto queue = EventQueue(scheduling_policy);
+
+        // run far ahead, then move the time back
+        for (const auto event_time : {EventTime{1'000'000}, EventTime{5'000'000'000}}) {
+            queue.schedule_event(event_time, callback, nullptr);
+            while (!queue.finished()) {
+                queue.proceed();
+            }
+        }
+        queue.set_current_time(100);
+
+        // events scheduled after the rewind are invoked in order
+        for (const auto event_time : {EventTime{300}, EventTime{200}, EventTime{100}}) {
+            queue.schedule_event(event_time, callback, nullptr);
+        }
+        auto event_times = std::vector<EventTime>();
+        while (!queue.finished()) {
+            queue.proceed();
+            event_times.push_back(queue.get_current_time());
+        }
+
+        /// test: the scheduler follows the rewound time
+        EXPECT_EQ(event_times, (std::vector<EventTime>{100, 200, 300}));
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRingSchedulingPolicies) {
+    for (const auto scheduling_policy :
+         {SchedulingPolicy::BinaryHeap, SchedulingPolicy::CalendarQueue, SchedulingPolicy::TimingWheel}) {
+        /// setup
+        event_queue = std::make_shared<EventQueue>(scheduling_policy);
+        const auto network_parser = NetworkParser("../../input/Ring.yml");
+        const auto topology = construct_topology(network_parser);
+        topology->set_event_queue(event_queue);
+        const auto npus_count = topology->get_npus_count();
+
+        /// Run All-Gather
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                auto route = topology->route(i, j);
+                auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+                topology->send(std::move(chunk));
+            }
+        }
+
+        /// Run simulation
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        /// test
+        EXPECT_EQ(event_queue->get_current_time(), 704'116);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRingTypedDispatch) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    const auto npus_count = topology->get_npus_count();
+
+    /// Run All-Gather
+    for (int i = 0; i < npus_count; i++) {
+        for (int j = 0; j < npus_count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto route = topology->route(i, j);
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+            topology->send(std::move(chunk));
+        }
+    }
+
+    /// Run simulation, dispatching network events directly
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+
+    /// test
+    EXPECT_EQ(event_queue->get_current_time(), 704'116);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RingAllGatherEventsCount) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    const auto npus_count = topology->get_npus_count();
+
+    /// ring algorithm: every NPU forwards the arrived chunk to its next neighbor
+    struct RingForwarder {
+        Topology* topology;
+        ChunkSize chunk_size;
+        int npus_count;
+        DeviceId current;
+        int hops_left;
+
+        static void chunk_arrived(void* const arg) {
+            auto* const forwarder = static_cast<RingForwarder*>(arg);
+            forwarder->current = (forwarder->current + 1) % forwarder->npus_count;
+            forwarder->hops_left--;
+            if (forwarder->hops_left > 0) {
+                forwarder->send();
+            }
+        }
+
+        void send() {
+            const auto next = (current + 1) % npus_count;
+            auto route = topology->route(current, next);
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, chunk_arrived, this);
+            topology->send(std::move(chunk));
+        }
+    };
+
+    /// Run All-Gather
+    auto forwarders = std::vector<RingForwarder>();
+    for (int i = 0; i < npus_count; i++) {
+        forwarders.push_back({topology.get(), chunk_size, npus_count, i, npus_count - 1});
+    }
+    for (auto& forwarder : forwarders) {
+        forwarder.send();
+    }
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: links are never contended,
+    /// so every hop only takes the chunk arrival event
+    EXPECT_EQ(event_queue->get_current_time(), 15 * 20'031);
+    EXPECT_EQ(event_queue->get_processed_events_count(), npus_count * (npus_count - 1));
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RingRouteFusion) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    topology->set_route_fusion(true);
+
+    /// message settings
+    auto route = topology->route(1, 4);
+    auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+
+    // send a chunk
+    topology->send(std::move(chunk));
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: three hops take a single event
+    EXPECT_EQ(event_queue->get_current_time(), 60'093);
+    EXPECT_EQ(event_queue->get_processed_events_count(), 1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RouteFusionMatchesHopByHop) {
+    /// traffic recording the arrival time of every chunk
+    struct FusionTraffic {
+        struct Message {
+            FusionTraffic* traffic;
+            DeviceId src;
+            DeviceId dest;
+            ChunkSize size;
+            EventTime arrival_time;
+        };
+
+        EventQueue* event_queue;
+        std::shared_ptr<Topology> topology;
+        std::deque<Message> messages;
+
+        static void inject(void* const arg) {
+            auto* const message = static_cast<Message*>(arg);
+            auto route = message->traffic->topology->route(message->src, message->dest);
+            auto chunk = std::make_unique<Chunk>(message->size, route, arrived, message);
+            message->traffic->topology->send(std::move(chunk));
+        }
+
+        static void arrived(void* const arg) {
+            auto* const message = static_cast<Message*>(arg);
+            message->arrival_time = message->traffic->event_queue->get_current_time();
+        }
+    };
+
+    /// injection of a message: src, dest, size, and inject time
+    using Injection = std::tuple<DeviceId, DeviceId, ChunkSize, EventTime>;
+
+    const auto run = [this](const std::shared_ptr<Topology>& topology,
+                            const std::vector<Injection>& injections,
+                            const bool route_fusion) {
+        event_queue = std::make_shared<EventQueue>();
+        auto traffic = FusionTraffic{event_queue.get(), topology, {}};
+        traffic.topology->set_event_queue(event_queue);
+        traffic.topology->set_route_fusion(route_fusion);
+        for (const auto& [src, dest, size, inject_time] : injections) {
+            traffic.messages.push_back({&traffic, src, dest, size, 0});
+            event_queue->schedule_event(inject_time, FusionTraffic::inject, &traffic.messages.back());
+        }
+
+        while (!event_queue->finished()) {
+            Topology::proceed(*event_queue);
+        }
+
+        auto arrival_times = std::vector<EventTime>();
+        for (const auto& message : traffic.messages) {
+            arrival_times.push_back(message.arrival_time);
+        }
+        return std::make_pair(arrival_times, event_queue->get_processed_events_count());
+    };
+
+    for (const auto* const input_path : {"../../input/Ring.yml", "../../input/Switch.yml"}) {
+        const auto network_parser = NetworkParser(input_path);
+        const auto npus_count = construct_topology(network_parser)->get_npus_count();
+
+        // sparse traffic with a few bursts
+        auto injections = std::vector<Injection>();
+        auto rng = std::mt19937(7);
+        for (auto i = 0; i < 2'000; i++) {
+            const auto src = static_cast<DeviceId>(rng() % npus_count);
+            const auto dest = static_cast<DeviceId>((src + 1 + rng() % (npus_count - 1)) % npus_count);
+            const auto size = ChunkSize{1'024} + rng() % 1'048'576;
+            const auto inject_time = (i % 100 < 10) ? EventTime{1'000'000} * (i / 100) : EventTime{rng() % 20'000'000};
+            injections.emplace_back(src, dest, size, inject_time);
+        }
+
+        const auto [hop_by_hop_times, hop_by_hop_events] = run(construct_topology(network_parser), injections, false);
+        const auto [fused_times, fused_events] = run(construct_topology(network_parser), injections, true);
+
+        /// test: every chunk arrives at the same time, with fewer events
+        EXPECT_EQ(fused_times, hop_by_hop_times);
+        EXPECT_LT(fused_events, hop_by_hop_events);
+    }
+
+    // a chunk queued on a reserved link right before the reservation starts:
+    // on unidirectional Ring(4) of 1 B/ns and 100 ns latency,
+    // 0 -> 2 reserves link 1 -> 2 for [200, 300), which 1 -> 2 sent at 150 keeps busy until 200,
+    // and 1 -> 2 sent at 160 is queued, to be served at 200 before the chunk of 0 -> 2
+    const auto bandwidth = Bandwidth{1'000'000'000} / (1 << 30);  // 1 B/ns
+    const auto tie_injections = std::vector<Injection>{{0, 2, 100, 0}, {1, 2, 50, 150}, {1, 2, 10, 160}};
+    const auto [hop_by_hop_times, hop_by_hop_events] =
+        run(std::make_shared<Ring>(4, bandwidth, 100, false), tie_injections, false);
+    const auto [fused_times, fused_events] =
+        run(std::make_shared<Ring>(4, bandwidth, 100, false), tie_injections, true);
+
+    /// test: the fused chunk falls back to hop-by-hop, waiting for the queued chunk,
+    /// and its final arrival is cancelled rather than invoked
+    EXPECT_EQ(hop_by_hop_times, (std::vector<EventTime>{410, 300, 310}));
+    EXPECT_EQ(fused_times, hop_by_hop_times);
+    EXPECT_EQ(fused_events, hop_by_hop_events);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkTable) {
+    /// setup: topologies with dense (Ring, FullyConnected) and sparse (Switch) adjacency
+    const auto topologies = std::vector<std::pair<std::shared_ptr<Topology>, size_t>>{
+        {std::make_shared<Ring>(8, 50, 500, true), 16},
+        {std::make_shared<Ring>(8, 50, 500, false), 8},
+        {std::make_shared<FullyConnected>(8, 50, 500), 56},
+        {std::make_shared<Switch>(8, 50, 500), 16},
+    };
+
+    for (const auto& [topology, links_count] : topologies) {
+        /// collect the link of every hop of every route
+        auto links = std::set<const Link*>();
+        auto hop_links = std::set<std::pair<DeviceId, DeviceId>>();
+        for (auto src = 0; src < 8; src++) {
+            for (auto dest = 0; dest < 8; dest++) {
+                if (src == dest) {
+                    continue;
+                }
+                const auto route = topology->route(src, dest);
+                for (auto i = size_t{1}; i < route.size(); i++) {
+                    const auto* const link = topology->get_device(route[i - 1])->get_link(route[i]);
+                    ASSERT_NE(link, nullptr);
+                    links.insert(link);
+                    hop_links.emplace(route[i - 1], route[i]);
+                }
+            }
+        }
+
+        /// test: every connection has its own link, and every link is used
+        EXPECT_EQ(links.size(), hop_links.size());
+        EXPECT_EQ(links.size(), links_count);
+
+        // every link has its own state in the link store
+        auto link_ids = std::set<LinkId>();
+        for (const auto* const link : links) {
+            EXPECT_LT(link->get_id(), topology->get_context()->get_link_store().size());
+            link_ids.insert(link->get_id());
+        }
+        EXPECT_EQ(link_ids.size(), links_count);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LazyFullyConnectedLinks) {
+    /// setup: a large FullyConnected, where every NPU only sends to its neighbor
+    const auto npus_count = 4'096;
+    auto topology = FullyConnected(npus_count, 50, 500);
+    topology.set_event_queue(event_queue);
+    for (auto src = 0; src < npus_count; src++) {
+        topology.send(topology.make_chunk(chunk_size, src, (src + 1) % npus_count, callback, nullptr));
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+
+    /// test: only the used links are instantiated, and they don't interfere with each other
+    for (auto src = 0; src < npus_count; src++) {
+        EXPECT_NE(topology.get_device(src)->find_link((src + 1) % npus_count), nullptr);
+        EXPECT_EQ(topology.get_device(src)->find_link((src + 2) % npus_count), nullptr);
+    }
+    const auto* const link = topology.get_device(0)->find_link(1);
+    EXPECT_EQ(event_queue->get_current_time(), link->communication_delay(chunk_size));
+    EXPECT_EQ(topology.get_link_stats(0, 2).queued_chunks_count, 0);
+
+    // connections include the links not instantiated yet
+    EXPECT_EQ(FullyConnected(8, 50, 500).get_connections().size(), 56);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRingPooledChunks) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    const auto npus_count = topology->get_npus_count();
+
+    /// Run All-Gather twice, with pooled routeless chunks and then pooled routed ones
+    auto simulation_times = std::vector<EventTime>();
+    for (int round = 0; round < 2; round++) {
+        const auto start_time = event_queue->get_current_time();
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+                if (round == 0) {
+                    topology->send(topology->make_chunk(chunk_size, i, j, callback, nullptr));
+                } else {
+                    topology->send(topology->make_chunk(chunk_size, topology->route(i, j), callback, nullptr));
+                }
+            }
+        }
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+        simulation_times.push_back(event_queue->get_current_time() - start_time);
+    }
+
+    /// test: pooled chunks behave the same as heap-allocated ones
+    EXPECT_EQ(simulation_times[0], 704'116);
+    EXPECT_EQ(simulation_times[1], 704'116);
+
+    /// test: every chunk is released, and the second round recycles the first round's storage
+    const auto stats = topology->get_chunk_pool_stats();
+    EXPECT_EQ(stats.chunks_allocated, 2 * npus_count * (npus_count - 1));
+    EXPECT_EQ(stats.chunks_alive, 0);
+    EXPECT_EQ(stats.peak_chunks_alive, npus_count * (npus_count - 1));
+    EXPECT_EQ(stats.heap_allocations, 1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, IndependentSimulationsOnThreads) {
+    /// All-Gather on a topology with its own simulation context
+    const auto all_gather = [this](const char* const input_path, EventTime& simulation_time) {
+        const auto network_parser = NetworkParser(input_path);
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i != j) {
+                    topology->send(topology->make_chunk(chunk_size, i, j, callback, nullptr));
+                }
+            }
+        }
+
+        const auto topology_event_queue = topology->get_event_queue();
+        while (!topology_event_queue->finished()) {
+            Topology::proceed(*topology_event_queue);
+        }
+        simulation_time = topology_event_queue->get_current_time();
+    };
+
+    /// run simulations one by one
+    const auto input_paths = std::vector<const char*>{"../../input/Ring.yml", "../../input/Ring.yml",
+                                                      "../../input/FullyConnected.yml", "../../input/Switch.yml"};
+    auto sequential_times = std::vector<EventTime>(input_paths.size(), 0);
+    for (auto i = size_t{0}; i < input_paths.size(); i++) {
+        all_gather(input_paths[i], sequential_times[i]);
+    }
+
+    /// run simulations concurrently, on different topologies
+    auto concurrent_times = std::vector<EventTime>(input_paths.size(), 0);
+    auto threads = std::vector<std::thread>();
+    for (auto i = size_t{0}; i < input_paths.size(); i++) {
+        threads.emplace_back(all_gather, input_paths[i], std::ref(concurrent_times[i]));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// test: simulations don't interfere with each other
+    EXPECT_EQ(sequential_times[0], 704'116);
+    EXPECT_EQ(concurrent_times, sequential_times);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, Ring_FullyConnected_Switch) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+
+    /// test: 2 x 8 x 4 NPUs, and a switch per each of the 16 Switch(4) instances
+    EXPECT_EQ(topology->get_npus_count(), 64);
+    EXPECT_EQ(topology->get_devices_count(), 80);
+
+    /// test: dimension-order route, [0, 0, 0] -> [1, 0, 0] -> [1, 7, 0] -> switch -> [1, 7, 3]
+    const auto route = topology->route(0, 63);
+    EXPECT_EQ(std::vector<DeviceId>(route.begin(), route.end()), std::vector<DeviceId>({0, 1, 15, 79, 63}));
+
+    /// send a chunk across every dimension
+    topology->send(topology->make_chunk(chunk_size, 0, 63, callback, nullptr));
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+
+    /// test: 4'932 (Ring) + 10'265 (FullyConnected) + 2 * 21'531 (Switch)
+    EXPECT_EQ(event_queue->get_current_time(), 58'259);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, MultiDimContention) {
+    /// all-to-all within every Switch(4) instance of the last dimension
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    for (auto instance = 0; instance < 16; instance++) {
+        for (auto i = 0; i < 4; i++) {
+            for (auto j = 0; j < 4; j++) {
+                if (i != j) {
+                    topology->send(topology->make_chunk(chunk_size, instance + 16 * i, instance + 16 * j, callback,
+                                                        nullptr));
+                }
+            }
+        }
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+    const auto multi_dim_time = event_queue->get_current_time();
+
+    /// all-to-all on a standalone Switch(4)
+    const auto switch_topology = std::make_shared<Switch>(4, 50, 2'000);
+    const auto switch_event_queue = switch_topology->get_event_queue();
+    for (auto i = 0; i < 4; i++) {
+        for (auto j = 0; j < 4; j++) {
+            if (i != j) {
+                switch_topology->send(switch_topology->make_chunk(chunk_size, i, j, callback, nullptr));
+            }
+        }
+    }
+    while (!switch_event_queue->finished()) {
+        Topology::proceed(*switch_event_queue);
+    }
+
+    /// test: instances contend for their own links only
+    EXPECT_EQ(multi_dim_time, switch_event_queue->get_current_time());
+    EXPECT_GT(multi_dim_time, 2 * 21'531);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, NextHopMatchesRoute) {
+    /// setup
+    auto topologies = std::vector<std::shared_ptr<Topology>>{
+        std::make_shared<Ring>(8, 50, 500, true),
+        std::make_shared<Ring>(7, 50, 500, true),
+        std::make_shared<Ring>(8, 50, 500, false),
+        std::make_shared<FullyConnected>(8, 50, 500),
+        std::make_shared<Switch>(8, 50, 500),
+        construct_topology(NetworkParser("../../input/Ring_FullyConnected_Switch.yml")),
+    };
+
+    for (const auto& topology : topologies) {
+        const auto npus_count = topology->get_npus_count();
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src == dest) {
+                    continue;
+                }
+
+                /// follow next_hop from src to dest
+                auto devices = std::vector<DeviceId>{src};
+                while (devices.back() != dest) {
+                    ASSERT_LT(devices.size(), topology->get_devices_count());
+                    devices.push_back(topology->next_hop(devices.back(), dest));
+                }
+
+                /// test: routeless chunks traverse the same devices as routed ones
+                const auto route = topology->route(src, dest);
+                EXPECT_EQ(devices, std::vector<DeviceId>(route.begin(), route.end()));
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, RoutelessMatchesRouted) {
+    /// random all-to-all traffic, with routed or routeless chunks
+    const auto run = [this](const char* const input_path, const bool routeless, const bool route_fusion) {
+        event_queue = std::make_shared<EventQueue>();
+        const auto topology = construct_topology(NetworkParser(input_path));
+        topology->set_event_queue(event_queue);
+        topology->set_route_fusion(route_fusion);
+        const auto npus_count = topology->get_npus_count();
+
+        auto rng = std::mt19937(11);
+        for (auto i = 0; i < 1'000; i++) {
+            const auto src = static_cast<DeviceId>(rng() % npus_count);
+            const auto dest = static_cast<DeviceId>((src + 1 + rng() % (npus_count - 1)) % npus_count);
+            const auto size = ChunkSize{1'024} + rng() % 1'048'576;
+            if (routeless) {
+                topology->send(topology->make_chunk(size, src, dest, callback, nullptr));
+            } else {
+                topology->send(std::make_unique<Chunk>(size, topology->route(src, dest), callback, nullptr));
+            }
+        }
+        while (!event_queue->finished()) {
+            Topology::proceed(*event_queue);
+        }
+        return std::make_pair(event_queue->get_current_time(), event_queue->get_processed_events_count());
+    };
+
+    for (const auto* const input_path :
+         {"../../input/Ring.yml", "../../input/Switch.yml", "../../input/Ring_FullyConnected_Switch.yml"}) {
+        for (const auto route_fusion : {false, true}) {
+            /// test: routeless chunks are simulated exactly as routed ones
+            EXPECT_EQ(run(input_path, true, route_fusion), run(input_path, false, route_fusion));
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkStatsOnIncast) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    topology->set_event_queue(event_queue);
+    const auto npus_count = topology->get_npus_count();
+    const auto switch_id = npus_count;
+
+    /// every other NPU sends a chunk to NPU 0 at once
+    for (auto src = 1; src < npus_count; src++) {
+        topology->send(topology->make_chunk(chunk_size, src, 0, callback, nullptr));
+    }
+    while (!event_queue->finished()) {
+        Topology::proceed(*event_queue);
+    }
+
+    /// test: the chunks reach the switch together, and all but the first wait for the downlink one after another
+    const auto waiting_chunks_count = npus_count - 2;
+    const auto serialization_time = topology->get_device(switch_id)->get_link(0)->serialization_delay(chunk_size);
+    const auto downlink_stats = topology->get_link_stats(switch_id, 0);
+    EXPECT_EQ(downlink_stats.peak_pending_chunks, waiting_chunks_count);
+    EXPECT_EQ(downlink_stats.queued_chunks_count, waiting_chunks_count);
+    EXPECT_EQ(downlink_stats.total_queued_time,
+              serialization_time * waiting_chunks_count * (waiting_chunks_count + 1) / 2);
+    EXPECT_DOUBLE_EQ(downlink_stats.average_pending_chunks,
+                     static_cast<double>(downlink_stats.total_queued_time) /
+                         static_cast<double>(event_queue->get_current_time()));
+
+    // no other link has queued any chunk
+    for (const auto& [src, dest] : topology->get_connections()) {
+        if (src != switch_id || dest != 0) {
+            const auto stats = topology->get_link_stats(src, dest);
+            EXPECT_EQ(stats.peak_pending_chunks, 0);
+            EXPECT_EQ(stats.total_queued_time, 0);
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ParallelSimulationMatchesSequential) {
+    for (const auto* const input_path : {"../../input/Ring.yml", "../../input/FullyConnected.yml",
+                                         "../../input/Switch.yml", "../../input/Ring_FullyConnected_Switch.yml"}) {
+        const auto npus_count = construct_topology(NetworkParser(input_path))->get_npus_count();
+
+        // all-to-all of the same chunks, bounced back once, so that many events of different partitions tie
+        auto all_to_all = Traffic();
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    all_to_all.emplace_back(src, dest, chunk_size, 2);
+                }
+            }
+        }
+
+        // random flows of random chunks
+        auto random_traffic = Traffic();
+        auto rng = std::mt19937(5);
+        for (auto i = 0; i < 500; i++) {
+            const auto src = static_cast<DeviceId>(rng() % npus_count);
+            const auto dest = static_cast<DeviceId>((src + 1 + rng() % (npus_count - 1)) % npus_count);
+            random_traffic.emplace_back(src, dest, ChunkSize{1'024} + rng() % 1'048'576, 1 + rng() % 3);
+        }
+
+        for (const auto& traffic : {all_to_all, random_traffic}) {
+            const auto reference = replay_sequentially(input_path, traffic);
+            for (const auto threads_count : {1, 2, 3, 4}) {
+                /// test: every chunk arrives at the same time as the sequential simulation
+                EXPECT_EQ(replay_with<ParallelSimulation>(input_path, traffic, threads_count).second, reference)
+                    << input_path << " with " << threads_count << " threads";
+            }
+        }
+    }
+
+    /// test: the lookahead is the latency of the links crossing partitions
+    auto simulation = ParallelSimulation(NetworkParser("../../input/Ring.yml"), 4);
+    EXPECT_EQ(simulation.get_partitions_count(), 4);
+    EXPECT_EQ(simulation.get_partition(0), 0);
+    EXPECT_EQ(simulation.get_partition(15), 3);
+    EXPECT_EQ(simulation.get_lookahead(), 500);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, TimeWarpSimulationIsDeterministic) {
+    auto rolled_back_events_count = uint64_t{0};
+    for (const auto* const input_path :
+         {"../../input/Ring.yml", "../../input/FullyConnected.yml", "../../input/Ring_FullyConnected_Switch.yml",
+          "../../input/Switch_ZeroLatency.yml"}) {
+        const auto npus_count = construct_topology(NetworkParser(input_path))->get_npus_count();
+
+        // all-to-all of the same chunks, bounced back once, so that many events tie
+        auto all_to_all = Traffic();
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    all_to_all.emplace_back(src, dest, chunk_size, 2);
+                }
+            }
+        }
+
+        // random flows of random chunks, rarely tying
+        auto random_traffic = Traffic();
+        auto rng = std::mt19937(7);
+        for (auto i = 0; i < 500; i++) {
+            const auto src = static_cast<DeviceId>(rng() % npus_count);
+            const auto dest = static_cast<DeviceId>((src + 1 + rng() % (npus_count - 1)) % npus_count);
+            random_traffic.emplace_back(src, dest, ChunkSize{1'024} + rng() % 1'048'576, 1 + rng() % 3);
+        }
+
+        for (const auto& traffic : {all_to_all, random_traffic}) {
+            const auto reference = replay_with<TimeWarpSimulation>(input_path, traffic, 1).second;
+            for (const auto threads_count : {2, 3, 4}) {
+                const auto [simulation, arrival_times] =
+                    replay_with<TimeWarpSimulation>(input_path, traffic, threads_count);
+                /// test: rollbacks don't change the result, whatever the number of threads
+                EXPECT_EQ(arrival_times, reference) << input_path << " with " << threads_count << " threads";
+                const auto stats = simulation->get_stats();
+
+                /// test: every event is committed once
+                EXPECT_EQ(stats.committed_events_count + stats.rolled_back_events_count, stats.processed_events_count);
+                rolled_back_events_count += stats.rolled_back_events_count;
+            }
+        }
+
+        /// test: without ties, the result is the same as the sequential simulation
+        EXPECT_EQ(replay_with<TimeWarpSimulation>(input_path, random_traffic, 4).second,
+                  replay_sequentially(input_path, random_traffic))
+            << input_path;
+    }
+
+    /// test: partitions have run ahead and rolled back
+    EXPECT_GT(rolled_back_events_count, 0);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkDisjointSimulationMatchesSequential) {
+    // a phase per dimension, whose instances share no link
+    const auto* const input_path = "../../input/Ring_FullyConnected_Switch.yml";
+    const auto npus_count_per_dim = construct_topology(NetworkParser(input_path))->get_npus_count_per_dim();
+    // (an instance of Ring(2) or Switch(4) per component, and a pair of NPUs of FullyConnected(8) per component)
+    const auto expected_components_counts = std::vector<int>{32, 8 * 28, 16};
+    for (auto dim = 0; dim < static_cast<int>(npus_count_per_dim.size()); dim++) {
+        const auto traffic = all_to_all_per_dim(npus_count_per_dim, dim);
+        const auto reference = replay_sequentially(input_path, traffic);
+        for (const auto threads_count : {1, 2, 3, 4}) {
+            const auto [simulation, arrival_times] =
+                replay_with<LinkDisjointSimulation>(input_path, traffic, threads_count);
+            /// test: every chunk arrives at the same time as the sequential simulation
+            EXPECT_EQ(arrival_times, reference) << "dim " << dim << " with " << threads_count << " threads";
+
+            /// test: chunks sharing no link are simulated separately
+            EXPECT_EQ(simulation->get_components_count(), expected_components_counts[dim]) << "dim " << dim;
+        }
+    }
+
+    // phases run one after another, each continuing from the end of the previous one
+    auto simulation = LinkDisjointSimulation(NetworkParser(input_path), 4);
+    const auto topology = construct_topology(NetworkParser(input_path));
+    const auto topology_event_queue = topology->get_event_queue();
+    for (auto dim = 0; dim < static_cast<int>(npus_count_per_dim.size()); dim++) {
+        const auto traffic = all_to_all_per_dim(npus_count_per_dim, dim);
+
+        /// test: the phase ends at the same time as the sequential simulation
+        EXPECT_EQ(replay_with(simulation, traffic), replay_sequentially(*topology, traffic)) << "dim " << dim;
+        EXPECT_EQ(simulation.get_current_time(), topology_event_queue->get_current_time()) << "dim " << dim;
+    }
+
+    /// test: every event is invoked once, as in the sequential simulation
+    EXPECT_EQ(simulation.get_processed_events_count(), topology_event_queue->get_processed_events_count());
+
+    // all-to-all on a ring shares the links
+    auto all_to_all = Traffic();
+    for (auto src = 0; src < 16; src++) {
+        for (auto dest = 0; dest < 16; dest++) {
+            if (src != dest) {
+                all_to_all.emplace_back(src, dest, chunk_size, 2);
+            }
+        }
+    }
+    const auto [ring_simulation, arrival_times] =
+        replay_with<LinkDisjointSimulation>("../../input/Ring.yml", all_to_all, 4);
+    EXPECT_EQ(arrival_times, replay_sequentially("../../input/Ring.yml", all_to_all));
+
+    /// test: traffic sharing the links ends up in a single component
+    EXPECT_EQ(ring_simulation->get_components_count(), 1);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkDisjointSimulationSchedulingPolicies) {
+    // disjoint flows between neighbors, so that each worker rewinds its replica between components
+    auto traffic = Traffic();
+    for (auto src = 0; src < 16; src += 2) {
+        traffic.emplace_back(src, src + 1, chunk_size, 2);
+    }
+
+    for (const auto* const scheduling_policy_name : {"BinaryHeap", "CalendarQueue", "TimingWheel"}) {
+        const auto input_path = std::string("link_disjoint_") + scheduling_policy_name + ".yml";
+        auto input = std::ofstream(input_path);
+        input << "topology: [ Ring ]\n"
+              << "npus_count: [ 16 ]\n"
+              << "bandwidth: [ 50.0 ]\n"
+              << "latency: [ 500.0 ]\n"
+              << "scheduling_policy: " << scheduling_policy_name << "\n";
+        input.close();
+
+        const auto reference = replay_sequentially(input_path.c_str(), traffic);
+        for (const auto threads_count : {1, 2}) {
+            const auto [simulation, arrival_times] =
+                replay_with<LinkDisjointSimulation>(input_path.c_str(), traffic, threads_count);
+            /// test: every scheduling policy gives the same result as the sequential simulation
+            EXPECT_EQ(arrival_times, reference) << scheduling_policy_name << " with " << threads_count << " threads";
+            EXPECT_EQ(simulation->get_components_count(), 8);
+        }
+        std::remove(input_path.c_str());
+    }
+}
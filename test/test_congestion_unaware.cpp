@@ -3,10 +3,26 @@ This source code is licensed under the MIT license found in the
 LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
+#include "common/FastDivisor.h"
 #include "common/NetworkParser.h"
 #include "common/Type.h"
+#include "congestion_unaware/FullyConnected.h"
 #include "congestion_unaware/Helper.h"
+#include "congestion_unaware/MultiConfigTopology.h"
+#include "congestion_unaware/MultiDimTopology.h"
+#include "congestion_unaware/Ring.h"
+#include "congestion_unaware/StaticMultiDimTopology.h"
+#include "congestion_unaware/Switch.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
@@ -68,3 +84,247 @@ TEST_F(TestNetworkAnalyticalCongestionUnaware, Ring_FullyConnected_Switch) {
     const auto comm_delay_dim3 = topology->send(26, 42, chunk_size);
     EXPECT_EQ(comm_delay_dim3, 23'531);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, FastDivisor) {
+    auto rng = std::mt19937(7);
+    for (auto divisor = 1; divisor <= 1'024; divisor++) {
+        const auto fast_divisor = FastDivisor(divisor);
+
+        // test: small, random, and the largest dividends
+        for (auto dividend = 0; dividend < 4 * divisor; dividend++) {
+            EXPECT_EQ(fast_divisor.divide(dividend), dividend / divisor);
+        }
+        for (auto i = 0; i < 64; i++) {
+            const auto dividend = static_cast<int>(rng() % (uint32_t{1} << 31));
+            EXPECT_EQ(fast_divisor.divide(dividend), dividend / divisor);
+        }
+        const auto max_dividend = std::numeric_limits<int>::max();
+        EXPECT_EQ(fast_divisor.divide(max_dividend), max_dividend / divisor);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, MultiDimTransferDimension) {
+    // create network of non-power-of-two dimensions, including a single-NPU one
+    const auto make_dims = [] {
+        auto dims = std::vector<std::unique_ptr<BasicTopology>>();
+        dims.push_back(std::make_unique<Ring>(5, 200, 20, true));
+        dims.push_back(std::make_unique<Switch>(1, 100, 50));
+        dims.push_back(std::make_unique<FullyConnected>(6, 100, 30));
+        dims.push_back(std::make_unique<Switch>(3, 50, 500));
+        return dims;
+    };
+    auto topology = MultiDimTopology();
+    for (auto& dim : make_dims()) {
+        topology.append_dimension(std::move(dim));
+    }
+    const auto dims = make_dims();
+    const auto npus_count = topology.get_npus_count();
+    ASSERT_EQ(npus_count, 90);
+
+    // test: every pair communicates within the lowest dimension where their addresses differ
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src == dest) {
+                continue;
+            }
+            auto src_leftover = src;
+            auto dest_leftover = dest;
+            for (const auto& dim : dims) {
+                const auto dim_npus_count = dim->get_npus_count();
+                if (src_leftover % dim_npus_count != dest_leftover % dim_npus_count) {
+                    const auto expected = dim->send(src_leftover % dim_npus_count, dest_leftover % dim_npus_count,
+                                                    chunk_size);
+                    EXPECT_EQ(topology.send(src, dest, chunk_size), expected);
+                    break;
+                }
+                src_leftover /= dim_npus_count;
+                dest_leftover /= dim_npus_count;
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, PrecomputedDelays) {
+    // create network
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    const auto npus_count_per_dim = topology->get_npus_count_per_dim();
+
+    // every dimension tabulated, only the first one, or none of them
+    const auto first_table_bytes = static_cast<size_t>(npus_count_per_dim[0]) * npus_count_per_dim[0];
+    auto all_tables_bytes = size_t{0};
+    for (const auto dim_npus_count : npus_count_per_dim) {
+        all_tables_bytes += static_cast<size_t>(dim_npus_count) * dim_npus_count;
+    }
+    for (const auto max_tables_bytes : {all_tables_bytes, first_table_bytes, size_t{0}}) {
+        const auto precomputed_topology = construct_topology(network_parser);
+        const auto tables_bytes = precomputed_topology->precompute_delays(max_tables_bytes);
+
+        // test: tables are bounded, and delays match the default mode up to rounding
+        EXPECT_EQ(tables_bytes, max_tables_bytes);
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    const auto delay = topology->send(src, dest, chunk_size);
+                    const auto precomputed_delay = precomputed_topology->send(src, dest, chunk_size);
+                    EXPECT_LE(std::max(delay, precomputed_delay) - std::min(delay, precomputed_delay), 1);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, StaticMultiDimTopology) {
+    // create the same network dynamically and statically
+    auto dynamic_topology = MultiDimTopology();
+    dynamic_topology.append_dimension(std::make_unique<Ring>(5, 200, 50, false));
+    dynamic_topology.append_dimension(std::make_unique<FullyConnected>(8, 100, 500));
+    dynamic_topology.append_dimension(std::make_unique<Switch>(3, 50, 2'000));
+    auto static_topology = StaticMultiDimTopology<Ring, FullyConnected, Switch>(
+        Ring(5, 200, 50, false), FullyConnected(8, 100, 500), Switch(3, 50, 2'000));
+    const auto npus_count = dynamic_topology.get_npus_count();
+    EXPECT_EQ(static_topology.get_npus_count(), npus_count);
+    EXPECT_EQ(static_topology.get_dims_count(), 3);
+    EXPECT_EQ(static_topology.get_npus_count_per_dim(), dynamic_topology.get_npus_count_per_dim());
+
+    // test: every pair takes exactly the same delay, in the default and the precomputed mode
+    for (const auto precompute : {false, true}) {
+        if (precompute) {
+            EXPECT_EQ(static_topology.precompute_delays(64), dynamic_topology.precompute_delays(64));
+        }
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    EXPECT_EQ(static_topology.send(src, dest, chunk_size), dynamic_topology.send(src, dest, chunk_size));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, SendBatch) {
+    // create a multi-dimensional and a basic topology
+    auto multi_dim_topology = MultiDimTopology();
+    multi_dim_topology.append_dimension(std::make_unique<Ring>(7, 200, 50, true));
+    multi_dim_topology.append_dimension(std::make_unique<Switch>(3, 50, 2'000));
+    multi_dim_topology.append_dimension(std::make_unique<FullyConnected>(6, 100, 500));
+    auto ring = Ring(13, 100, 20, false);
+
+    // test: every chunk takes the same delay as send, in the default and the precomputed mode
+    // (over more chunks than a single block)
+    auto rng = std::mt19937(7);
+    for (Topology* const topology : std::initializer_list<Topology*>{&multi_dim_topology, &ring}) {
+        const auto npus_count = topology->get_npus_count();
+        constexpr auto count = size_t{1'000};
+        auto srcs = std::vector<DeviceId>(count);
+        auto dests = std::vector<DeviceId>(count);
+        auto chunk_sizes = std::vector<ChunkSize>(count);
+        for (auto i = size_t{0}; i < count; i++) {
+            srcs[i] = static_cast<DeviceId>(rng() % npus_count);
+            dests[i] = static_cast<DeviceId>((srcs[i] + 1 + rng() % (npus_count - 1)) % npus_count);
+            chunk_sizes[i] = 1 + rng() % 4'194'304;
+        }
+
+        for (const auto precompute : {false, true}) {
+            if (precompute) {
+                topology->precompute_delays(1'024);
+            }
+            auto delays = std::vector<EventTime>(count);
+            topology->send_batch(srcs.data(), dests.data(), chunk_sizes.data(), delays.data(), count);
+            for (auto i = size_t{0}; i < count; i++) {
+                EXPECT_EQ(delays[i], topology->send(srcs[i], dests[i], chunk_sizes[i]));
+            }
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, MultiConfigTopology) {
+    // create the network with a few more configurations
+    const auto network_parser = NetworkParser("../../input/Ring_FullyConnected_Switch.yml");
+    auto multi_config_topology = MultiConfigTopology(network_parser);
+    auto bandwidths_per_config = std::vector<std::vector<Bandwidth>>{network_parser.get_bandwidths_per_dim()};
+    auto latencies_per_config = std::vector<std::vector<Latency>>{network_parser.get_latencies_per_dim()};
+    bandwidths_per_config.push_back({400, 200, 100});
+    latencies_per_config.push_back({20, 200, 1'000});
+    bandwidths_per_config.push_back({25, 75, 300});
+    latencies_per_config.push_back({0, 10, 10});
+    for (auto config = 1; config < 3; config++) {
+        const auto config_id =
+            multi_config_topology.add_config(bandwidths_per_config[config], latencies_per_config[config]);
+        EXPECT_EQ(config_id, config);
+    }
+    EXPECT_EQ(multi_config_topology.get_configs_count(), 3);
+
+    // create the topology of each configuration
+    const auto topologies_per_dim = network_parser.get_topologies_per_dim();
+    const auto npus_counts_per_dim = network_parser.get_npus_counts_per_dim();
+    auto topologies = std::vector<MultiDimTopology>(3);
+    for (auto config = 0; config < 3; config++) {
+        for (auto dim = 0; dim < network_parser.get_dims_count(); dim++) {
+            topologies[config].append_dimension(
+                construct_basic_topology(topologies_per_dim[dim], npus_counts_per_dim[dim],
+                                         bandwidths_per_config[config][dim], latencies_per_config[config][dim]));
+        }
+    }
+
+    // test: every pair takes the same delay as the topology of each configuration
+    const auto npus_count = multi_config_topology.get_npus_count();
+    EXPECT_EQ(npus_count, topologies[0].get_npus_count());
+    auto delays = std::vector<EventTime>(3);
+    for (auto src = 0; src < npus_count; src++) {
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (src == dest) {
+                continue;
+            }
+            multi_config_topology.send(src, dest, chunk_size, delays.data());
+            for (auto config = 0; config < 3; config++) {
+                EXPECT_EQ(delays[config], topologies[config].send(src, dest, chunk_size));
+            }
+        }
+    }
+
+    // test: a batch fills a row of configurations per chunk
+    const auto srcs = std::vector<DeviceId>{0, 5, npus_count - 1};
+    const auto dests = std::vector<DeviceId>{1, 0, 0};
+    const auto chunk_sizes = std::vector<ChunkSize>{1, chunk_size, 3 * chunk_size};
+    auto batch_delays = std::vector<EventTime>(srcs.size() * 3);
+    multi_config_topology.send_batch(srcs.data(), dests.data(), chunk_sizes.data(), batch_delays.data(), srcs.size());
+    for (auto i = size_t{0}; i < srcs.size(); i++) {
+        for (auto config = 0; config < 3; config++) {
+            EXPECT_EQ(batch_delays[(i * 3) + config], topologies[config].send(srcs[i], dests[i], chunk_sizes[i]));
+        }
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionUnaware, DelayMatrix) {
+    // create a multi-dimensional and a basic network
+    const auto multi_dim_topology = construct_topology(NetworkParser("../../input/Ring_FullyConnected_Switch.yml"));
+    const auto ring = construct_topology(NetworkParser("../../input/Ring.yml"));
+    const auto chunk_sizes = std::vector<ChunkSize>{1'024, chunk_size};
+    const auto path = std::string("delay_matrix.bin");
+
+    // test: the matrix of each chunk size holds the delay of every pair
+    for (const auto& topology : {multi_dim_topology, ring}) {
+        topology->compute_delay_matrix(chunk_sizes, path, 3);
+
+        const auto npus_count = topology->get_npus_count();
+        auto matrices = std::vector<EventTime>(chunk_sizes.size() * npus_count * npus_count);
+        auto file = std::ifstream(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(matrices.data()),
+                  static_cast<std::streamsize>(matrices.size() * sizeof(EventTime)));
+        EXPECT_TRUE(file.good());
+        file.get();
+        EXPECT_TRUE(file.eof());
+
+        for (auto i = size_t{0}; i < chunk_sizes.size(); i++) {
+            for (auto src = 0; src < npus_count; src++) {
+                for (auto dest = 0; dest < npus_count; dest++) {
+                    const auto delay = matrices[((i * npus_count) + src) * npus_count + dest];
+                    EXPECT_EQ(delay, (src == dest) ? 0 : topology->send(src, dest, chunk_sizes[i]));
+                }
+            }
+        }
+    }
+    std::remove(path.c_str());
+}